@@ -0,0 +1,219 @@
+/**
+ * @file components_bench.cc
+ * @author Derek Huang
+ * @brief C++ micro-benchmarks for parallel connected components
+ * @copyright MIT License
+ *
+ * Compares `pdhkr::parallel_component_sizes` on `pdhkr::thread_pool` objects
+ * of 1, 2, 4, ... up to `pdhkr::thread_count()` threads against a serial BFS
+ * with `pdhkr::graph_search` and a serial `pdhkr::disjoint_sets`, checking
+ * that all of them find the same component sizes. The graphs are an R-MAT
+ * power-law graph and a 2D grid graph generated like `pdhkr_gen_graph` does,
+ * so `PDHKR_THREADS` can be used to extend the scaling to more threads.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/dsu.hh"
+#include "pdhkr/graph.hh"
+#include "pdhkr/parallel_components.hh"
+#include "pdhkr/thread.hh"
+#include "pdhkr/thread_pool.hh"
+
+namespace {
+
+/**
+ * Return the minimum wall time in milliseconds of several calls to a callable.
+ *
+ * @param f Callable with signature `void()`
+ * @param n_repeat Number of calls
+ */
+template <typename F>
+double min_msec(F&& f, unsigned int n_repeat = 5U)
+{
+  using clock = std::chrono::steady_clock;
+  auto best = std::chrono::duration<double, std::milli>::max();
+  for (decltype(n_repeat) i = 0; i < n_repeat; i++) {
+    auto start = clock::now();
+    f();
+    best = std::min<decltype(best)>(best, clock::now() - start);
+  }
+  return best.count();
+}
+
+/**
+ * Print a benchmark result row.
+ *
+ * @param name Benchmark name
+ * @param msec Benchmark time
+ * @param bfs_msec Serial BFS time
+ */
+void print_row(const std::string& name, double msec, double bfs_msec)
+{
+  std::cout << std::left << std::setw(36) << name << std::right <<
+    std::fixed << std::setprecision(2) << std::setw(12) << msec <<
+    std::setw(12) << bfs_msec << std::setw(10) << bfs_msec / msec << "\n";
+}
+
+/**
+ * Convenience type alias for the vector of pairs representing edges.
+ */
+using edge_vector = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+/**
+ * Return the edges of an R-MAT power-law graph without self loops.
+ *
+ * As in `pdhkr_gen_graph`, each bit of the end nodes picks one of the
+ * adjacency matrix quadrants with probabilities 0.57, 0.19, 0.19, 0.05.
+ *
+ * @param rng Random number generator
+ * @param scale Base 2 logarithm of the node count
+ * @param edge_factor Number of edges per node
+ */
+edge_vector make_rmat_edges(
+  std::mt19937_64& rng, unsigned int scale, std::size_t edge_factor)
+{
+  edge_vector edges(edge_factor << scale);
+  for (auto& [a, b] : edges) {
+    do {
+      a = b = 0;
+      for (decltype(scale) bit = 0; bit < scale; bit++) {
+        auto quadrant = rng() % 100U;
+        a = 2 * a + (quadrant >= 76U);
+        b = 2 * b + (quadrant >= 57U && quadrant < 76U) + (quadrant >= 95U);
+      }
+    }
+    while (a == b);
+  }
+  return edges;
+}
+
+/**
+ * Return the edges of a grid graph between adjacent nodes.
+ *
+ * @param rows Number of rows
+ * @param cols Number of columns
+ */
+edge_vector make_grid_edges(std::uint32_t rows, std::uint32_t cols)
+{
+  edge_vector edges;
+  edges.reserve(2U * rows * cols);
+  for (std::uint32_t i = 0; i < rows; i++) {
+    for (std::uint32_t j = 0; j < cols; j++) {
+      auto node = i * cols + j;
+      if (j + 1 < cols)
+        edges.emplace_back(node, node + 1);
+      if (i + 1 < rows)
+        edges.emplace_back(node, node + cols);
+    }
+  }
+  return edges;
+}
+
+/**
+ * Return the sorted component sizes found by serial BFS.
+ *
+ * @param graph Undirected graph
+ */
+std::vector<std::uint32_t> bfs_sizes(const pdhkr::csr_graph<>& graph)
+{
+  auto n_nodes = static_cast<std::uint32_t>(graph.n_nodes());
+  pdhkr::graph_search<> search{n_nodes};
+  std::vector<std::uint32_t> sizes;
+  for (std::uint32_t root = 0; root < n_nodes; root++)
+    if (auto size = search.bfs(graph, root, [](auto) {}))
+      sizes.push_back(static_cast<std::uint32_t>(size));
+  std::sort(sizes.begin(), sizes.end());
+  return sizes;
+}
+
+/**
+ * Return the sorted component sizes found by serial union-find.
+ *
+ * @param n_nodes Number of nodes
+ * @param edges Undirected edges
+ */
+std::vector<std::uint32_t> dsu_sizes(
+  std::uint32_t n_nodes, const edge_vector& edges)
+{
+  pdhkr::disjoint_sets<> sets{n_nodes};
+  for (const auto& [a, b] : edges)
+    sets.unite(a, b);
+  auto sizes = sets.component_sizes();
+  std::sort(sizes.begin(), sizes.end());
+  return sizes;
+}
+
+}  // namespace
+
+int main()
+{
+  std::mt19937_64 rng{2024};
+  std::cout << std::left << std::setw(36) << "benchmark" << std::right <<
+    std::setw(12) << "time (ms)" << std::setw(12) << "bfs (ms)" <<
+    std::setw(10) << "speedup" << "\n";
+  // R-MAT graph with 2^20 nodes and 2^23 edges, 2048 x 2048 grid graph
+  std::pair<std::string, std::uint32_t> graphs[] = {
+    {"rmat 20:8", std::uint32_t{1} << 20},
+    {"grid 2048x2048", 2048U * 2048U}
+  };
+  auto max_threads = pdhkr::thread_count();
+  std::uint64_t checksum = 0;
+  for (const auto& [name, n_nodes] : graphs) {
+    auto edges = (name[0] == 'r') ?
+      make_rmat_edges(rng, 20U, 8U) : make_grid_edges(2048U, 2048U);
+    pdhkr::csr_graph<> graph{n_nodes, edges.begin(), edges.end()};
+    std::vector<std::uint32_t> expected;
+    auto bfs_msec = min_msec([&] { expected = bfs_sizes(graph); });
+    print_row(name + " bfs", bfs_msec, bfs_msec);
+    std::vector<std::uint32_t> sizes;
+    print_row(
+      name + " dsu",
+      min_msec([&] { sizes = dsu_sizes(n_nodes, edges); }),
+      bfs_msec
+    );
+    if (sizes != expected) {
+      std::cerr << "Error: " << name << ": DSU sizes != BFS sizes" << std::endl;
+      return EXIT_FAILURE;
+    }
+    // thread counts double up to the max, which is always included
+    for (unsigned int n_threads = 1; n_threads <= max_threads;) {
+      pdhkr::thread_pool pool{n_threads};
+      print_row(
+        name + " afforest " + std::to_string(n_threads) + " threads",
+        min_msec(
+          [&]
+          {
+            sizes = pdhkr::parallel_component_sizes(graph, pool);
+            std::sort(sizes.begin(), sizes.end());
+          }
+        ),
+        bfs_msec
+      );
+      if (sizes != expected) {
+        std::cerr << "Error: " << name << ": Afforest sizes with " <<
+          n_threads << " threads != BFS sizes" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (n_threads == max_threads)
+        break;
+      n_threads = std::min(2 * n_threads, max_threads);
+    }
+    for (auto size : expected)
+      checksum += std::uint64_t{size} * size;
+  }
+  // print results so they are not optimized out
+  std::cout << "\nchecksum: " << std::hex << checksum << std::endl;
+  return EXIT_SUCCESS;
+}
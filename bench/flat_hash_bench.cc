@@ -0,0 +1,176 @@
+/**
+ * @file flat_hash_bench.cc
+ * @author Derek Huang
+ * @brief C++ micro-benchmarks for the flat hash set and map
+ * @copyright MIT License
+ *
+ * Compares `pdhkr::flat_hash_set` and `pdhkr::flat_hash_map` against
+ * `std::unordered_set` and `std::unordered_map` on the operations the graph
+ * programs perform: inserting, finding, and erasing sparse 32-bit node IDs,
+ * and building and walking an adjacency map of neighbor sets.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/flat_hash.hh"
+
+namespace {
+
+/**
+ * Return the minimum wall time in milliseconds of several calls to a callable.
+ *
+ * @param f Callable with signature `void()`
+ * @param n_repeat Number of calls
+ */
+template <typename F>
+double min_msec(F&& f, unsigned int n_repeat = 5U)
+{
+  using clock = std::chrono::steady_clock;
+  auto best = std::chrono::duration<double, std::milli>::max();
+  for (decltype(n_repeat) i = 0; i < n_repeat; i++) {
+    auto start = clock::now();
+    f();
+    best = std::min<decltype(best)>(best, clock::now() - start);
+  }
+  return best.count();
+}
+
+/**
+ * Print a benchmark result row.
+ *
+ * @param name Benchmark name
+ * @param flat_msec Flat container time
+ * @param std_msec Standard container time
+ */
+void print_row(std::string_view name, double flat_msec, double std_msec)
+{
+  std::cout << std::left << std::setw(24) << name << std::right <<
+    std::fixed << std::setprecision(2) << std::setw(12) << flat_msec <<
+    std::setw(12) << std_msec << std::setw(10) << std_msec / flat_msec <<
+    "\n";
+}
+
+/**
+ * Return the sum of the keys found by inserting, finding, and erasing IDs.
+ *
+ * Half of the lookups are random IDs that almost always miss, and every other
+ * inserted ID is erased before a second lookup pass.
+ *
+ * @tparam Set Set type
+ *
+ * @param ids IDs to insert
+ * @param probes IDs to look up
+ */
+template <typename Set>
+std::uint64_t set_ops(
+  const std::vector<std::uint32_t>& ids,
+  const std::vector<std::uint32_t>& probes)
+{
+  Set set;
+  for (auto id : ids)
+    set.insert(id);
+  std::uint64_t total = 0;
+  for (auto id : probes)
+    if (set.find(id) != set.end())
+      total += id;
+  for (std::size_t i = 0; i < ids.size(); i += 2)
+    set.erase(ids[i]);
+  for (auto id : probes)
+    if (set.find(id) != set.end())
+      total += id;
+  return total;
+}
+
+/**
+ * Return the sum of the neighbor IDs after building an adjacency map.
+ *
+ * This mirrors the `adjacency_list` classes of the graph programs.
+ *
+ * @tparam Map Map from IDs to neighbor sets
+ *
+ * @param edges Undirected edges
+ */
+template <typename Map>
+std::uint64_t adjacency_ops(
+  const std::vector<std::pair<std::uint32_t, std::uint32_t>>& edges)
+{
+  Map map;
+  for (const auto& [a, b] : edges) {
+    map[a].insert(b);
+    map[b].insert(a);
+  }
+  std::uint64_t total = 0;
+  for (const auto& [node, neighbors] : map)
+    for (auto neighbor : neighbors)
+      total += neighbor ^ node;
+  return total;
+}
+
+}  // namespace
+
+int main()
+{
+  // sparse IDs spread over the full 32-bit range
+  constexpr std::size_t n_ids = 1U << 20;
+  std::mt19937 rng{2023};
+  std::vector<std::uint32_t> ids(n_ids);
+  for (auto& id : ids)
+    id = rng();
+  // lookups alternate between inserted IDs and (most likely) missing IDs
+  std::vector<std::uint32_t> probes(n_ids);
+  for (std::size_t i = 0; i < n_ids; i++) {
+    if (i % 2)
+      probes[i] = ids[rng() % n_ids];
+    else
+      probes[i] = static_cast<std::uint32_t>(rng());
+  }
+  // graph with an average degree of 4 over sparse node IDs
+  constexpr std::size_t n_nodes = 1U << 17;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> edges(2 * n_nodes);
+  for (auto& [a, b] : edges) {
+    a = ids[rng() % n_nodes];
+    b = ids[rng() % n_nodes];
+  }
+  std::cout << std::left << std::setw(24) << "benchmark" << std::right <<
+    std::setw(12) << "flat (ms)" << std::setw(12) << "std (ms)" <<
+    std::setw(10) << "speedup" << "\n";
+  std::uint64_t checksum = 0;
+  print_row(
+    "set insert/find/erase",
+    min_msec([&] {
+      checksum += set_ops<pdhkr::flat_hash_set<std::uint32_t>>(ids, probes);
+    }),
+    min_msec([&] {
+      checksum += set_ops<std::unordered_set<std::uint32_t>>(ids, probes);
+    })
+  );
+  print_row(
+    "adjacency build/walk",
+    min_msec([&] {
+      checksum += adjacency_ops<
+        pdhkr::flat_hash_map<std::uint32_t, pdhkr::flat_hash_set<std::uint32_t>>
+      >(edges);
+    }),
+    min_msec([&] {
+      checksum += adjacency_ops<
+        std::unordered_map<std::uint32_t, std::unordered_set<std::uint32_t>>
+      >(edges);
+    })
+  );
+  // print results so they are not optimized out
+  std::cout << "\nchecksum: " << std::hex << checksum << std::endl;
+  return EXIT_SUCCESS;
+}
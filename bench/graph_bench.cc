@@ -0,0 +1,191 @@
+/**
+ * @file graph_bench.cc
+ * @author Derek Huang
+ * @brief C++ micro-benchmarks for the compressed sparse row graph
+ * @copyright MIT License
+ *
+ * Compares `pdhkr::csr_graph` and `pdhkr::graph_search` against the
+ * `adjacency_list` of hash sets and the BFS over a `std::deque` with a hash
+ * set of visited nodes that the graph programs use by default. Both build an
+ * undirected graph from random edges and then find the size of every connected
+ * component. The first configuration is shaped like the queries of
+ * `data/roads_and_libraries/3.in`, with about 90,000 cities and 20,000 roads.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/graph.hh"
+
+namespace {
+
+/**
+ * Return the minimum wall time in milliseconds of several calls to a callable.
+ *
+ * @param f Callable with signature `void()`
+ * @param n_repeat Number of calls
+ */
+template <typename F>
+double min_msec(F&& f, unsigned int n_repeat = 5U)
+{
+  using clock = std::chrono::steady_clock;
+  auto best = std::chrono::duration<double, std::milli>::max();
+  for (decltype(n_repeat) i = 0; i < n_repeat; i++) {
+    auto start = clock::now();
+    f();
+    best = std::min<decltype(best)>(best, clock::now() - start);
+  }
+  return best.count();
+}
+
+/**
+ * Print a benchmark result row.
+ *
+ * @param name Benchmark name
+ * @param csr_msec CSR graph time
+ * @param hash_msec Hash adjacency list time
+ */
+void print_row(const std::string& name, double csr_msec, double hash_msec)
+{
+  std::cout << std::left << std::setw(36) << name << std::right <<
+    std::fixed << std::setprecision(2) << std::setw(12) << csr_msec <<
+    std::setw(12) << hash_msec << std::setw(10) << hash_msec / csr_msec <<
+    "\n";
+}
+
+/**
+ * Convenience type alias for the vector of pairs representing edges.
+ */
+using edge_vector = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+/**
+ * Adjacency list of hash sets, as built by the graph programs.
+ */
+using hash_graph = std::unordered_map<
+  std::uint32_t, std::unordered_set<std::uint32_t>
+>;
+
+/**
+ * Return the adjacency list of hash sets for undirected edges.
+ *
+ * @param edges Undirected edges with 0-based node IDs
+ */
+hash_graph make_hash_graph(const edge_vector& edges)
+{
+  hash_graph graph;
+  for (const auto& [a, b] : edges) {
+    graph[a].insert(b);
+    graph[b].insert(a);
+  }
+  return graph;
+}
+
+/**
+ * Return the sum of the squared component sizes using the hash graph.
+ *
+ * @param n_nodes Number of nodes
+ * @param graph Adjacency list of hash sets
+ */
+std::uint64_t hash_components(std::uint32_t n_nodes, const hash_graph& graph)
+{
+  std::unordered_set<std::uint32_t> visited;
+  std::uint64_t total = 0;
+  for (std::uint32_t root = 0; root < n_nodes; root++) {
+    if (!visited.insert(root).second)
+      continue;
+    std::uint64_t size = 0;
+    std::deque<std::uint32_t> queue{root};
+    while (queue.size()) {
+      auto cur = queue.front();
+      queue.pop_front();
+      size++;
+      auto it = graph.find(cur);
+      if (it == graph.end())
+        continue;
+      for (auto next : it->second)
+        if (visited.insert(next).second)
+          queue.push_back(next);
+    }
+    total += size * size;
+  }
+  return total;
+}
+
+/**
+ * Return the sum of the squared component sizes using the CSR graph.
+ *
+ * @param graph CSR graph
+ */
+std::uint64_t csr_components(const pdhkr::csr_graph<std::uint32_t>& graph)
+{
+  auto n_nodes = static_cast<std::uint32_t>(graph.n_nodes());
+  pdhkr::graph_search<std::uint32_t> search{n_nodes};
+  std::uint64_t total = 0;
+  for (std::uint32_t root = 0; root < n_nodes; root++) {
+    std::uint64_t size = search.bfs(graph, root, [](auto) {});
+    total += size * size;
+  }
+  return total;
+}
+
+}  // namespace
+
+int main()
+{
+  std::mt19937_64 rng{2024};
+  std::cout << std::left << std::setw(36) << "benchmark" << std::right <<
+    std::setw(12) << "csr (ms)" << std::setw(12) << "hash (ms)" <<
+    std::setw(10) << "speedup" << "\n";
+  // node count, edge count. the first is like a roads_and_libraries query
+  std::pair<std::uint32_t, std::size_t> configs[] = {
+    {90000, 20000},
+    {100000, 100000},
+    {500000, 1000000}
+  };
+  std::uint64_t checksum = 0;
+  for (const auto& [n_nodes, n_edges] : configs) {
+    edge_vector edges(n_edges);
+    for (auto& [a, b] : edges) {
+      a = static_cast<std::uint32_t>(rng() % n_nodes);
+      b = static_cast<std::uint32_t>(rng() % n_nodes);
+    }
+    auto name = std::to_string(n_nodes) + " nodes, " +
+      std::to_string(n_edges) + " edges";
+    pdhkr::csr_graph<std::uint32_t> csr;
+    hash_graph hash;
+    print_row(
+      name + " build",
+      min_msec([&] { csr = {n_nodes, edges.begin(), edges.end()}; }),
+      min_msec([&] { hash = make_hash_graph(edges); })
+    );
+    std::uint64_t csr_total = 0;
+    std::uint64_t hash_total = 0;
+    print_row(
+      name + " bfs",
+      min_msec([&] { csr_total = csr_components(csr); }),
+      min_msec([&] { hash_total = hash_components(n_nodes, hash); })
+    );
+    if (csr_total != hash_total) {
+      std::cerr << "Error: " << name << ": CSR components " << csr_total <<
+        " != hash components " << hash_total << std::endl;
+      return EXIT_FAILURE;
+    }
+    checksum += csr_total;
+  }
+  // print results so they are not optimized out
+  std::cout << "\nchecksum: " << std::hex << checksum << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file rectangle_bench.cc
+ * @author Derek Huang
+ * @brief C++ micro-benchmarks for the 2D rectangle addition solvers
+ * @copyright MIT License
+ *
+ * Compares `pdhkr::algo::rectangle_manipulation_dense`, which takes tiled 2D
+ * prefix sums of a difference array, against
+ * `pdhkr::algo::rectangle_manipulation_sparse`, which sweeps the rows with a
+ * segment tree over the columns, on random rectangle additions to grids of
+ * various densities. The inputs are generated like those of
+ * `pdhkr_gen_array_manipulation -r`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/algo/rectangle_manipulation.hh"
+
+namespace {
+
+/**
+ * Return the minimum wall time in milliseconds of several calls to a callable.
+ *
+ * @param f Callable with signature `void()`
+ * @param n_repeat Number of calls
+ */
+template <typename F>
+double min_msec(F&& f, unsigned int n_repeat = 3U)
+{
+  using clock = std::chrono::steady_clock;
+  auto best = std::chrono::duration<double, std::milli>::max();
+  for (decltype(n_repeat) i = 0; i < n_repeat; i++) {
+    auto start = clock::now();
+    f();
+    best = std::min<decltype(best)>(best, clock::now() - start);
+  }
+  return best.count();
+}
+
+/**
+ * Print a benchmark result row.
+ *
+ * @param name Benchmark name
+ * @param dense_msec Dense solver time
+ * @param sparse_msec Sparse solver time
+ */
+void print_row(const std::string& name, double dense_msec, double sparse_msec)
+{
+  std::cout << std::left << std::setw(28) << name << std::right <<
+    std::fixed << std::setprecision(2) << std::setw(12) << dense_msec <<
+    std::setw(12) << sparse_msec << std::setw(10) << sparse_msec / dense_msec <<
+    "\n";
+}
+
+/**
+ * Rectangle addition as `(r1, r2, c1, c2, k)` with 1-based inclusive limits.
+ */
+using rectangle = std::tuple<
+  std::size_t, std::size_t, std::size_t, std::size_t, unsigned long long
+>;
+
+/**
+ * Return random rectangle additions to a grid.
+ *
+ * @param rng Random number generator
+ * @param rows Number of grid rows
+ * @param cols Number of grid columns
+ * @param n_ops Number of additions
+ */
+std::vector<rectangle> make_rects(
+  std::mt19937_64& rng, std::size_t rows, std::size_t cols, std::size_t n_ops)
+{
+  auto range = [&rng](std::size_t n)
+  {
+    auto first = static_cast<std::size_t>(rng() % n) + 1;
+    auto last = static_cast<std::size_t>(rng() % n) + 1;
+    if (last < first)
+      std::swap(first, last);
+    return std::make_pair(first, last);
+  };
+  std::vector<rectangle> rects;
+  rects.reserve(n_ops);
+  for (std::size_t i = 0; i < n_ops; i++) {
+    auto [r1, r2] = range(rows);
+    auto [c1, c2] = range(cols);
+    rects.emplace_back(r1, r2, c1, c2, rng() % 1000000001U);
+  }
+  return rects;
+}
+
+}  // namespace
+
+int main()
+{
+  std::mt19937_64 rng{2024};
+  std::cout << std::left << std::setw(28) << "benchmark" << std::right <<
+    std::setw(12) << "dense (ms)" << std::setw(12) << "sparse (ms)" <<
+    std::setw(10) << "speedup" << "\n";
+  // grid rows, grid columns, number of additions. the dense solver wins on the
+  // first while the sparse solver wins once the grid has many cells per
+  // addition, which is where rectangle_manipulation switches to it
+  std::tuple<std::size_t, std::size_t, std::size_t> configs[] = {
+    {2000, 2000, 200000},
+    {2000, 2000, 20000},
+    {500, 8000, 20000},
+    {4000, 4000, 2000}
+  };
+  std::uint64_t checksum = 0;
+  for (const auto& [rows, cols, n_ops] : configs) {
+    auto rects = make_rects(rng, rows, cols, n_ops);
+    auto name = std::to_string(rows) + "x" + std::to_string(cols) + ", " +
+      std::to_string(n_ops) + " adds";
+    unsigned long long dense_max = 0;
+    unsigned long long sparse_max = 0;
+    print_row(
+      name,
+      min_msec([&] {
+        dense_max = pdhkr::algo::rectangle_manipulation_dense(
+          rows, cols, rects.begin(), rects.end()
+        );
+      }),
+      min_msec([&] {
+        sparse_max = pdhkr::algo::rectangle_manipulation_sparse(
+          rows, cols, rects.begin(), rects.end()
+        );
+      })
+    );
+    if (dense_max != sparse_max) {
+      std::cerr << "Error: " << name << ": dense max " << dense_max <<
+        " != sparse max " << sparse_max << std::endl;
+      return EXIT_FAILURE;
+    }
+    checksum += dense_max;
+  }
+  // print results so they are not optimized out
+  std::cout << "\nchecksum: " << std::hex << checksum << std::endl;
+  return EXIT_SUCCESS;
+}
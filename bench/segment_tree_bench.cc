@@ -0,0 +1,193 @@
+/**
+ * @file segment_tree_bench.cc
+ * @author Derek Huang
+ * @brief C++ micro-benchmarks for the range add, range max segment tree
+ * @copyright MIT License
+ *
+ * Compares `pdhkr::algo::range_add_max_tree` against a difference array swept
+ * for each max query, as `array_manipulation` does offline, on random range
+ * additions interleaved with range max queries at various rates. The sweep
+ * wins when there is only one query at the end but each query costs it O(n),
+ * while the tree takes O(log(n)) for every operation.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/algo/segment_tree.hh"
+
+namespace {
+
+/**
+ * Return the minimum wall time in milliseconds of several calls to a callable.
+ *
+ * @param f Callable with signature `void()`
+ * @param n_repeat Number of calls
+ */
+template <typename F>
+double min_msec(F&& f, unsigned int n_repeat = 3U)
+{
+  using clock = std::chrono::steady_clock;
+  auto best = std::chrono::duration<double, std::milli>::max();
+  for (decltype(n_repeat) i = 0; i < n_repeat; i++) {
+    auto start = clock::now();
+    f();
+    best = std::min<decltype(best)>(best, clock::now() - start);
+  }
+  return best.count();
+}
+
+/**
+ * Print a benchmark result row.
+ *
+ * @param name Benchmark name
+ * @param tree_msec Segment tree time
+ * @param sweep_msec Difference array sweep time
+ */
+void print_row(const std::string& name, double tree_msec, double sweep_msec)
+{
+  std::cout << std::left << std::setw(24) << name << std::right <<
+    std::fixed << std::setprecision(2) << std::setw(12) << tree_msec <<
+    std::setw(12) << sweep_msec << std::setw(10) << sweep_msec / tree_msec <<
+    "\n";
+}
+
+/**
+ * Range addition, or range max query if the value is zero.
+ */
+struct operation {
+  std::size_t first;
+  std::size_t last;
+  long long value;
+};
+
+/**
+ * Difference array whose range max queries sweep the prefix sums.
+ */
+class difference_sweep {
+public:
+  /**
+   * Ctor.
+   *
+   * @param size Number of values, all initially zero
+   */
+  explicit difference_sweep(std::size_t size) : deltas_(size + 1) {}
+
+  /**
+   * Add a value to all the values in `[first, last)`.
+   */
+  void add(std::size_t first, std::size_t last, long long value)
+  {
+    deltas_[first] += value;
+    deltas_[last] -= value;
+  }
+
+  /**
+   * Return the max of the values in the non-empty range `[first, last)`.
+   */
+  long long max(std::size_t first, std::size_t last) const
+  {
+    long long value = 0;
+    for (std::size_t i = 0; i < first; i++)
+      value += deltas_[i];
+    auto result = std::numeric_limits<long long>::lowest();
+    for (auto i = first; i < last; i++) {
+      value += deltas_[i];
+      result = std::max(result, value);
+    }
+    return result;
+  }
+
+private:
+  std::vector<long long> deltas_;
+};
+
+/**
+ * Return the sum of the query answers after applying the operations.
+ *
+ * @tparam Values Type with the `add` and `max` members of the segment tree
+ *
+ * @param size Number of values
+ * @param ops Operations to apply in order
+ */
+template <typename Values>
+std::uint64_t run_ops(std::size_t size, const std::vector<operation>& ops)
+{
+  Values values{size};
+  std::uint64_t total = 0;
+  for (const auto& op : ops) {
+    if (op.value)
+      values.add(op.first, op.last, op.value);
+    else
+      total += static_cast<std::uint64_t>(values.max(op.first, op.last));
+  }
+  return total;
+}
+
+}  // namespace
+
+int main()
+{
+  constexpr std::size_t size = 1U << 20;
+  constexpr std::size_t n_adds = 1U << 18;
+  std::mt19937_64 rng{2024};
+  // random additions with a max query over a random range every period adds.
+  // the first period has one query over the whole array at the end
+  auto make_ops = [&rng](std::size_t period)
+  {
+    auto random_range = [&rng]
+    {
+      auto first = static_cast<std::size_t>(rng() % size);
+      auto last = static_cast<std::size_t>(rng() % size);
+      if (last < first)
+        std::swap(first, last);
+      return std::make_pair(first, last + 1);
+    };
+    std::vector<operation> ops;
+    for (std::size_t i = 1; i <= n_adds; i++) {
+      auto [first, last] = random_range();
+      auto value = static_cast<long long>(rng() % 1000000000U) + 1;
+      ops.push_back({first, last, value});
+      if (period < n_adds && !(i % period)) {
+        auto [q_first, q_last] = random_range();
+        ops.push_back({q_first, q_last, 0});
+      }
+    }
+    if (period == n_adds)
+      ops.push_back({0, size, 0});
+    return ops;
+  };
+  std::cout << std::left << std::setw(24) << "benchmark" << std::right <<
+    std::setw(12) << "tree (ms)" << std::setw(12) << "sweep (ms)" <<
+    std::setw(10) << "speedup" << "\n";
+  std::uint64_t checksum = 0;
+  for (std::size_t period : {n_adds, std::size_t{16384}, std::size_t{1024}}) {
+    auto ops = make_ops(period);
+    auto name = (period == n_adds) ?
+      std::string{"adds then global max"} :
+      "max every " + std::to_string(period) + " adds";
+    print_row(
+      name,
+      min_msec([&] {
+        checksum += run_ops<pdhkr::algo::range_add_max_tree<long long>>(
+          size, ops
+        );
+      }),
+      min_msec([&] { checksum += run_ops<difference_sweep>(size, ops); })
+    );
+  }
+  // print results so they are not optimized out
+  std::cout << "\nchecksum: " << std::hex << checksum << std::endl;
+  return EXIT_SUCCESS;
+}
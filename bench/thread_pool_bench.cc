@@ -0,0 +1,183 @@
+/**
+ * @file thread_pool_bench.cc
+ * @author Derek Huang
+ * @brief C++ micro-benchmarks for the work-stealing thread pool
+ * @copyright MIT License
+ *
+ * Compares `pdhkr::thread_pool` against a plain `std::thread` fan-out that
+ * statically splits the work into one contiguous block per thread. The thread
+ * count is `pdhkr::thread_count()`, so `PDHKR_THREADS` can be used to vary it.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <numeric>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "pdhkr/thread.hh"
+#include "pdhkr/thread_pool.hh"
+
+namespace {
+
+/**
+ * Return the minimum wall time in milliseconds of several calls to a callable.
+ *
+ * @param f Callable with signature `void()`
+ * @param n_repeat Number of calls
+ */
+template <typename F>
+double min_msec(F&& f, unsigned int n_repeat = 5U)
+{
+  using clock = std::chrono::steady_clock;
+  auto best = std::chrono::duration<double, std::milli>::max();
+  for (decltype(n_repeat) i = 0; i < n_repeat; i++) {
+    auto start = clock::now();
+    f();
+    best = std::min<decltype(best)>(best, clock::now() - start);
+  }
+  return best.count();
+}
+
+/**
+ * Invoke a callable over a range split statically across fresh threads.
+ *
+ * @param n_threads Number of threads, including the calling thread
+ * @param first First index
+ * @param last One past the last index
+ * @param f Callable with signature `void(std::size_t, std::size_t)`
+ */
+template <typename F>
+void thread_fan_out(
+  unsigned int n_threads, std::size_t first, std::size_t last, F&& f)
+{
+  auto block = (last - first + n_threads - 1) / n_threads;
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads - 1);
+  for (decltype(n_threads) i = 1; i < n_threads; i++) {
+    auto begin = std::min(last, first + i * block);
+    auto end = std::min(last, begin + block);
+    threads.emplace_back([&f, begin, end] { f(begin, end); });
+  }
+  f(first, std::min(last, first + block));
+  for (auto& thread : threads)
+    thread.join();
+}
+
+/**
+ * Unbalanced per-index work, with cost growing linearly with the index.
+ *
+ * @param i Index
+ */
+inline std::uint64_t skewed_work(std::size_t i)
+{
+  std::uint64_t x = i;
+  for (std::size_t j = 0; j < i / 64; j++)
+    x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+  return x;
+}
+
+/**
+ * Naive recursive Fibonacci with the two calls forked above a cutoff.
+ *
+ * @param pool Thread pool
+ * @param n Fibonacci index
+ * @param cutoff Index below which recursion is serial
+ */
+std::uint64_t fib(pdhkr::thread_pool& pool, unsigned int n, unsigned int cutoff)
+{
+  if (n < 2)
+    return n;
+  if (n < cutoff)
+    return fib(pool, n - 1, cutoff) + fib(pool, n - 2, cutoff);
+  std::uint64_t a, b;
+  pool.fork_join(
+    [&] { a = fib(pool, n - 1, cutoff); },
+    [&] { b = fib(pool, n - 2, cutoff); }
+  );
+  return a + b;
+}
+
+/**
+ * Print a benchmark result row.
+ *
+ * @param name Benchmark name
+ * @param pool_msec Thread pool time
+ * @param thread_msec `std::thread` fan-out time, negative if not applicable
+ */
+void print_row(std::string_view name, double pool_msec, double thread_msec)
+{
+  std::cout << std::left << std::setw(24) << name << std::right <<
+    std::fixed << std::setprecision(2) << std::setw(12) << pool_msec;
+  if (thread_msec < 0)
+    std::cout << std::setw(12) << "-";
+  else
+    std::cout << std::setw(12) << thread_msec;
+  std::cout << "\n";
+}
+
+}  // namespace
+
+int main()
+{
+  auto& pool = pdhkr::thread_pool::default_pool();
+  auto n_threads = pool.size();
+  std::cout << "threads: " << n_threads << "\n\n" << std::left <<
+    std::setw(24) << "benchmark" << std::right << std::setw(12) <<
+    "pool (ms)" << std::setw(12) << "thread (ms)" << "\n";
+  // memory-bound uniform work: sum of a large array
+  std::vector<std::uint32_t> values(1U << 25);
+  std::iota(values.begin(), values.end(), 0U);
+  std::atomic<std::uint64_t> total{};
+  auto sum_range = [&](std::size_t first, std::size_t last)
+  {
+    total += std::accumulate(
+      values.begin() + first, values.begin() + last, std::uint64_t{}
+    );
+  };
+  print_row(
+    "uniform sum",
+    min_msec([&] { pool.parallel_for(0, values.size(), sum_range); }),
+    min_msec([&] { thread_fan_out(n_threads, 0, values.size(), sum_range); })
+  );
+  // compute-bound skewed work. static blocks leave most threads idle
+  constexpr std::size_t n_skewed = 1U << 16;
+  std::vector<std::uint64_t> skewed(n_skewed);
+  auto skewed_range = [&](std::size_t first, std::size_t last)
+  {
+    for (auto i = first; i < last; i++)
+      skewed[i] = skewed_work(i);
+  };
+  print_row(
+    "skewed loop",
+    min_msec([&] { pool.parallel_for(0, n_skewed, skewed_range); }),
+    min_msec([&] { thread_fan_out(n_threads, 0, n_skewed, skewed_range); })
+  );
+  // fine-grained parallel_for, one index per task, measures task overhead
+  print_row(
+    "grain 1 (2^16 tasks)",
+    min_msec([&] { pool.parallel_for(0, n_skewed, skewed_range, 1); }),
+    -1
+  );
+  // nested fork/join overhead
+  std::uint64_t fib_value;
+  print_row(
+    "fork/join fib(30)",
+    min_msec([&] { fib_value = fib(pool, 30, 16); }),
+    -1
+  );
+  // print results so they are not optimized out
+  std::cout << "\nchecksum: " << std::hex <<
+    (total.load() ^
+     std::accumulate(skewed.begin(), skewed.end(), std::uint64_t{}) ^
+     fib_value) << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+cmake_minimum_required(VERSION 3.16)
+
+##
+# Generate a header embedding a test case's input and output files.
+#
+# This is run in script mode at build time by the pdhkr_add_tests embedding
+# rule. The header defines pdhkr::test_data::input and output as
+# pdhkr::embedded_file objects backed by constexpr character arrays, which the
+# PDHKR_TEST_INPUT and PDHKR_TEST_OUTPUT macros then name.
+#
+# Arguments:
+#   -DPDHKR_INPUT=path
+#       Test case .in file
+#
+#   -DPDHKR_OUTPUT=path
+#       Test case .out file
+#
+#   -DPDHKR_HEADER=path
+#       Header to generate
+#
+#   -DPDHKR_EMBED_MODE=mode
+#       How the bytes are written, one of:
+#
+#       embed   #embed directives, so the compiler reads the files itself
+#       string  String literals of \x escapes, which compile much faster than
+#               an initializer list but hit the MSVC string literal limits
+#       array   Initializer lists of hex values
+#
+
+foreach(ARG PDHKR_INPUT PDHKR_OUTPUT PDHKR_HEADER PDHKR_EMBED_MODE)
+    if(NOT DEFINED ${ARG})
+        message(FATAL_ERROR "pdhkr_embed_data.cmake: missing ${ARG}")
+    endif()
+endforeach()
+
+# hex digit regex of a line's worth of bytes, 32 bytes per line
+string(REPEAT "[0-9a-f][0-9a-f]" 32 PDHKR_LINE_REGEX)
+
+##
+# Set a variable to the definition of an embedded file.
+#
+# Arguments:
+#   var     Variable to set
+#   name    Name of the pdhkr::embedded_file object
+#   path    File to embed
+#
+function(pdhkr_embed_file VAR NAME PATH)
+    # constexpr array definition. the array always has one extra trailing byte
+    # so that empty files still have a legal array
+    if(PDHKR_EMBED_MODE STREQUAL "embed")
+        set(
+            BYTES
+            "constexpr unsigned char ${NAME}_bytes[] = {\n#embed \"${PATH}\" \
+suffix(,)\n0\n};"
+        )
+    else()
+        file(READ ${PATH} HEX HEX)
+        if(PDHKR_EMBED_MODE STREQUAL "string")
+            # one string literal per line of bytes
+            string(REGEX REPLACE "(${PDHKR_LINE_REGEX})" "\\1\n" HEX "${HEX}")
+            string(REGEX REPLACE "([0-9a-f][0-9a-f])" "\\\\x\\1" HEX "${HEX}")
+            string(REGEX REPLACE "\n$" "" HEX "${HEX}")
+            string(REPLACE "\n" "\"\n\"" HEX "${HEX}")
+            set(BYTES "constexpr char ${NAME}_bytes[] =\n\"${HEX}\";")
+        else()
+            string(REGEX REPLACE "(${PDHKR_LINE_REGEX})" "\\1\n" HEX "${HEX}")
+            string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," HEX "${HEX}")
+            set(
+                BYTES
+                "constexpr unsigned char ${NAME}_bytes[] = {\n${HEX}0\n};"
+            )
+        endif()
+    endif()
+    set(
+        ${VAR}
+        "${BYTES}
+inline const embedded_file ${NAME}{
+  \"${PATH}\",
+  reinterpret_cast<const char*>(${NAME}_bytes),
+  sizeof ${NAME}_bytes - 1
+};"
+        PARENT_SCOPE
+    )
+endfunction()
+
+pdhkr_embed_file(PDHKR_INPUT_DEF input ${PDHKR_INPUT})
+pdhkr_embed_file(PDHKR_OUTPUT_DEF output ${PDHKR_OUTPUT})
+file(
+    WRITE ${PDHKR_HEADER}
+    "/**
+ * Test case files embedded by pdhkr_embed_data.cmake. Do not edit.
+ *
+ * Input: ${PDHKR_INPUT}
+ * Output: ${PDHKR_OUTPUT}
+ */
+
+#pragma once
+
+#include \"pdhkr/testing.hh\"
+
+namespace pdhkr::test_data {
+
+${PDHKR_INPUT_DEF}
+
+${PDHKR_OUTPUT_DEF}
+
+}  // namespace pdhkr::test_data
+"
+)
@@ -0,0 +1,39 @@
+cmake_minimum_required(VERSION 3.16)
+
+##
+# Check that a test program fails with the expected error message.
+#
+# This is run in script mode by the tests added by pdhkr_add_tests with ERROR.
+# The program may exit with failure or be aborted, e.g. by an uncaught
+# exception, but its output must match the given regular expression.
+#
+# Arguments:
+#   -DPDHKR_PROGRAM=path
+#       Test program, run with no arguments
+#
+#   -DPDHKR_ERROR=regex
+#       Regular expression the program's standard output or error must match
+#
+
+foreach(ARG PDHKR_PROGRAM PDHKR_ERROR)
+    if(NOT DEFINED ${ARG})
+        message(FATAL_ERROR "pdhkr_expect_error.cmake: missing ${ARG}")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${PDHKR_PROGRAM}
+    RESULT_VARIABLE RESULT
+    OUTPUT_VARIABLE OUTPUT
+    ERROR_VARIABLE OUTPUT
+)
+if(RESULT EQUAL 0)
+    message(FATAL_ERROR "${PDHKR_PROGRAM} succeeded but should have failed")
+endif()
+if(NOT OUTPUT MATCHES "${PDHKR_ERROR}")
+    message(
+        FATAL_ERROR
+        "${PDHKR_PROGRAM} output does not match ${PDHKR_ERROR}:\n${OUTPUT}"
+    )
+endif()
+message(STATUS "${PDHKR_PROGRAM}: ${RESULT}")
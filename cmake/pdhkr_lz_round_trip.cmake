@@ -0,0 +1,51 @@
+cmake_minimum_required(VERSION 3.16)
+
+##
+# Check that a file is unchanged after compression and decompression.
+#
+# This is run in script mode by the pdhkr_lz_round_trip_* tests.
+#
+# Arguments:
+#   -DPDHKR_LZ=path
+#       pdhkr_lz program
+#
+#   -DPDHKR_INPUT=path
+#       File to compress
+#
+#   -DPDHKR_WORK_DIR=path
+#       Directory for the compressed and decompressed files
+#
+
+foreach(ARG PDHKR_LZ PDHKR_INPUT PDHKR_WORK_DIR)
+    if(NOT DEFINED ${ARG})
+        message(FATAL_ERROR "pdhkr_lz_round_trip.cmake: missing ${ARG}")
+    endif()
+endforeach()
+
+file(MAKE_DIRECTORY ${PDHKR_WORK_DIR})
+set(COMPRESSED ${PDHKR_WORK_DIR}/compressed.lz)
+set(DECOMPRESSED ${PDHKR_WORK_DIR}/decompressed)
+execute_process(
+    COMMAND ${PDHKR_LZ} ${PDHKR_INPUT} ${COMPRESSED}
+    RESULT_VARIABLE RESULT
+)
+if(RESULT)
+    message(FATAL_ERROR "Compressing ${PDHKR_INPUT} failed")
+endif()
+execute_process(
+    COMMAND ${PDHKR_LZ} -d ${COMPRESSED} ${DECOMPRESSED}
+    RESULT_VARIABLE RESULT
+)
+if(RESULT)
+    message(FATAL_ERROR "Decompressing ${COMPRESSED} failed")
+endif()
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${PDHKR_INPUT} ${DECOMPRESSED}
+    RESULT_VARIABLE RESULT
+)
+if(RESULT)
+    message(FATAL_ERROR "${DECOMPRESSED} differs from ${PDHKR_INPUT}")
+endif()
+file(SIZE ${PDHKR_INPUT} INPUT_SIZE)
+file(SIZE ${COMPRESSED} COMPRESSED_SIZE)
+message(STATUS "${PDHKR_INPUT}: ${INPUT_SIZE} -> ${COMPRESSED_SIZE} bytes")
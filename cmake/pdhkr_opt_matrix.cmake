@@ -0,0 +1,321 @@
+cmake_minimum_required(VERSION 3.16)
+
+##
+# Script for the pdhkr_opt_matrix target, run with cmake -P.
+#
+# Builds the project once for each configuration in the cartesian product of
+# the given optimization options, runs the test suite serially for each build,
+# and writes a table comparing the per-solver run times across configurations.
+# A test's time is the minimum over PDHKR_REPEAT runs and a solver's time is
+# the sum of the times of its tests. Failed tests are not counted.
+#
+# Output files written to PDHKR_MATRIX_DIR:
+#
+# results.txt
+#   Configuration legend and per-solver comparison table, also printed
+#
+# results.csv
+#   Per-test times in seconds, one column per configuration
+#
+# Required variables:
+#   PDHKR_SOURCE_DIR        Project source directory
+#   PDHKR_MATRIX_DIR        Directory to create the per-configuration builds in
+#   PDHKR_GENERATOR         CMake generator to use
+#   PDHKR_CTEST_COMMAND     Path to ctest
+#   PDHKR_OPT_LEVELS        List of optimization levels, e.g. 2;3
+#   PDHKR_NATIVE            List of -march=native settings, e.g. OFF;ON
+#   PDHKR_LTO               List of link-time optimization settings
+#   PDHKR_NO_EXCEPTIONS     List of -fno-exceptions settings
+#   PDHKR_STANDARDS         List of C++ standards, e.g. 17;20
+#   PDHKR_ARENA             List of arena allocation settings, e.g. OFF;ON
+#   PDHKR_REPEAT            Number of test suite runs per configuration
+#
+
+foreach(
+    VAR
+    PDHKR_SOURCE_DIR PDHKR_MATRIX_DIR PDHKR_GENERATOR PDHKR_CTEST_COMMAND
+    PDHKR_OPT_LEVELS PDHKR_NATIVE PDHKR_LTO PDHKR_NO_EXCEPTIONS
+    PDHKR_STANDARDS PDHKR_ARENA PDHKR_REPEAT
+)
+    if(NOT DEFINED ${VAR})
+        message(FATAL_ERROR "${VAR} not defined")
+    endif()
+endforeach()
+
+# number of parallel build jobs
+cmake_host_system_information(
+    RESULT PDHKR_N_JOBS QUERY NUMBER_OF_LOGICAL_CORES
+)
+
+# configuration IDs + descriptions, list of all solvers and all tests seen
+set(CONFIGS)
+set(SOLVERS)
+set(TESTS)
+
+##
+# Run the test suite for a configuration and record the per-test times.
+#
+# Sets TIME_<config>_<test> in the parent scope for each passing test, taking
+# the minimum over all repetitions, and updates the SOLVERS and TESTS lists.
+# Tests are run one solver at a time by selecting on the solver name labels
+# added by pdhkr_add_tests, setting SOLVER_<test> in the parent scope to the
+# test's solver. Unlabeled tests, e.g. the library tests, are not run.
+#
+# Arguments:
+#   config      Configuration ID
+#   build_dir   Build directory for the configuration
+#
+function(pdhkr_run_tests config build_dir)
+    # solver names, listed indented after the "All Labels:" line
+    execute_process(
+        COMMAND ${PDHKR_CTEST_COMMAND} --test-dir ${build_dir} --print-labels
+        OUTPUT_VARIABLE LABELS_OUTPUT
+        ERROR_QUIET
+    )
+    string(REPLACE "\n" ";" LABEL_LINES "${LABELS_OUTPUT}")
+    set(CONFIG_SOLVERS)
+    foreach(LINE IN LISTS LABEL_LINES)
+        if(LINE MATCHES "^  +([^ ]+)$")
+            list(APPEND CONFIG_SOLVERS ${CMAKE_MATCH_1})
+        endif()
+    endforeach()
+    foreach(RUN RANGE 1 ${PDHKR_REPEAT})
+    foreach(SOLVER IN LISTS CONFIG_SOLVERS)
+        # serial run so the timings do not interfere with each other. the
+        # label is matched as a regular expression so it must be anchored
+        execute_process(
+            COMMAND ${PDHKR_CTEST_COMMAND}
+                --test-dir ${build_dir} -j1 -L "^${SOLVER}$"
+            OUTPUT_QUIET
+            ERROR_QUIET
+        )
+        # test name, time, and pass/fail lines from the test log
+        file(
+            STRINGS ${build_dir}/Testing/Temporary/LastTest.log LOG_LINES
+            REGEX "^[0-9]+/[0-9]+ Test: |^Test time = |^Test (Passed|Failed)"
+        )
+        foreach(LINE IN LISTS LOG_LINES)
+            if(LINE MATCHES "^[0-9]+/[0-9]+ Test: (.+)$")
+                set(CUR_TEST ${CMAKE_MATCH_1})
+            elseif(LINE MATCHES "^Test time = +([0-9.]+) sec")
+                set(CUR_TIME ${CMAKE_MATCH_1})
+            elseif(LINE MATCHES "^Test Passed")
+                # minimum over the repetitions
+                set(VAR TIME_${config}_${CUR_TEST})
+                if(NOT DEFINED ${VAR} OR CUR_TIME LESS ${VAR})
+                    set(${VAR} ${CUR_TIME})
+                endif()
+                set(SOLVER_${CUR_TEST} ${SOLVER})
+                if(NOT SOLVER IN_LIST SOLVERS)
+                    list(APPEND SOLVERS ${SOLVER})
+                endif()
+                if(NOT CUR_TEST IN_LIST TESTS)
+                    list(APPEND TESTS ${CUR_TEST})
+                endif()
+            endif()
+        endforeach()
+    endforeach()
+    endforeach()
+    # propagate to caller
+    foreach(TEST IN LISTS TESTS)
+        if(DEFINED TIME_${config}_${TEST})
+            set(TIME_${config}_${TEST} ${TIME_${config}_${TEST}} PARENT_SCOPE)
+        endif()
+        if(DEFINED SOLVER_${TEST})
+            set(SOLVER_${TEST} ${SOLVER_${TEST}} PARENT_SCOPE)
+        endif()
+    endforeach()
+    set(SOLVERS ${SOLVERS} PARENT_SCOPE)
+    set(TESTS ${TESTS} PARENT_SCOPE)
+endfunction()
+
+##
+# Convert a time in seconds to integral milliseconds.
+#
+# Times reported by CTest have two decimal places so no floating point math
+# is needed, which CMake does not support anyways.
+#
+# Arguments:
+#   out     Output variable
+#   secs    Time in seconds
+#
+function(pdhkr_to_msec out secs)
+    if(secs MATCHES "^([0-9]+)\\.([0-9])([0-9])?")
+        set(FRAC_2 ${CMAKE_MATCH_3})
+        if(NOT FRAC_2)
+            set(FRAC_2 0)
+        endif()
+        math(
+            EXPR MSEC
+            "${CMAKE_MATCH_1} * 1000 + ${CMAKE_MATCH_2} * 100 + ${FRAC_2} * 10"
+        )
+    else()
+        math(EXPR MSEC "${secs} * 1000")
+    endif()
+    set(${out} ${MSEC} PARENT_SCOPE)
+endfunction()
+
+# build + run each configuration
+set(CONFIG_ID 0)
+foreach(OPT_LEVEL IN LISTS PDHKR_OPT_LEVELS)
+foreach(NATIVE IN LISTS PDHKR_NATIVE)
+foreach(LTO IN LISTS PDHKR_LTO)
+foreach(NO_EXCEPTIONS IN LISTS PDHKR_NO_EXCEPTIONS)
+foreach(STANDARD IN LISTS PDHKR_STANDARDS)
+foreach(ARENA IN LISTS PDHKR_ARENA)
+    math(EXPR CONFIG_ID "${CONFIG_ID} + 1")
+    # human-readable description
+    set(DESC "-O${OPT_LEVEL} -std=c++${STANDARD}")
+    if(NATIVE)
+        string(APPEND DESC " -march=native")
+    endif()
+    if(LTO)
+        string(APPEND DESC " -flto")
+    endif()
+    if(NO_EXCEPTIONS)
+        string(APPEND DESC " -fno-exceptions")
+    endif()
+    if(ARENA)
+        string(APPEND DESC " arena")
+    endif()
+    set(DESC_${CONFIG_ID} ${DESC})
+    list(APPEND CONFIGS ${CONFIG_ID})
+    message(STATUS "[${CONFIG_ID}] ${DESC}")
+    # configure and build
+    set(BUILD_DIR ${PDHKR_MATRIX_DIR}/config_${CONFIG_ID})
+    execute_process(
+        COMMAND ${CMAKE_COMMAND}
+            -S ${PDHKR_SOURCE_DIR}
+            -B ${BUILD_DIR}
+            -G ${PDHKR_GENERATOR}
+            -DCMAKE_BUILD_TYPE=Release
+            -DCMAKE_CXX_STANDARD=${STANDARD}
+            -DPDHKR_OPT_LEVEL=${OPT_LEVEL}
+            -DPDHKR_ENABLE_NATIVE=${NATIVE}
+            -DPDHKR_ENABLE_LTO=${LTO}
+            -DPDHKR_ENABLE_NO_EXCEPTIONS=${NO_EXCEPTIONS}
+            -DPDHKR_USE_ARENA=${ARENA}
+        RESULT_VARIABLE CONFIG_RESULT
+        OUTPUT_QUIET
+    )
+    if(CONFIG_RESULT)
+        message(WARNING "[${CONFIG_ID}] configure failed, skipping")
+        continue()
+    endif()
+    # multi-config generators need the build configuration specified
+    execute_process(
+        COMMAND ${CMAKE_COMMAND}
+            --build ${BUILD_DIR} --config Release -j ${PDHKR_N_JOBS}
+        RESULT_VARIABLE BUILD_RESULT
+        OUTPUT_QUIET
+    )
+    if(BUILD_RESULT)
+        message(WARNING "[${CONFIG_ID}] build failed, skipping")
+        continue()
+    endif()
+    # run test suite
+    pdhkr_run_tests(${CONFIG_ID} ${BUILD_DIR})
+endforeach()
+endforeach()
+endforeach()
+endforeach()
+endforeach()
+endforeach()
+
+# legend of configurations
+set(REPORT "Configurations:\n")
+foreach(CONFIG IN LISTS CONFIGS)
+    string(APPEND REPORT "  [${CONFIG}] ${DESC_${CONFIG}}\n")
+endforeach()
+string(APPEND REPORT "\nTotal test time per solver (msec):\n")
+
+# table header. first column is the solver name, last is the fastest config
+set(NAME_WIDTH 6)
+foreach(SOLVER IN LISTS SOLVERS)
+    string(LENGTH ${SOLVER} SOLVER_LEN)
+    if(SOLVER_LEN GREATER NAME_WIDTH)
+        set(NAME_WIDTH ${SOLVER_LEN})
+    endif()
+endforeach()
+set(COL_WIDTH 8)
+set(PADDING "                                                                ")
+set(HEADER "solver")
+string(LENGTH ${HEADER} HEADER_LEN)
+math(EXPR PAD_LEN "${NAME_WIDTH} - ${HEADER_LEN}")
+string(SUBSTRING ${PADDING} 0 ${PAD_LEN} PAD)
+set(HEADER "${HEADER}${PAD}")
+foreach(CONFIG IN LISTS CONFIGS ITEMS best)
+    if(NOT CONFIG STREQUAL "best")
+        set(CONFIG "[${CONFIG}]")
+    endif()
+    string(LENGTH ${CONFIG} CONFIG_LEN)
+    math(EXPR PAD_LEN "${COL_WIDTH} - ${CONFIG_LEN}")
+    string(SUBSTRING ${PADDING} 0 ${PAD_LEN} PAD)
+    string(APPEND HEADER " ${PAD}${CONFIG}")
+endforeach()
+string(APPEND REPORT "${HEADER}\n")
+
+# table rows, one per solver
+foreach(SOLVER IN LISTS SOLVERS)
+    string(LENGTH ${SOLVER} SOLVER_LEN)
+    math(EXPR PAD_LEN "${NAME_WIDTH} - ${SOLVER_LEN}")
+    string(SUBSTRING ${PADDING} 0 ${PAD_LEN} PAD)
+    set(ROW "${SOLVER}${PAD}")
+    set(BEST_CONFIG)
+    set(BEST_MSEC)
+    foreach(CONFIG IN LISTS CONFIGS)
+        # sum over the solver's tests. the total is n/a if any test failed
+        set(TOTAL 0)
+        foreach(TEST IN LISTS TESTS)
+            if(NOT SOLVER_${TEST} STREQUAL SOLVER)
+                continue()
+            endif()
+            if(NOT DEFINED TIME_${CONFIG}_${TEST})
+                set(TOTAL n/a)
+                break()
+            endif()
+            pdhkr_to_msec(MSEC ${TIME_${CONFIG}_${TEST}})
+            math(EXPR TOTAL "${TOTAL} + ${MSEC}")
+        endforeach()
+        # track fastest configuration. ties go to the earlier configuration
+        if(NOT TOTAL STREQUAL "n/a")
+            if(NOT DEFINED BEST_MSEC OR TOTAL LESS BEST_MSEC)
+                set(BEST_MSEC ${TOTAL})
+                set(BEST_CONFIG "[${CONFIG}]")
+            endif()
+        endif()
+        string(LENGTH ${TOTAL} TOTAL_LEN)
+        math(EXPR PAD_LEN "${COL_WIDTH} - ${TOTAL_LEN}")
+        string(SUBSTRING ${PADDING} 0 ${PAD_LEN} PAD)
+        string(APPEND ROW " ${PAD}${TOTAL}")
+    endforeach()
+    if(NOT BEST_CONFIG)
+        set(BEST_CONFIG n/a)
+    endif()
+    string(LENGTH ${BEST_CONFIG} BEST_LEN)
+    math(EXPR PAD_LEN "${COL_WIDTH} - ${BEST_LEN}")
+    string(SUBSTRING ${PADDING} 0 ${PAD_LEN} PAD)
+    string(APPEND ROW " ${PAD}${BEST_CONFIG}")
+    string(APPEND REPORT "${ROW}\n")
+endforeach()
+
+# per-test CSV for further analysis
+set(CSV "test")
+foreach(CONFIG IN LISTS CONFIGS)
+    string(APPEND CSV ",\"${DESC_${CONFIG}}\"")
+endforeach()
+string(APPEND CSV "\n")
+foreach(TEST IN LISTS TESTS)
+    string(APPEND CSV ${TEST})
+    foreach(CONFIG IN LISTS CONFIGS)
+        string(APPEND CSV ",${TIME_${CONFIG}_${TEST}}")
+    endforeach()
+    string(APPEND CSV "\n")
+endforeach()
+
+# write + print results
+file(WRITE ${PDHKR_MATRIX_DIR}/results.txt ${REPORT})
+file(WRITE ${PDHKR_MATRIX_DIR}/results.csv ${CSV})
+message("\n${REPORT}")
+message(STATUS "Results written to ${PDHKR_MATRIX_DIR}/results.txt")
+message(STATUS "Per-test times written to ${PDHKR_MATRIX_DIR}/results.csv")
@@ -0,0 +1,132 @@
+cmake_minimum_required(VERSION ${CMAKE_MINIMUM_REQUIRED_VERSION})
+
+##
+# Compile the given targets with -fno-exceptions where legal.
+#
+# Each of a target's sources is test compiled with -fno-exceptions and the
+# directory, target, and source compile definitions, so e.g. the definitions
+# selecting a test program VARIANT are honored. If all of them compile, the
+# target is compiled with -fno-exceptions. For test programs, i.e. targets
+# compiled with PDHKR_TEST defined, the sources are test compiled as test
+# programs. GCC and Clang reject throw, try, and catch when exceptions are
+# disabled so this is what determines legality. Results are computed once per
+# source, test program status, and set of target definitions, and the sources
+# that need exceptions are reported. MSVC is not supported so nothing is done
+# there.
+#
+# Arguments:
+#   TARGETS target...
+#       Targets to compile without exceptions if possible
+#
+function(pdhkr_disable_exceptions)
+    set(MULTI_VALUE_ARGS TARGETS)
+    cmake_parse_arguments(HOST "" "" "${MULTI_VALUE_ARGS}" ${ARGV})
+    if(NOT DEFINED HOST_TARGETS)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION}: missing TARGETS")
+    endif()
+    # no MSVC equivalent that also rejects throw expressions
+    if(MSVC)
+        return()
+    endif()
+    # directory-level definitions, e.g. PDHKR_LOCAL
+    get_directory_property(DIR_DEFINITIONS COMPILE_DEFINITIONS)
+    # names of sources that use exceptions, for reporting
+    set(EXCEPT_SOURCES)
+    foreach(TGT IN LISTS HOST_TARGETS)
+        # skip non-executables
+        get_target_property(TGT_TYPE ${TGT} TYPE)
+        if(NOT TGT_TYPE STREQUAL "EXECUTABLE")
+            continue()
+        endif()
+        # test programs need the PDHKR_TEST macros. since only legality is
+        # being checked any string literal will do for the input/output paths
+        get_target_property(TGT_DEFINITIONS ${TGT} COMPILE_DEFINITIONS)
+        if(TGT_DEFINITIONS AND "PDHKR_TEST" IN_LIST TGT_DEFINITIONS)
+            set(TEST_FLAGS
+                -DPDHKR_TEST
+                -DPDHKR_TEST_INPUT=__FILE__
+                -DPDHKR_TEST_OUTPUT=__FILE__
+            )
+            set(TEST_SUFFIX _test)
+        else()
+            set(TEST_FLAGS)
+            set(TEST_SUFFIX)
+        endif()
+        # other target definitions, e.g. from a test program VARIANT. the
+        # PDHKR_TEST* ones are replaced by the above and generator expressions
+        # cannot be evaluated here. the result name is suffixed with a hash
+        # since the same source may be compiled with different definitions
+        set(VARIANT_DEFINITIONS)
+        foreach(DEFINITION IN LISTS TGT_DEFINITIONS)
+            if(
+                DEFINITION AND
+                NOT DEFINITION MATCHES "^PDHKR_TEST" AND
+                NOT DEFINITION MATCHES "\\$<"
+            )
+                list(APPEND VARIANT_DEFINITIONS ${DEFINITION})
+            endif()
+        endforeach()
+        if(VARIANT_DEFINITIONS)
+            list(SORT VARIANT_DEFINITIONS)
+            string(MD5 VARIANT_HASH "${VARIANT_DEFINITIONS}")
+            string(SUBSTRING ${VARIANT_HASH} 0 8 VARIANT_SUFFIX)
+            set(VARIANT_SUFFIX _${VARIANT_SUFFIX})
+        else()
+            set(VARIANT_SUFFIX)
+        endif()
+        # test compile each source if not already done
+        get_target_property(TGT_SOURCE_DIR ${TGT} SOURCE_DIR)
+        get_target_property(TGT_SOURCES ${TGT} SOURCES)
+        set(TGT_LEGAL TRUE)
+        foreach(TGT_SOURCE IN LISTS TGT_SOURCES)
+            if(NOT IS_ABSOLUTE ${TGT_SOURCE})
+                set(TGT_SOURCE ${TGT_SOURCE_DIR}/${TGT_SOURCE})
+            endif()
+            get_filename_component(SRC_STEM ${TGT_SOURCE} NAME_WE)
+            set(
+                SRC_RESULT
+                PDHKR_NO_EXCEPTIONS_${SRC_STEM}${TEST_SUFFIX}${VARIANT_SUFFIX}
+            )
+            if(NOT DEFINED ${SRC_RESULT})
+                # definitions as -D flags
+                get_source_file_property(
+                    SRC_DEFINITIONS ${TGT_SOURCE} COMPILE_DEFINITIONS
+                )
+                set(DEFINITION_FLAGS)
+                foreach(
+                    DEFINITION IN LISTS
+                    DIR_DEFINITIONS VARIANT_DEFINITIONS SRC_DEFINITIONS
+                )
+                    if(DEFINITION)
+                        list(APPEND DEFINITION_FLAGS -D${DEFINITION})
+                    endif()
+                endforeach()
+                try_compile(
+                    ${SRC_RESULT}
+                    ${CMAKE_BINARY_DIR}/pdhkr_no_exceptions/${SRC_RESULT}
+                    ${TGT_SOURCE}
+                    CMAKE_FLAGS -DINCLUDE_DIRECTORIES=${PDHKR_INCLUDE_DIR}
+                    COMPILE_DEFINITIONS
+                        -fno-exceptions ${DEFINITION_FLAGS} ${TEST_FLAGS}
+                    CXX_STANDARD ${CMAKE_CXX_STANDARD}
+                )
+            endif()
+            if(NOT ${SRC_RESULT})
+                get_filename_component(SRC_NAME ${TGT_SOURCE} NAME)
+                list(APPEND EXCEPT_SOURCES ${SRC_NAME})
+                set(TGT_LEGAL FALSE)
+                break()
+            endif()
+        endforeach()
+        # only disable if legal
+        if(TGT_LEGAL)
+            target_compile_options(${TGT} PRIVATE -fno-exceptions)
+        endif()
+    endforeach()
+    # report sources for which exceptions could not be disabled
+    if(EXCEPT_SOURCES)
+        list(REMOVE_DUPLICATES EXCEPT_SOURCES)
+        list(JOIN EXCEPT_SOURCES " " EXCEPT_SOURCES)
+        message(STATUS "Exceptions kept for: ${EXCEPT_SOURCES}")
+    endif()
+endfunction()
@@ -1,5 +1,57 @@
 cmake_minimum_required(VERSION ${CMAKE_MINIMUM_REQUIRED_VERSION})
 
+##
+# Add a build rule generating a header that embeds a test case's files.
+#
+# The rule is added once per test case and shared by all the test programs of
+# the case, e.g. across variants. The header is regenerated whenever the .in or
+# .out file changes. #embed is used if the compiler supports it, otherwise the
+# bytes are written out as string literals, or as arrays for MSVC since it
+# limits the length of string literals.
+#
+# Arguments:
+#   target
+#       Name of the HackerRank submission target
+#
+#   case
+#       Test case identifier
+#
+# Sets PDHKR_EMBED_HEADER to the header path and PDHKR_EMBED_TARGET to the
+# target generating it in the parent scope.
+#
+function(pdhkr_embed_test_data TARGET CASE)
+    set(DATA_STEM ${CMAKE_SOURCE_DIR}/data/${TARGET}/${CASE})
+    set(HEADER ${CMAKE_BINARY_DIR}/embed/${TARGET}/${CASE}.hh)
+    set(EMBED_TARGET pdhkr_embed_${TARGET}_${CASE})
+    if(NOT TARGET ${EMBED_TARGET})
+        if(PDHKR_HAS_EMBED)
+            set(MODE embed)
+        elseif(MSVC)
+            set(MODE array)
+        else()
+            set(MODE string)
+        endif()
+        add_custom_command(
+            OUTPUT ${HEADER}
+            COMMAND ${CMAKE_COMMAND}
+                -DPDHKR_INPUT=${DATA_STEM}.in
+                -DPDHKR_OUTPUT=${DATA_STEM}.out
+                -DPDHKR_HEADER=${HEADER}
+                -DPDHKR_EMBED_MODE=${MODE}
+                -P ${CMAKE_SOURCE_DIR}/cmake/pdhkr_embed_data.cmake
+            DEPENDS
+                ${DATA_STEM}.in
+                ${DATA_STEM}.out
+                ${CMAKE_SOURCE_DIR}/cmake/pdhkr_embed_data.cmake
+            COMMENT "Embedding ${TARGET} test case ${CASE}"
+            VERBATIM
+        )
+        add_custom_target(${EMBED_TARGET} DEPENDS ${HEADER})
+    endif()
+    set(PDHKR_EMBED_HEADER ${HEADER} PARENT_SCOPE)
+    set(PDHKR_EMBED_TARGET ${EMBED_TARGET} PARENT_SCOPE)
+endfunction()
+
 ##
 # Add test programs for the given test cases for a HackerRank submission.
 #
@@ -42,11 +94,39 @@ cmake_minimum_required(VERSION ${CMAKE_MINIMUM_REQUIRED_VERSION})
 #       "Submit Code" version of a test case on HackerRank. Surprisingly, these
 #       can actually be different, which can be confusing.
 #
+#   VARIANT variant
+#       Optional variant name used to test an alternative implementation. If
+#       given, the test program names are target_variant_case_k instead. The
+#       input + output files are still read from data/my_program.
+#
+#   DEFINITIONS definition...
+#       Optional extra macro definitions for the test programs, e.g. to select
+#       the alternative implementation tested by a VARIANT
+#
+#   ERROR regex
+#       Optional regular expression for an expected error. If given, the test
+#       programs must fail, by exiting with failure or aborting, with output
+#       matching the regular expression, e.g. for invalid inputs. The .out
+#       files are then unused but should still exist, e.g. as empty files
+#
+# If PDHKR_EMBED_TEST_DATA is enabled, existing .in and .out files are instead
+# embedded in the test program by a header generated at build time with
+# pdhkr_embed_test_data. PDHKR_TEST_EMBED is then defined and PDHKR_TEST_INPUT
+# and PDHKR_TEST_OUTPUT name the embedded files, so the test program does no
+# file I/O and can be run from anywhere.
+#
+# A .in or .out file may be replaced by its compressed .lz version, e.g. one
+# written with the pdhkr_lz tool, without changing the registration, since the
+# test programs read PDHKR_TEST_INPUT and PDHKR_TEST_OUTPUT with a stream that
+# falls back to the .lz file and decompresses it on the fly. Such cases are not
+# embedded and are still read from data/ when embedding is enabled.
+#
 function(pdhkr_add_tests)
     # parse TARGET parent target name, TEST_CASES test target suffices + stems
-    # for the input/output files. ARGV contains all the function arguments
-    set(SINGLE_VALUE_ARGS TARGET)
-    set(MULTI_VALUE_ARGS TEST_CASES)
+    # for the input/output files, optional VARIANT name + DEFINITIONS + ERROR.
+    # ARGV contains all the function arguments
+    set(SINGLE_VALUE_ARGS TARGET VARIANT ERROR)
+    set(MULTI_VALUE_ARGS TEST_CASES DEFINITIONS)
     cmake_parse_arguments(
         HOST
         "" "${SINGLE_VALUE_ARGS}" "${MULTI_VALUE_ARGS}" ${ARGV}
@@ -58,28 +138,67 @@ function(pdhkr_add_tests)
     if(NOT DEFINED HOST_TEST_CASES)
         message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION}: missing TEST_CASES")
     endif()
+    # test program name prefix
+    if(DEFINED HOST_VARIANT)
+        set(TEST_PREFIX ${HOST_TARGET}_${HOST_VARIANT})
+    else()
+        set(TEST_PREFIX ${HOST_TARGET})
+    endif()
     # for each of the test case stems
     foreach(CASE IN LISTS HOST_TEST_CASES)
         # test target name
-        set(TEST_TARGET ${HOST_TARGET}_${CASE})
+        set(TEST_TARGET ${TEST_PREFIX}_${CASE})
         # executable combines suffix with target
         add_executable(${TEST_TARGET} ${HOST_TARGET}.cc)
         # dependent on host target so that if host target compilation fails
         # the test targets are not compiled. if this is not done, all the test
         # targets will also fail and duplicate compile messages are shown
         add_dependencies(${TEST_TARGET} ${HOST_TARGET})
-        # macro definitions for enabling testing + providing input/output files
-        target_compile_definitions(
-            ${TEST_TARGET} PRIVATE
-            PDHKR_TEST
-            # quotes are needed to pass a string value via macro. we use absolute
-            # paths here so that the program can be run from different directories.
-            # note: cannot break string here or else CMake sees syntax error
-            PDHKR_TEST_INPUT="${CMAKE_SOURCE_DIR}/data/${HOST_TARGET}/${CASE}.in"
-            PDHKR_TEST_OUTPUT="${CMAKE_SOURCE_DIR}/data/${HOST_TARGET}/${CASE}.out"
+        # macro definitions for enabling testing + providing input/output files.
+        # missing files can't be embedded so they are left to fail at runtime
+        set(DATA_STEM ${CMAKE_SOURCE_DIR}/data/${HOST_TARGET}/${CASE})
+        if(
+            PDHKR_EMBED_TEST_DATA AND
+            EXISTS ${DATA_STEM}.in AND EXISTS ${DATA_STEM}.out
         )
-        # add for CTest
-        add_test(NAME ${TEST_TARGET} COMMAND ${TEST_TARGET})
+            pdhkr_embed_test_data(${HOST_TARGET} ${CASE})
+            add_dependencies(${TEST_TARGET} ${PDHKR_EMBED_TARGET})
+            target_compile_definitions(
+                ${TEST_TARGET} PRIVATE
+                PDHKR_TEST
+                PDHKR_TEST_EMBED
+                PDHKR_TEST_DATA_HEADER="${PDHKR_EMBED_HEADER}"
+                PDHKR_TEST_INPUT=pdhkr::test_data::input
+                PDHKR_TEST_OUTPUT=pdhkr::test_data::output
+                ${HOST_DEFINITIONS}
+            )
+        else()
+            target_compile_definitions(
+                ${TEST_TARGET} PRIVATE
+                PDHKR_TEST
+                # quotes are needed to pass a string value via macro. we use absolute
+                # paths here so that the program can be run from different directories.
+                # note: cannot break string here or else CMake sees syntax error
+                PDHKR_TEST_INPUT="${CMAKE_SOURCE_DIR}/data/${HOST_TARGET}/${CASE}.in"
+                PDHKR_TEST_OUTPUT="${CMAKE_SOURCE_DIR}/data/${HOST_TARGET}/${CASE}.out"
+                ${HOST_DEFINITIONS}
+            )
+        endif()
+        # add for CTest. expected errors are checked by running in script mode
+        if(DEFINED HOST_ERROR)
+            add_test(
+                NAME ${TEST_TARGET}
+                COMMAND ${CMAKE_COMMAND}
+                    -DPDHKR_PROGRAM=$<TARGET_FILE:${TEST_TARGET}>
+                    -DPDHKR_ERROR=${HOST_ERROR}
+                    -P ${CMAKE_SOURCE_DIR}/cmake/pdhkr_expect_error.cmake
+            )
+        else()
+            add_test(NAME ${TEST_TARGET} COMMAND ${TEST_TARGET})
+        endif()
+        # label with the solver name so tests can be grouped per solver, e.g.
+        # by pdhkr_opt_matrix, without having to parse the test names
+        set_tests_properties(${TEST_TARGET} PROPERTIES LABELS ${TEST_PREFIX})
     endforeach()
 endfunction()
 
@@ -99,10 +218,14 @@ endfunction()
 #       underscore, that is also the stem for the relevant .in, .out files.
 #       See pdhkr_add_tests for details on the naming convention.
 #
+#   VARIANT variant
+#       Optional variant name the test programs were added with
+#
 function(pdhkr_xfail_tests)
     # parse TARGET parent target name, TEST_CASES test target suffices + stems
-    # for the input/output files. ARGV contains all the function arguments
-    set(SINGLE_VALUE_ARGS TARGET)
+    # for the input/output files, optional VARIANT name. ARGV contains all the
+    # function arguments
+    set(SINGLE_VALUE_ARGS TARGET VARIANT)
     set(MULTI_VALUE_ARGS TEST_CASES)
     cmake_parse_arguments(
         HOST
@@ -115,9 +238,15 @@ function(pdhkr_xfail_tests)
     if(NOT DEFINED HOST_TEST_CASES)
         message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION}: missing TEST_CASES")
     endif()
+    # test program name prefix
+    if(DEFINED HOST_VARIANT)
+        set(TEST_PREFIX ${HOST_TARGET}_${HOST_VARIANT})
+    else()
+        set(TEST_PREFIX ${HOST_TARGET})
+    endif()
     # disable for each test case stem
     foreach(CASE IN LISTS HOST_TEST_CASES)
-        set_tests_properties(${HOST_TARGET}_${CASE} PROPERTIES SKIP_RETURN_CODE 1)
+        set_tests_properties(${TEST_PREFIX}_${CASE} PROPERTIES SKIP_RETURN_CODE 1)
     endforeach()
 endfunction()
 
@@ -138,10 +267,14 @@ endfunction()
 #       underscore, that is also the stem for the relevant .in, .out files.
 #       See pdhkr_add_tests for details on the naming convention.
 #
+#   VARIANT variant
+#       Optional variant name the test programs were added with
+#
 function(pdhkr_disable_tests)
     # parse TARGET parent target name, TEST_CASES test target suffices + stems
-    # for the input/output files. ARGV contains all the function arguments
-    set(SINGLE_VALUE_ARGS TARGET)
+    # for the input/output files, optional VARIANT name. ARGV contains all the
+    # function arguments
+    set(SINGLE_VALUE_ARGS TARGET VARIANT)
     set(MULTI_VALUE_ARGS TEST_CASES)
     cmake_parse_arguments(
         HOST
@@ -154,8 +287,108 @@ function(pdhkr_disable_tests)
     if(NOT DEFINED HOST_TEST_CASES)
         message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION}: missing TEST_CASES")
     endif()
+    # test program name prefix
+    if(DEFINED HOST_VARIANT)
+        set(TEST_PREFIX ${HOST_TARGET}_${HOST_VARIANT})
+    else()
+        set(TEST_PREFIX ${HOST_TARGET})
+    endif()
     # disable for each test case stem
     foreach(CASE IN LISTS HOST_TEST_CASES)
-        set_tests_properties(${HOST_TARGET}_${CASE} PROPERTIES DISABLED ON)
+        set_tests_properties(${TEST_PREFIX}_${CASE} PROPERTIES DISABLED ON)
     endforeach()
 endfunction()
+
+##
+# Add a program that checks small test cases at compile time.
+#
+# Each test case's .in and .out files are read at configure time and written
+# into a translation unit generated from pdhkr_constexpr_tests.cc.in as integer
+# arrays, each checked in a static_assert by a constexpr check_<problem>
+# function defined in the template. Cases therefore cost nothing at test time,
+# and a solver change that breaks constant evaluation fails the build. The
+# program is also registered as a CTest test, which trivially passes.
+#
+# This needs C++20 constexpr std::vector and algorithms, so nothing is added
+# if the standard library does not provide them.
+#
+# Arguments:
+#   TARGET target
+#       Name of the program target, also used as the test name
+#
+#   TEST_CASES problem/case...
+#       Test cases given as data/ subdirectory and case stem, e.g.
+#       equal_stacks/0. The problem must have a check function in the template
+#
+function(pdhkr_add_constexpr_tests)
+    # parse TARGET constexpr test target name, TEST_CASES problem/case stems
+    set(SINGLE_VALUE_ARGS TARGET)
+    set(MULTI_VALUE_ARGS TEST_CASES)
+    cmake_parse_arguments(
+        HOST
+        "" "${SINGLE_VALUE_ARGS}" "${MULTI_VALUE_ARGS}" ${ARGV}
+    )
+    if(NOT DEFINED HOST_TARGET)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION}: missing TARGET")
+    endif()
+    if(NOT DEFINED HOST_TEST_CASES)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION}: missing TEST_CASES")
+    endif()
+    include(CheckCXXSourceCompiles)
+    check_cxx_source_compiles(
+        "#include <algorithm>
+#include <vector>
+#ifndef __cpp_lib_constexpr_vector
+#error \"no constexpr std::vector\"
+#endif
+#ifndef __cpp_lib_constexpr_algorithms
+#error \"no constexpr algorithms\"
+#endif
+int main() { return 0; }"
+        PDHKR_HAS_CONSTEXPR_VECTOR
+    )
+    if(NOT PDHKR_HAS_CONSTEXPR_VECTOR)
+        message(STATUS "Compile-time tests: Disabled (needs C++20 library)")
+        return()
+    endif()
+    message(STATUS "Compile-time tests: Enabled")
+    set(PDHKR_CONSTEXPR_TARGET ${HOST_TARGET})
+    set(PDHKR_CONSTEXPR_CASES "")
+    foreach(TEST_CASE IN LISTS HOST_TEST_CASES)
+        string(REPLACE "/" ";" CASE_PARTS ${TEST_CASE})
+        list(GET CASE_PARTS 0 PROBLEM)
+        # C++ identifier stem, e.g. equal_stacks_0
+        string(MAKE_C_IDENTIFIER ${TEST_CASE} CASE_ID)
+        # comma-separated token arrays for the .in and .out files
+        foreach(EXT IN ITEMS in out)
+            set(CASE_FILE ${CMAKE_SOURCE_DIR}/data/${TEST_CASE}.${EXT})
+            # reconfigure if the test case changes
+            set_property(
+                DIRECTORY APPEND PROPERTY
+                CMAKE_CONFIGURE_DEPENDS ${CASE_FILE}
+            )
+            file(READ ${CASE_FILE} TOKENS)
+            string(STRIP "${TOKENS}" TOKENS)
+            string(REGEX REPLACE "[ \t\r\n]+" ", " TOKENS "${TOKENS}")
+            string(
+                APPEND PDHKR_CONSTEXPR_CASES
+                "constexpr long long ${CASE_ID}_${EXT}[] = {${TOKENS}};\n"
+            )
+        endforeach()
+        string(
+            APPEND PDHKR_CONSTEXPR_CASES
+            "static_assert(
+  check_${PROBLEM}(${CASE_ID}_in, ${CASE_ID}_out),
+  \"${TEST_CASE} failed\"
+);\n\n"
+        )
+    endforeach()
+    set(GENERATED_SOURCE ${CMAKE_CURRENT_BINARY_DIR}/${HOST_TARGET}.cc)
+    configure_file(
+        ${CMAKE_SOURCE_DIR}/cmake/pdhkr_constexpr_tests.cc.in
+        ${GENERATED_SOURCE}
+        @ONLY
+    )
+    add_executable(${HOST_TARGET} ${GENERATED_SOURCE})
+    add_test(NAME ${HOST_TARGET} COMMAND ${HOST_TARGET})
+endfunction()
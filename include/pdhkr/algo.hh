@@ -0,0 +1,34 @@
+/**
+ * @file algo.hh
+ * @author Derek Huang
+ * @brief C++ header for the embeddable solver algorithm library
+ * @copyright MIT License
+ *
+ * The `pdhkr::algo` functions are the solver cores of the HackerRank programs
+ * without any stream I/O, taking iterator ranges instead of parsed text. They
+ * are header-only and can be used through the installed `pdhkr::algo` CMake
+ * target, e.g. after `find_package(pdhkr)`.
+ */
+
+#ifndef PDHKR_ALGO_HH_
+#define PDHKR_ALGO_HH_
+
+#include "pdhkr/algo/array_manipulation.hh"
+#include "pdhkr/algo/binary_search_tree.hh"
+#include "pdhkr/algo/components.hh"
+#include "pdhkr/algo/dispatch.hh"
+#include "pdhkr/algo/equal_stacks.hh"
+#include "pdhkr/algo/jesse_and_cookies.hh"
+#include "pdhkr/algo/journey_to_moon.hh"
+#include "pdhkr/algo/max_stack.hh"
+#include "pdhkr/algo/merge_lists.hh"
+#include "pdhkr/algo/node_from_tail.hh"
+#include "pdhkr/algo/rectangle_manipulation.hh"
+#include "pdhkr/algo/roads_and_libraries.hh"
+#include "pdhkr/algo/running_median.hh"
+#include "pdhkr/algo/segment_tree.hh"
+#include "pdhkr/algo/subtrees_and_paths.hh"
+#include "pdhkr/algo/swap_tree_nodes.hh"
+#include "pdhkr/algo/two_stack_game.hh"
+
+#endif  // PDHKR_ALGO_HH_
@@ -0,0 +1,97 @@
+/**
+ * @file algo/array_manipulation.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Array Manipulation" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_ARRAY_MANIPULATION_HH_
+#define PDHKR_ALGO_ARRAY_MANIPULATION_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "pdhkr/algo/dispatch.hh"
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Return the max array value after adding values to ranges of a zero array.
+ *
+ * Each addition of `k` to `[a, b]` is recorded in a difference array as `+k`
+ * at `a` and `-k` after `b`, so the array values are the prefix sums of the
+ * difference array. This is linear in the array size plus the number of
+ * additions, instead of their product when updating the array directly.
+ *
+ * @tparam Acc Unsigned type that can hold the sum of all the `k` values
+ * @tparam InputIt Input iterator over tuple-like `(a, b, k)` additions, where
+ *  `[a, b]` is a 1-based inclusive index range
+ *
+ * @param n Array size
+ * @param first Iterator to the first addition
+ * @param last Iterator one past the last addition
+ */
+template <typename Acc, typename InputIt>
+Acc array_manipulation(
+  type_tag<Acc> /*acc*/, std::size_t n, InputIt first, InputIt last)
+{
+  // unsigned wraparound is fine since every prefix sum is nonnegative
+  std::vector<Acc> diffs(n + 1);
+  for (; first != last; ++first) {
+    const auto& op = *first;
+    auto a = static_cast<std::size_t>(std::get<0>(op));
+    auto b = static_cast<std::size_t>(std::get<1>(op));
+    auto k = static_cast<Acc>(std::get<2>(op));
+    if (a < 1 || a > b || b > n)
+      throw_error<std::out_of_range>("Invalid addition range");
+    diffs[a - 1] += k;
+    diffs[b] -= k;
+  }
+  Acc value = 0;
+  Acc max_value = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    value += diffs[i];
+    max_value = std::max(max_value, value);
+  }
+  return max_value;
+}
+
+/**
+ * Return the max array value after adding values to ranges of a zero array.
+ *
+ * The additions are scanned once for the sum of the `k` values, which bounds
+ * every array value, and the narrowest accumulator for the bound is used, so
+ * the difference array is denser for small inputs.
+ *
+ * @tparam ForwardIt Forward iterator over tuple-like `(a, b, k)` additions,
+ *  where `[a, b]` is a 1-based inclusive index range and `k` is nonnegative
+ *
+ * @param n Array size
+ * @param first Iterator to the first addition
+ * @param last Iterator one past the last addition
+ */
+template <typename ForwardIt>
+unsigned long long array_manipulation(
+  std::size_t n, ForwardIt first, ForwardIt last)
+{
+  widest_uint max_value = 0;
+  for (auto it = first; it != last; ++it)
+    max_value += static_cast<unsigned long long>(std::get<2>(*it));
+  return dispatch_accumulator(
+    max_value,
+    [&](auto acc)
+    {
+      return checked_narrow<unsigned long long>(
+        array_manipulation(acc, n, first, last)
+      );
+    }
+  );
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_ARRAY_MANIPULATION_HH_
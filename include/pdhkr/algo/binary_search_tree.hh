@@ -0,0 +1,148 @@
+/**
+ * @file algo/binary_search_tree.hh
+ * @author Derek Huang
+ * @brief C++ header for binary search tree traversals
+ * @copyright MIT License
+ *
+ * Algorithms for the "Tree: Level Order Traversal" and "Tree : Top View"
+ * problems, where the tree is built by inserting values in input order.
+ */
+
+#ifndef PDHKR_ALGO_BINARY_SEARCH_TREE_HH_
+#define PDHKR_ALGO_BINARY_SEARCH_TREE_HH_
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace pdhkr::algo {
+
+/**
+ * Unbalanced binary search tree stored as flat arrays of child indices.
+ *
+ * Values less than or equal to a node's value go into its left subtree. There
+ * is no rebalancing since the tree shape is what the problems ask about.
+ *
+ * @tparam T Value type
+ */
+template <typename T>
+class binary_search_tree {
+public:
+  /**
+   * Insert a value.
+   *
+   * @param value Value to insert
+   */
+  void insert(T value)
+  {
+    auto index = values_.size();
+    values_.push_back(std::move(value));
+    left_.push_back(npos);
+    right_.push_back(npos);
+    if (!index)
+      return;
+    const auto& inserted = values_.back();
+    std::size_t node = 0;
+    while (true) {
+      auto& child = (inserted <= values_[node]) ? left_[node] : right_[node];
+      if (child == npos) {
+        child = index;
+        return;
+      }
+      node = child;
+    }
+  }
+
+  /**
+   * Return the number of values.
+   */
+  auto size() const noexcept
+  {
+    return values_.size();
+  }
+
+  /**
+   * Write the values in level order, i.e. breadth-first from the root.
+   *
+   * @tparam OutputIt Output iterator accepting `T`
+   *
+   * @param out Output iterator for the values
+   * @returns Output iterator one past the last value written
+   */
+  template <typename OutputIt>
+  OutputIt level_order(OutputIt out) const
+  {
+    if (values_.empty())
+      return out;
+    std::deque<std::size_t> queue{0};
+    while (queue.size()) {
+      auto node = queue.front();
+      queue.pop_front();
+      *out++ = values_[node];
+      if (left_[node] != npos)
+        queue.push_back(left_[node]);
+      if (right_[node] != npos)
+        queue.push_back(right_[node]);
+    }
+    return out;
+  }
+
+  /**
+   * Write the values visible from above the tree, from left to right.
+   *
+   * Nodes are visited breadth-first with their horizontal offset from the
+   * root. The first node seen at a new leftmost or rightmost offset is the
+   * one visible from above at that offset.
+   *
+   * @tparam OutputIt Output iterator accepting `T`
+   *
+   * @param out Output iterator for the values
+   * @returns Output iterator one past the last value written
+   */
+  template <typename OutputIt>
+  OutputIt top_view(OutputIt out) const
+  {
+    if (values_.empty())
+      return out;
+    // top nodes left of the root (nearest last) and right of the root
+    std::vector<std::size_t> left_nodes;
+    std::vector<std::size_t> right_nodes;
+    std::deque<std::pair<std::size_t, long>> queue{{0, 0}};
+    long leftmost = 0;
+    long rightmost = 0;
+    while (queue.size()) {
+      auto [node, offset] = queue.front();
+      queue.pop_front();
+      if (offset < leftmost) {
+        leftmost = offset;
+        left_nodes.push_back(node);
+      }
+      else if (offset > rightmost) {
+        rightmost = offset;
+        right_nodes.push_back(node);
+      }
+      if (left_[node] != npos)
+        queue.emplace_back(left_[node], offset - 1);
+      if (right_[node] != npos)
+        queue.emplace_back(right_[node], offset + 1);
+    }
+    for (auto it = left_nodes.rbegin(); it != left_nodes.rend(); it++)
+      *out++ = values_[*it];
+    *out++ = values_[0];
+    for (auto node : right_nodes)
+      *out++ = values_[node];
+    return out;
+  }
+
+private:
+  // sentinel for a missing child
+  static constexpr auto npos = static_cast<std::size_t>(-1);
+  std::vector<T> values_;
+  std::vector<std::size_t> left_;
+  std::vector<std::size_t> right_;
+};
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_BINARY_SEARCH_TREE_HH_
@@ -0,0 +1,91 @@
+/**
+ * @file algo/components.hh
+ * @author Derek Huang
+ * @brief C++ header for connected components of undirected graphs
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_COMPONENTS_HH_
+#define PDHKR_ALGO_COMPONENTS_HH_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "pdhkr/algo/dispatch.hh"
+#include "pdhkr/dsu.hh"
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Return the sizes of the connected components of an undirected graph.
+ *
+ * Components are found with the union-find forest of `pdhkr::disjoint_sets`,
+ * using union by size and path halving, so no adjacency structure is built
+ * and the cost is near-linear in the number of nodes and edges. Isolated nodes
+ * are components of size 1.
+ *
+ * @tparam Index Unsigned index type that can hold `n_nodes`
+ * @tparam InputIt Input iterator over pair-like edges, e.g. `std::pair`
+ *
+ * @param n_nodes Number of nodes
+ * @param first Iterator to the first edge
+ * @param last Iterator one past the last edge
+ * @param base ID of the first node, e.g. 1 for 1-indexed node IDs
+ * @returns Component sizes in unspecified order
+ */
+template <typename Index, typename InputIt>
+std::vector<Index> component_sizes(
+  type_tag<Index> /*index*/,
+  std::size_t n_nodes,
+  InputIt first,
+  InputIt last,
+  std::size_t base = 0)
+{
+  disjoint_sets<Index> components{n_nodes};
+  // convert node ID to index
+  auto node_index = [n_nodes, base](auto id)
+  {
+    auto index = static_cast<std::size_t>(id);
+    if (index < base || index - base >= n_nodes)
+      throw_error<std::out_of_range>(
+        "Node ID " + std::to_string(index) + " out of range"
+      );
+    return static_cast<Index>(index - base);
+  };
+  // union the components of each edge's end nodes
+  for (; first != last; ++first) {
+    const auto& edge = *first;
+    components.unite(
+      node_index(std::get<0>(edge)), node_index(std::get<1>(edge))
+    );
+  }
+  return components.component_sizes();
+}
+
+/**
+ * Return the sizes of the connected components of an undirected graph.
+ *
+ * Same as the `type_tag<Index>` overload with `std::size_t` indices.
+ *
+ * @tparam InputIt Input iterator over pair-like edges, e.g. `std::pair`
+ *
+ * @param n_nodes Number of nodes
+ * @param first Iterator to the first edge
+ * @param last Iterator one past the last edge
+ * @param base ID of the first node, e.g. 1 for 1-indexed node IDs
+ * @returns Component sizes in unspecified order
+ */
+template <typename InputIt>
+std::vector<std::size_t> component_sizes(
+  std::size_t n_nodes, InputIt first, InputIt last, std::size_t base = 0)
+{
+  return component_sizes(type_tag<std::size_t>{}, n_nodes, first, last, base);
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_COMPONENTS_HH_
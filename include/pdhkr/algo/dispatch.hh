@@ -0,0 +1,114 @@
+/**
+ * @file algo/dispatch.hh
+ * @author Derek Huang
+ * @brief C++ header for runtime dispatch to narrow index and value types
+ * @copyright MIT License
+ *
+ * The solver cores take `type_tag<T>` arguments selecting the unsigned types
+ * used for node indices and for accumulated values. Narrow index types make
+ * per-node arrays denser, e.g. a union-find forest over `std::uint16_t` is a
+ * quarter the size of one over `std::size_t`, while wide accumulators keep
+ * large inputs from overflowing. The dispatch functions here pick the
+ * narrowest type that is safe for bounds computed from the parsed input.
+ */
+
+#ifndef PDHKR_ALGO_DISPATCH_HH_
+#define PDHKR_ALGO_DISPATCH_HH_
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "pdhkr/error.hh"
+
+// unsigned __int128 is a GCC/Clang extension
+#if defined(__SIZEOF_INT128__)
+#define PDHKR_HAS_UINT128 1
+#else
+#define PDHKR_HAS_UINT128 0
+#endif  // !defined(__SIZEOF_INT128__)
+
+namespace pdhkr::algo {
+
+/**
+ * Tag type used to pass a type as a function argument.
+ *
+ * @tparam T Type
+ */
+template <typename T>
+struct type_tag {
+  using type = T;
+};
+
+/**
+ * Widest unsigned type, used to compute bounds that may exceed 64 bits.
+ */
+#if PDHKR_HAS_UINT128
+__extension__ typedef unsigned __int128 uint128;
+using widest_uint = uint128;
+#else
+using widest_uint = std::uintmax_t;
+#endif  // !PDHKR_HAS_UINT128
+
+/**
+ * Invoke a callable with the narrowest unsigned index type for a max value.
+ *
+ * The type is one of `std::uint16_t`, `std::uint32_t`, and `std::uint64_t`.
+ *
+ * @tparam F Callable with signature `R(type_tag<T>)` for each index type `T`
+ *
+ * @param max_value Largest value that must be representable
+ * @param f Callable to invoke
+ */
+template <typename F>
+decltype(auto) dispatch_index(std::uintmax_t max_value, F&& f)
+{
+  if (max_value <= std::numeric_limits<std::uint16_t>::max())
+    return f(type_tag<std::uint16_t>{});
+  if (max_value <= std::numeric_limits<std::uint32_t>::max())
+    return f(type_tag<std::uint32_t>{});
+  return f(type_tag<std::uint64_t>{});
+}
+
+/**
+ * Invoke a callable with the narrowest unsigned accumulator for a max value.
+ *
+ * The type is one of `std::uint32_t`, `std::uint64_t`, and `uint128` if it
+ * is available. Without `uint128`, bounds past 64 bits get `std::uint64_t`.
+ *
+ * @tparam F Callable with signature `R(type_tag<T>)` for each value type `T`
+ *
+ * @param max_value Largest value that must be representable
+ * @param f Callable to invoke
+ */
+template <typename F>
+decltype(auto) dispatch_accumulator(widest_uint max_value, F&& f)
+{
+  if (max_value <= std::numeric_limits<std::uint32_t>::max())
+    return f(type_tag<std::uint32_t>{});
+#if PDHKR_HAS_UINT128
+  if (max_value > std::numeric_limits<std::uint64_t>::max())
+    return f(type_tag<uint128>{});
+#endif  // PDHKR_HAS_UINT128
+  return f(type_tag<std::uint64_t>{});
+}
+
+/**
+ * Return an unsigned value converted to a narrower unsigned type.
+ *
+ * @tparam To Unsigned target type
+ * @tparam From Unsigned source type, possibly `uint128`
+ *
+ * @param value Value to convert
+ */
+template <typename To, typename From>
+To checked_narrow(From value)
+{
+  if (value > static_cast<From>(std::numeric_limits<To>::max()))
+    throw_error<std::overflow_error>("Result does not fit in the result type");
+  return static_cast<To>(value);
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_DISPATCH_HH_
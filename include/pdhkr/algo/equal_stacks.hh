@@ -0,0 +1,62 @@
+/**
+ * @file algo/equal_stacks.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Equal Stacks" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_EQUAL_STACKS_HH_
+#define PDHKR_ALGO_EQUAL_STACKS_HH_
+
+#include <algorithm>
+#include <numeric>
+
+#include "pdhkr/features.h"
+
+namespace pdhkr::algo {
+
+/**
+ * Return max equal height of three stacks after removing values from the top.
+ *
+ * Nothing is removed. Only the stack totals are tracked, with values taken
+ * off the tallest stacks until the totals agree or a stack is empty.
+ *
+ * @tparam ForwardIt1 Forward iterator over the first stack, top first
+ * @tparam ForwardIt2 Forward iterator over the second stack, top first
+ * @tparam ForwardIt3 Forward iterator over the third stack, top first
+ *
+ * @param first_1 Iterator to the top of the first stack
+ * @param last_1 Iterator one past the bottom of the first stack
+ * @param first_2 Iterator to the top of the second stack
+ * @param last_2 Iterator one past the bottom of the second stack
+ * @param first_3 Iterator to the top of the third stack
+ * @param last_3 Iterator one past the bottom of the third stack
+ */
+template <typename ForwardIt1, typename ForwardIt2, typename ForwardIt3>
+PDHKR_CONSTEXPR20 unsigned long long max_equal_height(
+  ForwardIt1 first_1,
+  ForwardIt1 last_1,
+  ForwardIt2 first_2,
+  ForwardIt2 last_2,
+  ForwardIt3 first_3,
+  ForwardIt3 last_3)
+{
+  auto total_1 = std::accumulate(first_1, last_1, 0ULL);
+  auto total_2 = std::accumulate(first_2, last_2, 0ULL);
+  auto total_3 = std::accumulate(first_3, last_3, 0ULL);
+  while (total_1 != total_2 || total_2 != total_3) {
+    // remove from the tallest stack(s) only
+    auto min_total = std::min({total_1, total_2, total_3});
+    if (total_1 > min_total)
+      total_1 -= *first_1++;
+    if (total_2 > min_total)
+      total_2 -= *first_2++;
+    if (total_3 > min_total)
+      total_3 -= *first_3++;
+  }
+  return total_1;
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_EQUAL_STACKS_HH_
@@ -0,0 +1,63 @@
+/**
+ * @file algo/jesse_and_cookies.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Jesse and Cookies" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_JESSE_AND_COOKIES_HH_
+#define PDHKR_ALGO_JESSE_AND_COOKIES_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "pdhkr/features.h"
+
+namespace pdhkr::algo {
+
+/**
+ * Return number of mixes needed until all the values reach the target.
+ *
+ * Each mix replaces the lowest two values `m_1 <= m_2` with `m_1 + 2 * m_2`,
+ * so the count never exceeds the number of values minus 1. Mixed values are
+ * kept as `unsigned long long` so they do not overflow the input type.
+ *
+ * @tparam InputIt Input iterator over unsigned integral values
+ *
+ * @param first Iterator to the first value
+ * @param last Iterator one past the last value
+ * @param target Target value
+ * @returns Mix count, -1 if there are no values or the target is unreachable
+ */
+template <typename InputIt>
+PDHKR_CONSTEXPR20 std::ptrdiff_t mixing_count(
+  InputIt first, InputIt last, unsigned long long target)
+{
+  // min-heap managed with the heap algorithms instead of std::priority_queue
+  // since those are constexpr in C++20
+  std::vector<unsigned long long> heap(first, last);
+  if (heap.empty())
+    return -1;
+  std::greater<unsigned long long> greater;
+  std::make_heap(heap.begin(), heap.end(), greater);
+  std::ptrdiff_t count = 0;
+  while (heap.front() < target) {
+    if (heap.size() < 2)
+      return -1;
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    auto m_1 = heap.back();
+    heap.pop_back();
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    // replace m_2 in place instead of popping and pushing
+    heap.back() = m_1 + 2 * heap.back();
+    std::push_heap(heap.begin(), heap.end(), greater);
+    count++;
+  }
+  return count;
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_JESSE_AND_COOKIES_HH_
@@ -0,0 +1,87 @@
+/**
+ * @file algo/journey_to_moon.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Journey to the Moon" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_JOURNEY_TO_MOON_HH_
+#define PDHKR_ALGO_JOURNEY_TO_MOON_HH_
+
+#include <cstddef>
+
+#include "pdhkr/algo/components.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Return the number of pairs of astronauts from different countries.
+ *
+ * Astronauts from the same country form a connected component of the graph
+ * of astronaut pairs. Each component pairs with all the components before it,
+ * so a running total of the astronauts seen gives the count in linear time.
+ *
+ * @tparam Index Unsigned index type that can hold `n_astronauts`
+ * @tparam Acc Unsigned type that can hold the pair count
+ * @tparam InputIt Input iterator over pair-like astronaut ID pairs
+ *
+ * @param n_astronauts Number of astronauts, with IDs from 0
+ * @param first Iterator to the first astronaut pair
+ * @param last Iterator one past the last astronaut pair
+ */
+template <typename Index, typename Acc, typename InputIt>
+Acc journey_to_moon(
+  type_tag<Index> index,
+  type_tag<Acc> /*acc*/,
+  std::size_t n_astronauts,
+  InputIt first,
+  InputIt last)
+{
+  Acc n_pairs = 0;
+  Index n_seen = 0;
+  for (auto size : component_sizes(index, n_astronauts, first, last)) {
+    // widen before multiplying so the product cannot wrap
+    n_pairs += static_cast<Acc>(n_seen) * size;
+    n_seen += size;
+  }
+  return n_pairs;
+}
+
+/**
+ * Return the number of pairs of astronauts from different countries.
+ *
+ * The narrowest index type for `n_astronauts` and accumulator for the
+ * `n_astronauts * (n_astronauts - 1) / 2` pair count bound are used.
+ *
+ * @tparam InputIt Input iterator over pair-like astronaut ID pairs
+ *
+ * @param n_astronauts Number of astronauts, with IDs from 0
+ * @param first Iterator to the first astronaut pair
+ * @param last Iterator one past the last astronaut pair
+ */
+template <typename InputIt>
+unsigned long long journey_to_moon(
+  std::size_t n_astronauts, InputIt first, InputIt last)
+{
+  auto n = static_cast<widest_uint>(n_astronauts);
+  auto max_pairs = (n) ? n * (n - 1) / 2 : n;
+  return dispatch_index(
+    n_astronauts,
+    [&](auto index)
+    {
+      return dispatch_accumulator(
+        max_pairs,
+        [&](auto acc)
+        {
+          return checked_narrow<unsigned long long>(
+            journey_to_moon(index, acc, n_astronauts, first, last)
+          );
+        }
+      );
+    }
+  );
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_JOURNEY_TO_MOON_HH_
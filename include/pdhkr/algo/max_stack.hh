@@ -0,0 +1,106 @@
+/**
+ * @file algo/max_stack.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Maximum Element" stack
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_MAX_STACK_HH_
+#define PDHKR_ALGO_MAX_STACK_HH_
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Stack with constant-time access to its maximum value.
+ *
+ * Each element is stored with the max of itself and the elements below it.
+ *
+ * @tparam T Value type
+ * @tparam Container Sequence container of `std::pair<T, T>` with `back()`,
+ *  `emplace_back()`, and `pop_back()`, e.g. one with preallocated storage
+ */
+template <typename T, typename Container = std::vector<std::pair<T, T>>>
+class max_stack {
+public:
+  using value_type = T;
+  using container_type = Container;
+
+  /**
+   * Push a value.
+   *
+   * @param value Value to push
+   */
+  void push(T value)
+  {
+    auto max = (values_.empty()) ?
+      value : std::max(value, values_.back().second);
+    values_.emplace_back(std::move(value), std::move(max));
+  }
+
+  /**
+   * Pop the top value, which must exist.
+   */
+  void pop()
+  {
+    check_nonempty();
+    values_.pop_back();
+  }
+
+  /**
+   * Return the top value, which must exist.
+   */
+  const T& top() const
+  {
+    check_nonempty();
+    return values_.back().first;
+  }
+
+  /**
+   * Return the max value, which must exist.
+   */
+  const T& max() const
+  {
+    check_nonempty();
+    return values_.back().second;
+  }
+
+  /**
+   * Return the number of values.
+   */
+  auto size() const noexcept
+  {
+    return values_.size();
+  }
+
+  /**
+   * Return `true` if there are no values.
+   */
+  bool empty() const noexcept
+  {
+    return values_.empty();
+  }
+
+private:
+  // each value and the max of it and all the values below it
+  Container values_;
+
+  /**
+   * Check that the stack is not empty.
+   */
+  void check_nonempty() const
+  {
+    if (values_.empty())
+      throw_error<std::out_of_range>("Stack is empty");
+  }
+};
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_MAX_STACK_HH_
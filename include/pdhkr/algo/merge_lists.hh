@@ -0,0 +1,45 @@
+/**
+ * @file algo/merge_lists.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Merge two sorted linked lists" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_MERGE_LISTS_HH_
+#define PDHKR_ALGO_MERGE_LISTS_HH_
+
+#include <algorithm>
+
+namespace pdhkr::algo {
+
+/**
+ * Merge two sorted sequences, e.g. the values of two sorted linked lists.
+ *
+ * The merge is stable, i.e. of equal values those from the first sequence
+ * come first, which matches splicing the lists in the original problem.
+ *
+ * @tparam InputIt1 Input iterator over the first sorted sequence
+ * @tparam InputIt2 Input iterator over the second sorted sequence
+ * @tparam OutputIt Output iterator for the merged sequence
+ *
+ * @param first_1 Iterator to the first value of the first sequence
+ * @param last_1 Iterator one past the last value of the first sequence
+ * @param first_2 Iterator to the first value of the second sequence
+ * @param last_2 Iterator one past the last value of the second sequence
+ * @param out Output iterator for the merged values
+ * @returns Output iterator one past the last value written
+ */
+template <typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt merge_lists(
+  InputIt1 first_1,
+  InputIt1 last_1,
+  InputIt2 first_2,
+  InputIt2 last_2,
+  OutputIt out)
+{
+  return std::merge(first_1, last_1, first_2, last_2, out);
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_MERGE_LISTS_HH_
@@ -0,0 +1,45 @@
+/**
+ * @file algo/node_from_tail.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Get Node Value" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_NODE_FROM_TAIL_HH_
+#define PDHKR_ALGO_NODE_FROM_TAIL_HH_
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Return the value at a position counted from the tail of a sequence.
+ *
+ * A leading iterator is advanced `tail_pos` values ahead, after which both
+ * iterators advance together, so forward iterators suffice.
+ *
+ * @tparam ForwardIt Forward iterator, e.g. over linked list values
+ *
+ * @param first Iterator to the head value
+ * @param last Iterator one past the tail value
+ * @param tail_pos Position from the tail, where 0 is the tail
+ */
+template <typename ForwardIt>
+auto position_from_tail(ForwardIt first, ForwardIt last, std::size_t tail_pos)
+{
+  auto lead = first;
+  for (std::size_t i = 0; i <= tail_pos; i++, ++lead)
+    if (lead == last)
+      throw_error<std::out_of_range>("Position is past the head");
+  for (; lead != last; ++lead)
+    ++first;
+  return *first;
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_NODE_FROM_TAIL_HH_
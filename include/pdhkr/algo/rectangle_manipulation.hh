@@ -0,0 +1,228 @@
+/**
+ * @file algo/rectangle_manipulation.hh
+ * @author Derek Huang
+ * @brief C++ header for the 2D extension of the "Array Manipulation" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_RECTANGLE_MANIPULATION_HH_
+#define PDHKR_ALGO_RECTANGLE_MANIPULATION_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "pdhkr/algo/segment_tree.hh"
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Number of columns of a grid tile scanned at once by the dense solver.
+ *
+ * The running column sums of a tile take 16 KiB, which fits in the L1 cache
+ * of most CPUs alongside the streamed rows.
+ */
+inline constexpr std::size_t rectangle_tile_cols = 2048U;
+
+/**
+ * Ratio of grid cells to additions past which the sparse solver is used.
+ */
+inline constexpr unsigned long long rectangle_sparse_ratio = 16U;
+
+namespace detail {
+
+/**
+ * Check that the 1-based inclusive limits of an addition are within a grid.
+ */
+inline void check_rectangle(
+  std::size_t rows,
+  std::size_t cols,
+  std::size_t r1,
+  std::size_t r2,
+  std::size_t c1,
+  std::size_t c2)
+{
+  if (r1 < 1 || r1 > r2 || r2 > rows || c1 < 1 || c1 > c2 || c2 > cols)
+    throw_error<std::out_of_range>("Invalid addition rectangle");
+}
+
+}  // namespace detail
+
+/**
+ * Return the max grid value after adding values to rectangles of a zero grid.
+ *
+ * Each addition of `k` to `[r1, r2] x [c1, c2]` is recorded in a 2D difference
+ * array at the four corners, so the grid values are the 2D prefix sums of the
+ * difference array. The prefix sums are taken one tile of columns at a time,
+ * carrying each row's running sum from one tile to the next, so the running
+ * column sums of a tile stay in cache while the rows are streamed through it.
+ * This takes O(rows * cols + m) time and memory for m additions.
+ *
+ * @tparam InputIt Input iterator over tuple-like `(r1, r2, c1, c2, k)`
+ *  additions with 1-based inclusive limits and nonnegative `k`
+ *
+ * @param rows Number of grid rows
+ * @param cols Number of grid columns
+ * @param first Iterator to the first addition
+ * @param last Iterator one past the last addition
+ */
+template <typename InputIt>
+unsigned long long rectangle_manipulation_dense(
+  std::size_t rows, std::size_t cols, InputIt first, InputIt last)
+{
+  // one extra row and column to cancel additions ending at the last ones.
+  // unsigned wraparound is fine since every prefix sum is nonnegative
+  auto stride = cols + 1;
+  std::vector<unsigned long long> diffs((rows + 1) * stride);
+  for (; first != last; ++first) {
+    const auto& op = *first;
+    auto r1 = static_cast<std::size_t>(std::get<0>(op));
+    auto r2 = static_cast<std::size_t>(std::get<1>(op));
+    auto c1 = static_cast<std::size_t>(std::get<2>(op));
+    auto c2 = static_cast<std::size_t>(std::get<3>(op));
+    auto k = static_cast<unsigned long long>(std::get<4>(op));
+    detail::check_rectangle(rows, cols, r1, r2, c1, c2);
+    diffs[(r1 - 1) * stride + c1 - 1] += k;
+    diffs[(r1 - 1) * stride + c2] -= k;
+    diffs[r2 * stride + c1 - 1] -= k;
+    diffs[r2 * stride + c2] += k;
+  }
+  // row sums left of the current tile and grid values of the previous row
+  std::vector<unsigned long long> carry(rows);
+  std::vector<unsigned long long> above(std::min(cols, rectangle_tile_cols));
+  unsigned long long max_value = 0;
+  for (std::size_t j0 = 0; j0 < cols; j0 += rectangle_tile_cols) {
+    auto j1 = std::min(j0 + rectangle_tile_cols, cols);
+    std::fill(above.begin(), above.end(), 0ULL);
+    for (std::size_t i = 0; i < rows; i++) {
+      const auto* row = diffs.data() + i * stride;
+      auto sum = carry[i];
+      for (auto j = j0; j < j1; j++) {
+        sum += row[j];
+        auto& value = above[j - j0];
+        value += sum;
+        max_value = std::max(max_value, value);
+      }
+      carry[i] = sum;
+    }
+  }
+  return max_value;
+}
+
+/**
+ * Return the max grid value after adding values to rectangles of a zero grid.
+ *
+ * A line is swept down the rows, adding each rectangle's value to its columns
+ * at its first row and removing it after its last row, and the max over the
+ * columns after each row's changes is the max of that row and the following
+ * rows until the next change. The columns are compressed to the segments
+ * between rectangle edges, held in a `range_add_max_tree`. This takes
+ * O(m log(m)) time and O(m) memory for m additions regardless of the grid
+ * size, so it handles huge sparse grids.
+ *
+ * @tparam ForwardIt Forward iterator over tuple-like `(r1, r2, c1, c2, k)`
+ *  additions with 1-based inclusive limits and nonnegative `k`
+ *
+ * @param rows Number of grid rows
+ * @param cols Number of grid columns
+ * @param first Iterator to the first addition
+ * @param last Iterator one past the last addition
+ */
+template <typename ForwardIt>
+unsigned long long rectangle_manipulation_sparse(
+  std::size_t rows, std::size_t cols, ForwardIt first, ForwardIt last)
+{
+  // value change over a range of compressed columns starting at a row
+  struct row_event {
+    std::size_t row;
+    std::size_t first;
+    std::size_t last;
+    long long delta;
+  };
+  // column edges of every rectangle plus the grid edges, so that the column
+  // segments between consecutive edges cover the grid
+  std::vector<std::size_t> edges{0, cols};
+  auto n_ops = static_cast<std::size_t>(std::distance(first, last));
+  edges.reserve(2 * n_ops + 2);
+  for (auto it = first; it != last; ++it) {
+    const auto& op = *it;
+    detail::check_rectangle(
+      rows,
+      cols,
+      static_cast<std::size_t>(std::get<0>(op)),
+      static_cast<std::size_t>(std::get<1>(op)),
+      static_cast<std::size_t>(std::get<2>(op)),
+      static_cast<std::size_t>(std::get<3>(op))
+    );
+    edges.push_back(static_cast<std::size_t>(std::get<2>(op)) - 1);
+    edges.push_back(static_cast<std::size_t>(std::get<3>(op)));
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  auto segment = [&edges](std::size_t edge)
+  {
+    return static_cast<std::size_t>(
+      std::lower_bound(edges.begin(), edges.end(), edge) - edges.begin()
+    );
+  };
+  // events sorted by row, with a rectangle's segments [a, b) for columns
+  std::vector<row_event> events;
+  events.reserve(2 * n_ops);
+  for (auto it = first; it != last; ++it) {
+    const auto& op = *it;
+    auto a = segment(static_cast<std::size_t>(std::get<2>(op)) - 1);
+    auto b = segment(static_cast<std::size_t>(std::get<3>(op)));
+    auto k = static_cast<long long>(std::get<4>(op));
+    events.push_back({static_cast<std::size_t>(std::get<0>(op)) - 1, a, b, k});
+    events.push_back({static_cast<std::size_t>(std::get<1>(op)), a, b, -k});
+  }
+  std::sort(
+    events.begin(),
+    events.end(),
+    [](const auto& x, const auto& y) { return x.row < y.row; }
+  );
+  // sweep, taking the max after all of a row's events are applied
+  range_add_max_tree<long long> values{edges.size() - 1};
+  long long max_value = 0;
+  for (std::size_t i = 0; i < events.size();) {
+    auto row = events[i].row;
+    for (; i < events.size() && events[i].row == row; i++)
+      values.add(events[i].first, events[i].last, events[i].delta);
+    if (row < rows)
+      max_value = std::max(max_value, values.max(0, values.size()));
+  }
+  return static_cast<unsigned long long>(max_value);
+}
+
+/**
+ * Return the max grid value after adding values to rectangles of a zero grid.
+ *
+ * The dense solver is used unless the grid has more than
+ * `rectangle_sparse_ratio` cells per addition, when the sparse solver is used.
+ *
+ * @tparam ForwardIt Forward iterator over tuple-like `(r1, r2, c1, c2, k)`
+ *  additions with 1-based inclusive limits and nonnegative `k`
+ *
+ * @param rows Number of grid rows
+ * @param cols Number of grid columns
+ * @param first Iterator to the first addition
+ * @param last Iterator one past the last addition
+ */
+template <typename ForwardIt>
+unsigned long long rectangle_manipulation(
+  std::size_t rows, std::size_t cols, ForwardIt first, ForwardIt last)
+{
+  auto n_ops = static_cast<unsigned long long>(std::distance(first, last));
+  auto n_cells = static_cast<unsigned long long>(rows) * cols;
+  if (n_cells / rectangle_sparse_ratio > n_ops)
+    return rectangle_manipulation_sparse(rows, cols, first, last);
+  return rectangle_manipulation_dense(rows, cols, first, last);
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_RECTANGLE_MANIPULATION_HH_
@@ -0,0 +1,97 @@
+/**
+ * @file algo/roads_and_libraries.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Roads and Libraries" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_ROADS_AND_LIBRARIES_HH_
+#define PDHKR_ALGO_ROADS_AND_LIBRARIES_HH_
+
+#include <cstddef>
+
+#include "pdhkr/algo/components.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Return the minimum cost of giving every city access to a library.
+ *
+ * If a road costs at least as much as a library, every city gets a library.
+ * Otherwise each connected component of cities gets one library and a
+ * spanning tree of roads, i.e. one less road than it has cities.
+ *
+ * @tparam Index Unsigned index type that can hold `n_cities`
+ * @tparam Acc Unsigned type that can hold the total cost
+ * @tparam InputIt Input iterator over pair-like city ID pairs
+ *
+ * @param n_cities Number of cities, with IDs from 1
+ * @param lib_cost Cost of building a library
+ * @param road_cost Cost of repairing a road
+ * @param first Iterator to the first road
+ * @param last Iterator one past the last road
+ */
+template <typename Index, typename Acc, typename InputIt>
+Acc roads_and_libraries(
+  type_tag<Index> index,
+  type_tag<Acc> /*acc*/,
+  std::size_t n_cities,
+  unsigned long long lib_cost,
+  unsigned long long road_cost,
+  InputIt first,
+  InputIt last)
+{
+  if (road_cost >= lib_cost)
+    return static_cast<Acc>(lib_cost) * n_cities;
+  Acc total = 0;
+  for (auto size : component_sizes(index, n_cities, first, last, 1U))
+    total += lib_cost + static_cast<Acc>(road_cost) * (size - 1U);
+  return total;
+}
+
+/**
+ * Return the minimum cost of giving every city access to a library.
+ *
+ * The narrowest index type for `n_cities` and accumulator for the
+ * `n_cities * lib_cost` cost bound are used.
+ *
+ * @tparam InputIt Input iterator over pair-like city ID pairs
+ *
+ * @param n_cities Number of cities, with IDs from 1
+ * @param lib_cost Cost of building a library
+ * @param road_cost Cost of repairing a road
+ * @param first Iterator to the first road
+ * @param last Iterator one past the last road
+ */
+template <typename InputIt>
+unsigned long long roads_and_libraries(
+  std::size_t n_cities,
+  unsigned long long lib_cost,
+  unsigned long long road_cost,
+  InputIt first,
+  InputIt last)
+{
+  // each city costs at most one library since roads are only used if cheaper
+  auto max_cost = static_cast<widest_uint>(n_cities) * lib_cost;
+  return dispatch_index(
+    n_cities,
+    [&](auto index)
+    {
+      return dispatch_accumulator(
+        max_cost,
+        [&](auto acc)
+        {
+          return checked_narrow<unsigned long long>(
+            roads_and_libraries(
+              index, acc, n_cities, lib_cost, road_cost, first, last
+            )
+          );
+        }
+      );
+    }
+  );
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_ROADS_AND_LIBRARIES_HH_
@@ -0,0 +1,100 @@
+/**
+ * @file algo/running_median.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Find the Running Median" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_RUNNING_MEDIAN_HH_
+#define PDHKR_ALGO_RUNNING_MEDIAN_HH_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+namespace pdhkr::algo {
+
+/**
+ * Running median of a stream of values.
+ *
+ * The lower half of the values is kept in a max-heap and the upper half in a
+ * min-heap, with the lower half holding the extra value if the count is odd.
+ * Adding a value is logarithmic instead of linear as with a sorted vector.
+ *
+ * @tparam T Arithmetic type
+ */
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+class running_median {
+public:
+  /**
+   * Add a value and return the median of all the values added so far.
+   *
+   * @param value Value to add
+   */
+  double operator()(T value)
+  {
+    if (lower_.empty() || value <= lower_.top())
+      lower_.push(value);
+    else
+      upper_.push(value);
+    // rebalance so lower_ has the same size as upper_ or one more value
+    if (lower_.size() > upper_.size() + 1) {
+      upper_.push(lower_.top());
+      lower_.pop();
+    }
+    else if (upper_.size() > lower_.size()) {
+      lower_.push(upper_.top());
+      upper_.pop();
+    }
+    return median();
+  }
+
+  /**
+   * Return the number of values added.
+   */
+  auto size() const noexcept
+  {
+    return lower_.size() + upper_.size();
+  }
+
+  /**
+   * Return the median of the values added, which must be non-empty.
+   */
+  double median() const
+  {
+    if (lower_.size() == upper_.size())
+      return 0.5 * (static_cast<double>(lower_.top()) + upper_.top());
+    return static_cast<double>(lower_.top());
+  }
+
+private:
+  std::priority_queue<T> lower_;
+  std::priority_queue<T, std::vector<T>, std::greater<T>> upper_;
+};
+
+/**
+ * Write the running median after each value of a range.
+ *
+ * @tparam InputIt Input iterator over arithmetic values
+ * @tparam OutputIt Output iterator accepting `double`
+ *
+ * @param first Iterator to the first value
+ * @param last Iterator one past the last value
+ * @param out Output iterator for the medians
+ * @returns Output iterator one past the last median written
+ */
+template <typename InputIt, typename OutputIt>
+OutputIt running_medians(InputIt first, InputIt last, OutputIt out)
+{
+  running_median<typename std::iterator_traits<InputIt>::value_type> median;
+  for (; first != last; ++first)
+    *out++ = median(*first);
+  return out;
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_RUNNING_MEDIAN_HH_
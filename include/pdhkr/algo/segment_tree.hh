@@ -0,0 +1,162 @@
+/**
+ * @file algo/segment_tree.hh
+ * @author Derek Huang
+ * @brief C++ header for a range add, range max segment tree
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_SEGMENT_TREE_HH_
+#define PDHKR_ALGO_SEGMENT_TREE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Segment tree supporting range additions and range maximum queries.
+ *
+ * Each node stores the max of its range and the total added to its whole
+ * range. Additions are never pushed down to the children, so queries only add
+ * the pending totals of the nodes on their way down. Both operations are
+ * logarithmic in the number of values.
+ *
+ * The nodes form one flat array in heap order over a power of two number of
+ * leaves, so a node's max and pending total share a cache line and the array
+ * has fewer than 4 times as many entries as there are values. Leaves past the
+ * last value are left out of their parents' maxes.
+ *
+ * @tparam T Arithmetic type
+ */
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+class range_add_max_tree {
+public:
+  /**
+   * Ctor.
+   *
+   * @param size Number of values, all initially zero
+   */
+  explicit range_add_max_tree(std::size_t size)
+    : size_{size}, leaves_{1U}
+  {
+    while (leaves_ < size_)
+      leaves_ *= 2;
+    nodes_.resize(2 * leaves_);
+  }
+
+  /**
+   * Return the number of values.
+   */
+  auto size() const noexcept
+  {
+    return size_;
+  }
+
+  /**
+   * Add a value to all the values in `[first, last)`.
+   *
+   * @param first First index
+   * @param last One past the last index
+   * @param value Value to add
+   */
+  void add(std::size_t first, std::size_t last, T value)
+  {
+    check_range(first, last);
+    add(1, 0, leaves_, first, last, value);
+  }
+
+  /**
+   * Return the max of the values in the non-empty range `[first, last)`.
+   *
+   * @param first First index
+   * @param last One past the last index
+   */
+  T max(std::size_t first, std::size_t last) const
+  {
+    check_range(first, last);
+    return max(1, 0, leaves_, first, last);
+  }
+
+private:
+  /**
+   * Max of a node's range and total added to the node's whole range.
+   */
+  struct node {
+    T max;
+    T add;
+  };
+
+  std::size_t size_;
+  std::size_t leaves_;
+  std::vector<node> nodes_;
+
+  /**
+   * Check that `[first, last)` is a non-empty range of values.
+   */
+  void check_range(std::size_t first, std::size_t last) const
+  {
+    if (first >= last || last > size_)
+      throw_error<std::out_of_range>("Invalid segment tree range");
+  }
+
+  /**
+   * Add a value to `[first, last)` within the node covering `[lo, hi)`.
+   */
+  void add(
+    std::size_t index,
+    std::size_t lo,
+    std::size_t hi,
+    std::size_t first,
+    std::size_t last,
+    T value)
+  {
+    if (last <= lo || hi <= first)
+      return;
+    auto& cur = nodes_[index];
+    if (first <= lo && hi <= last) {
+      cur.max += value;
+      cur.add += value;
+      return;
+    }
+    auto mid = lo + (hi - lo) / 2;
+    add(2 * index, lo, mid, first, last, value);
+    add(2 * index + 1, mid, hi, first, last, value);
+    // right child may only cover leaves past the last value
+    if (mid < size_)
+      cur.max = std::max(nodes_[2 * index].max, nodes_[2 * index + 1].max);
+    else
+      cur.max = nodes_[2 * index].max;
+    cur.max += cur.add;
+  }
+
+  /**
+   * Return the max of `[first, last)` within the node covering `[lo, hi)`.
+   */
+  T max(
+    std::size_t index,
+    std::size_t lo,
+    std::size_t hi,
+    std::size_t first,
+    std::size_t last) const
+  {
+    if (first <= lo && hi <= last)
+      return nodes_[index].max;
+    auto mid = lo + (hi - lo) / 2;
+    auto result = std::numeric_limits<T>::lowest();
+    if (first < mid)
+      result = max(2 * index, lo, mid, first, last);
+    if (mid < last)
+      result = std::max(result, max(2 * index + 1, mid, hi, first, last));
+    return result + nodes_[index].add;
+  }
+};
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_SEGMENT_TREE_HH_
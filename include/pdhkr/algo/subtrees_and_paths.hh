@@ -0,0 +1,215 @@
+/**
+ * @file algo/subtrees_and_paths.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Subtrees And Paths" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_SUBTREES_AND_PATHS_HH_
+#define PDHKR_ALGO_SUBTREES_AND_PATHS_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/algo/segment_tree.hh"
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Rooted tree supporting subtree additions and path maximum queries.
+ *
+ * The tree is laid out with heavy-light decomposition, where each node's
+ * largest child continues its chain and nodes are numbered in depth-first
+ * order with the heavy child visited first. Every subtree is then a range of
+ * positions and every path crosses a logarithmic number of chains, which are
+ * ranges as well, so both operations map onto a `range_add_max_tree`.
+ *
+ * @tparam T Signed arithmetic value type
+ * @tparam Index Unsigned index type that can hold the number of nodes, e.g.
+ *  chosen with `dispatch_index`, where narrower types make the per-node
+ *  arrays denser
+ */
+template <typename T = long long, typename Index = std::size_t>
+class subtree_path_tree {
+public:
+  /**
+   * Ctor.
+   *
+   * All node values are initially zero.
+   *
+   * @tparam InputIt Input iterator over pair-like node ID pairs
+   *
+   * @param n_nodes Number of nodes, with IDs from 1
+   * @param first Iterator to the first edge
+   * @param last Iterator one past the last edge
+   * @param root ID of the root node
+   */
+  template <typename InputIt>
+  subtree_path_tree(
+    std::size_t n_nodes, InputIt first, InputIt last, std::size_t root = 1U)
+    : parents_(n_nodes),
+      depths_(n_nodes),
+      heads_(n_nodes),
+      positions_(n_nodes),
+      sizes_(n_nodes, 1U),
+      values_{n_nodes}
+  {
+    if (n_nodes > std::numeric_limits<Index>::max())
+      throw_error<std::overflow_error>("Node count too large for index type");
+    // undirected edges in compressed sparse row format
+    std::vector<std::pair<Index, Index>> edges;
+    for (; first != last; ++first)
+      edges.emplace_back(
+        node_index(std::get<0>(*first)), node_index(std::get<1>(*first))
+      );
+    std::vector<std::size_t> offsets(n_nodes + 1);
+    for (const auto& [a, b] : edges) {
+      offsets[a + 1]++;
+      offsets[b + 1]++;
+    }
+    for (std::size_t i = 0; i < n_nodes; i++)
+      offsets[i + 1] += offsets[i];
+    std::vector<Index> neighbors(offsets[n_nodes]);
+    auto fill = offsets;
+    for (const auto& [a, b] : edges) {
+      neighbors[fill[a]++] = b;
+      neighbors[fill[b]++] = a;
+    }
+    if (!n_nodes)
+      return;
+    // depth-first order from the root, recording parents and depths
+    auto root_index = node_index(root);
+    std::vector<Index> order;
+    order.reserve(n_nodes);
+    std::vector<bool> visited(n_nodes);
+    std::vector<Index> stack{root_index};
+    visited[root_index] = true;
+    parents_[root_index] = root_index;
+    while (stack.size()) {
+      auto node = stack.back();
+      stack.pop_back();
+      order.push_back(node);
+      for (auto i = offsets[node]; i < offsets[node + 1]; i++) {
+        auto child = neighbors[i];
+        if (visited[child])
+          continue;
+        visited[child] = true;
+        parents_[child] = node;
+        depths_[child] = depths_[node] + 1;
+        stack.push_back(child);
+      }
+    }
+    if (order.size() != n_nodes)
+      throw_error<std::invalid_argument>("Edges do not form a tree");
+    // subtree sizes and heavy children, from the leaves up
+    std::vector<Index> heavy(n_nodes, static_cast<Index>(n_nodes));
+    for (auto it = order.rbegin(); it != order.rend(); it++) {
+      auto node = *it;
+      if (node == root_index)
+        continue;
+      auto parent = parents_[node];
+      sizes_[parent] += sizes_[node];
+      if (heavy[parent] == n_nodes || sizes_[node] > sizes_[heavy[parent]])
+        heavy[parent] = node;
+    }
+    // number nodes depth-first with the heavy child last on the stack so it
+    // is numbered right after its parent and continues the parent's chain
+    Index position = 0;
+    heads_[root_index] = root_index;
+    stack.push_back(root_index);
+    while (stack.size()) {
+      auto node = stack.back();
+      stack.pop_back();
+      positions_[node] = position++;
+      for (auto i = offsets[node]; i < offsets[node + 1]; i++) {
+        auto child = neighbors[i];
+        if (child == parents_[node] || child == heavy[node])
+          continue;
+        heads_[child] = child;
+        stack.push_back(child);
+      }
+      if (heavy[node] != n_nodes) {
+        heads_[heavy[node]] = heads_[node];
+        stack.push_back(heavy[node]);
+      }
+    }
+  }
+
+  /**
+   * Return the number of nodes.
+   */
+  auto size() const noexcept
+  {
+    return parents_.size();
+  }
+
+  /**
+   * Add a value to every node in a node's subtree.
+   *
+   * @param node Subtree root ID
+   * @param value Value to add
+   */
+  void add(std::size_t node, T value)
+  {
+    auto index = node_index(node);
+    values_.add(positions_[index], positions_[index] + sizes_[index], value);
+  }
+
+  /**
+   * Return the max node value on the path between two nodes.
+   *
+   * @param node_a First node ID
+   * @param node_b Second node ID
+   */
+  T max(std::size_t node_a, std::size_t node_b) const
+  {
+    auto a = node_index(node_a);
+    auto b = node_index(node_b);
+    auto result = std::numeric_limits<T>::lowest();
+    // climb from the deeper chain head until both nodes share a chain
+    while (heads_[a] != heads_[b]) {
+      if (depths_[heads_[a]] < depths_[heads_[b]])
+        std::swap(a, b);
+      result = std::max(
+        result, values_.max(positions_[heads_[a]], positions_[a] + 1)
+      );
+      a = parents_[heads_[a]];
+    }
+    auto [lo, hi] = std::minmax(positions_[a], positions_[b]);
+    return std::max(result, values_.max(lo, hi + 1));
+  }
+
+private:
+  std::vector<Index> parents_;
+  std::vector<Index> depths_;
+  // head of each node's chain, position in depth-first order, subtree size
+  std::vector<Index> heads_;
+  std::vector<Index> positions_;
+  std::vector<Index> sizes_;
+  range_add_max_tree<T> values_;
+
+  /**
+   * Convert a 1-based node ID to an index.
+   */
+  template <typename U>
+  Index node_index(U id) const
+  {
+    auto index = static_cast<std::size_t>(id);
+    if (index < 1 || index > parents_.size())
+      throw_error<std::out_of_range>(
+        "Node ID " + std::to_string(index) + " out of range"
+      );
+    return static_cast<Index>(index - 1);
+  }
+};
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_SUBTREES_AND_PATHS_HH_
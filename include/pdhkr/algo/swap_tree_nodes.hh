@@ -0,0 +1,139 @@
+/**
+ * @file algo/swap_tree_nodes.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Swap Nodes [Algo]" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_SWAP_TREE_NODES_HH_
+#define PDHKR_ALGO_SWAP_TREE_NODES_HH_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr::algo {
+
+/**
+ * Binary tree of node IDs whose subtrees can be swapped by depth.
+ *
+ * Swapping never changes node depths, so the nodes are grouped by depth once
+ * and each swap only touches the nodes at the depths being swapped.
+ */
+class swap_tree {
+public:
+  /**
+   * Ctor.
+   *
+   * Node `i`, counting from 1, has the children given by the `i`th pair.
+   * Node 1 is the root and nonpositive child IDs mean there is no child.
+   *
+   * @tparam InputIt Input iterator over pair-like child ID pairs
+   *
+   * @param first Iterator to the first node's children
+   * @param last Iterator one past the last node's children
+   */
+  template <typename InputIt>
+  swap_tree(InputIt first, InputIt last)
+  {
+    // node 0 is the null node
+    left_.push_back(0);
+    right_.push_back(0);
+    for (; first != last; ++first) {
+      left_.push_back(child_id(std::get<0>(*first)));
+      right_.push_back(child_id(std::get<1>(*first)));
+    }
+    for (std::size_t i = 1; i < left_.size(); i++)
+      if (left_[i] >= left_.size() || right_[i] >= left_.size())
+        throw_error<std::out_of_range>(
+          "Child of node " + std::to_string(i) + " out of range"
+        );
+    if (left_.size() == 1)
+      return;
+    // group by depth breadth-first, with the root at depth 1
+    levels_.push_back({1});
+    while (true) {
+      std::vector<std::size_t> next;
+      for (auto node : levels_.back()) {
+        if (left_[node])
+          next.push_back(left_[node]);
+        if (right_[node])
+          next.push_back(right_[node]);
+      }
+      if (next.empty())
+        break;
+      levels_.push_back(std::move(next));
+    }
+  }
+
+  /**
+   * Return the number of nodes.
+   */
+  std::size_t size() const noexcept
+  {
+    return left_.size() - 1;
+  }
+
+  /**
+   * Swap the subtrees of all nodes at depths that are multiples of `k`.
+   *
+   * @param k Depth multiple, where the root is at depth 1
+   */
+  void swap_depths(std::size_t k)
+  {
+    if (!k)
+      throw_error<std::invalid_argument>("Swap depth must be positive");
+    for (auto depth = k; depth <= levels_.size(); depth += k)
+      for (auto node : levels_[depth - 1])
+        std::swap(left_[node], right_[node]);
+  }
+
+  /**
+   * Write the node IDs in order.
+   *
+   * @tparam OutputIt Output iterator accepting `std::size_t`
+   *
+   * @param out Output iterator for the node IDs
+   * @returns Output iterator one past the last node ID written
+   */
+  template <typename OutputIt>
+  OutputIt inorder(OutputIt out) const
+  {
+    std::vector<std::size_t> stack;
+    auto node = (size()) ? std::size_t{1} : std::size_t{0};
+    while (node || stack.size()) {
+      for (; node; node = left_[node])
+        stack.push_back(node);
+      node = stack.back();
+      stack.pop_back();
+      *out++ = node;
+      node = right_[node];
+    }
+    return out;
+  }
+
+private:
+  // left and right child IDs, 0 if none
+  std::vector<std::size_t> left_;
+  std::vector<std::size_t> right_;
+  // node IDs at each depth
+  std::vector<std::vector<std::size_t>> levels_;
+
+  /**
+   * Convert a child ID to the stored ID, 0 for no child.
+   */
+  template <typename T>
+  static std::size_t child_id(T id) noexcept
+  {
+    return (id > 0) ? static_cast<std::size_t>(id) : 0U;
+  }
+};
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_SWAP_TREE_NODES_HH_
@@ -0,0 +1,67 @@
+/**
+ * @file algo/two_stack_game.hh
+ * @author Derek Huang
+ * @brief C++ header for the "Game of Two Stacks" algorithm
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ALGO_TWO_STACK_GAME_HH_
+#define PDHKR_ALGO_TWO_STACK_GAME_HH_
+
+#include <algorithm>
+#include <cstddef>
+
+#include "pdhkr/features.h"
+
+namespace pdhkr::algo {
+
+/**
+ * Return max number of values removed from two stacks for a sum limit.
+ *
+ * As many values as possible are first taken from stack A. Then each value
+ * taken from stack B puts back values from stack A until the sum is within
+ * the limit again, with the max total count taken along the way.
+ *
+ * @tparam BidirIt Bidirectional iterator over stack A, top first
+ * @tparam InputIt Input iterator over stack B, top first
+ *
+ * @param a_first Iterator to the top of stack A
+ * @param a_last Iterator one past the bottom of stack A
+ * @param b_first Iterator to the top of stack B
+ * @param b_last Iterator one past the bottom of stack B
+ * @param max_sum Maximum sum of the removed values
+ */
+template <typename BidirIt, typename InputIt>
+PDHKR_CONSTEXPR20 std::size_t max_game_score(
+  BidirIt a_first,
+  BidirIt a_last,
+  InputIt b_first,
+  InputIt b_last,
+  unsigned long long max_sum)
+{
+  // take as many values from stack A as possible
+  unsigned long long sum = 0;
+  std::size_t n_a = 0;
+  auto a_it = a_first;
+  for (; a_it != a_last && sum + *a_it <= max_sum; ++a_it, n_a++)
+    sum += *a_it;
+  auto max_score = n_a;
+  // take from stack B, putting back from stack A until within the limit
+  std::size_t n_b = 0;
+  for (; b_first != b_last; ++b_first) {
+    sum += *b_first;
+    n_b++;
+    while (sum > max_sum && a_it != a_first) {
+      sum -= *--a_it;
+      n_a--;
+    }
+    if (sum > max_sum)
+      break;
+    max_score = std::max(max_score, n_a + n_b);
+  }
+  return max_score;
+}
+
+}  // namespace pdhkr::algo
+
+#endif  // PDHKR_ALGO_TWO_STACK_GAME_HH_
@@ -0,0 +1,215 @@
+/**
+ * @file arena.hh
+ * @author Derek Huang
+ * @brief C++ header for a per-run arena used as the default memory resource
+ * @copyright MIT License
+ *
+ * Including this header installs `arena_resource::instance()` as the default
+ * `std::pmr` memory resource before `main()` runs, so every default-constructed
+ * `std::pmr` container allocates from the arena. Classes allocated one object
+ * at a time, e.g. linked list or tree nodes owned by `std::unique_ptr`, can
+ * opt in with `PDHKR_ARENA_OPERATORS`. Deallocation is a no-op, and all the
+ * arena memory is released at once when the program exits.
+ */
+
+#ifndef PDHKR_ARENA_HH_
+#define PDHKR_ARENA_HH_
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "pdhkr/features.h"
+
+// POSIX memory mapping for huge page upstream resource
+#if defined(PDHKR_ARENA_HUGE_PAGES) && !defined(_WIN32)
+#include <sys/mman.h>
+#endif  // !defined(PDHKR_ARENA_HUGE_PAGES) || defined(_WIN32)
+
+namespace pdhkr {
+
+#if defined(PDHKR_ARENA_HUGE_PAGES) && !defined(_WIN32)
+/**
+ * Memory resource allocating anonymous memory maps backed by huge pages.
+ *
+ * Requests are rounded up to a multiple of the 2 MiB huge page size and the
+ * kernel is asked to back the mappings with transparent huge pages, which
+ * cuts TLB misses when a large arena is traversed. This is only meant as the
+ * upstream of a `std::pmr::monotonic_buffer_resource`, which makes few large
+ * requests.
+ */
+class huge_page_resource : public std::pmr::memory_resource {
+public:
+  /**
+   * Huge page size.
+   */
+  static constexpr std::size_t page_size = 1U << 21;
+
+private:
+  /**
+   * Round a size up to a multiple of the huge page size.
+   */
+  static std::size_t round_size(std::size_t bytes) noexcept
+  {
+    return (bytes + page_size - 1) / page_size * page_size;
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t /*alignment*/) override
+  {
+    auto size = round_size(bytes);
+    auto mapping = ::mmap(
+      nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+    if (mapping == MAP_FAILED) {
+#if PDHKR_HAS_EXCEPTIONS
+      throw std::bad_alloc{};
+#else
+      std::abort();
+#endif  // !PDHKR_HAS_EXCEPTIONS
+    }
+#ifdef MADV_HUGEPAGE
+    ::madvise(mapping, size, MADV_HUGEPAGE);
+#endif  // MADV_HUGEPAGE
+    return mapping;
+  }
+
+  void do_deallocate(
+    void* p, std::size_t bytes, std::size_t /*alignment*/) override
+  {
+    ::munmap(p, round_size(bytes));
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+    noexcept override
+  {
+    return this == &other;
+  }
+};
+#endif  // !defined(PDHKR_ARENA_HUGE_PAGES) || defined(_WIN32)
+
+/**
+ * Per-run arena memory resource.
+ *
+ * Each thread allocates from its own `std::pmr::monotonic_buffer_resource`,
+ * so no locking is needed after a thread's first allocation and memory may be
+ * freed from any thread. The buffers are kept until the arena is destroyed
+ * at program exit, even if their threads exit before then.
+ *
+ * If `PDHKR_ARENA_HUGE_PAGES` is defined, on POSIX systems the buffers get
+ * their memory from `huge_page_resource`, otherwise from the global heap.
+ */
+class arena_resource : public std::pmr::memory_resource {
+public:
+  /**
+   * Initial size of each thread's buffer.
+   */
+  static constexpr std::size_t initial_size = 1U << 20;
+
+  /**
+   * Return the arena.
+   */
+  static arena_resource& instance()
+  {
+    static arena_resource arena;
+    return arena;
+  }
+
+  arena_resource(const arena_resource&) = delete;
+  arena_resource& operator=(const arena_resource&) = delete;
+
+  /**
+   * Dtor.
+   *
+   * Restores the global heap as the default resource and releases all the
+   * buffers, in one go per buffer.
+   */
+  ~arena_resource()
+  {
+    if (std::pmr::get_default_resource() == this)
+      std::pmr::set_default_resource(std::pmr::new_delete_resource());
+  }
+
+private:
+#if defined(PDHKR_ARENA_HUGE_PAGES) && !defined(_WIN32)
+  huge_page_resource upstream_;
+#endif  // !defined(PDHKR_ARENA_HUGE_PAGES) || defined(_WIN32)
+  // guards buffers_ when a thread first allocates
+  std::mutex buffers_mut_;
+  std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> buffers_;
+
+  arena_resource() = default;
+
+  /**
+   * Return the upstream resource of the per-thread buffers.
+   */
+  std::pmr::memory_resource* upstream() noexcept
+  {
+#if defined(PDHKR_ARENA_HUGE_PAGES) && !defined(_WIN32)
+    return &upstream_;
+#else
+    return std::pmr::new_delete_resource();
+#endif  // !defined(PDHKR_ARENA_HUGE_PAGES) || defined(_WIN32)
+  }
+
+  /**
+   * Return the calling thread's buffer, creating it on first use.
+   */
+  std::pmr::monotonic_buffer_resource& local_buffer()
+  {
+    thread_local std::pmr::monotonic_buffer_resource* buffer = nullptr;
+    if (!buffer) {
+      std::lock_guard lock{buffers_mut_};
+      buffers_.push_back(
+        std::make_unique<std::pmr::monotonic_buffer_resource>(
+          initial_size, upstream()
+        )
+      );
+      buffer = buffers_.back().get();
+    }
+    return *buffer;
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    return local_buffer().allocate(bytes, alignment);
+  }
+
+  void do_deallocate(
+    void* /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override
+  {}
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+    noexcept override
+  {
+    return this == &other;
+  }
+};
+
+/**
+ * Install the arena as the default memory resource during static init.
+ */
+inline const bool arena_installed = []
+{
+  std::pmr::set_default_resource(&arena_resource::instance());
+  return true;
+}();
+
+}  // namespace pdhkr
+
+/**
+ * Class-specific allocation functions allocating objects from the arena.
+ *
+ * Expand in the public section of a class definition.
+ */
+#define PDHKR_ARENA_OPERATORS \
+  static void* operator new(std::size_t size) \
+  { \
+    return pdhkr::arena_resource::instance().allocate(size); \
+  } \
+  static void operator delete(void* /*p*/) noexcept {}
+
+#endif  // PDHKR_ARENA_HH_
@@ -0,0 +1,38 @@
+/**
+ * @file arena_std.hh
+ * @author Derek Huang
+ * @brief C++ header selecting the standard containers used by the programs
+ * @copyright MIT License
+ *
+ * The programs name their containers through the `pdhkr::arena_std` namespace
+ * alias. If `PDHKR_USE_ARENA` is defined, this includes `pdhkr/arena.hh` and
+ * makes `arena_std` an alias for `std::pmr`, so the containers allocate from
+ * the per-run arena. Otherwise `arena_std` is an alias for `std` and
+ * `PDHKR_ARENA_OPERATORS` expands to nothing, so node classes keep using the
+ * global heap. The submissions define both as the latter when built without
+ * `PDHKR_TEST` or `PDHKR_LOCAL`, so the HackerRank builds do not include this
+ * header.
+ */
+
+#ifndef PDHKR_ARENA_STD_HH_
+#define PDHKR_ARENA_STD_HH_
+
+#if defined(PDHKR_USE_ARENA)
+#include <memory_resource>
+
+#include "pdhkr/arena.hh"
+#else
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_USE_ARENA)
+
+namespace pdhkr {
+
+#if defined(PDHKR_USE_ARENA)
+namespace arena_std = std::pmr;
+#else
+namespace arena_std = std;
+#endif  // !defined(PDHKR_USE_ARENA)
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_ARENA_STD_HH_
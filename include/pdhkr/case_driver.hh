@@ -0,0 +1,218 @@
+/**
+ * @file case_driver.hh
+ * @author Derek Huang
+ * @brief C++ header for solving independent test cases in parallel
+ * @copyright MIT License
+ *
+ * Many HackerRank problems give a number of independent cases, e.g. queries
+ * or games, that are read and solved one after another. `solve_cases` reads
+ * cases ahead on the calling thread, solves them on worker threads, and writes
+ * the results on the calling thread in input order through a bounded reorder
+ * buffer, so the output is identical to that of the serial loop.
+ */
+
+#ifndef PDHKR_CASE_DRIVER_HH_
+#define PDHKR_CASE_DRIVER_HH_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/features.h"
+#include "pdhkr/thread.hh"
+
+namespace pdhkr {
+
+/**
+ * Read, solve, and write independent cases, solving in parallel.
+ *
+ * Cases are read on the calling thread and handed to `n_threads` worker
+ * threads through a reorder buffer holding at most `4 * n_threads` cases that
+ * have been read but not yet written. Results are written on the calling
+ * thread strictly in the order the cases were read, as soon as they are
+ * available, so the reader only blocks when the reorder buffer is full.
+ *
+ * If `n_threads` is 1 or there is only one case, no threads are started and
+ * each case is read, solved, and written in turn on the calling thread.
+ *
+ * If `read`, `solve`, or `write` throws, no further cases are read, solved, or
+ * written, the worker threads are joined, and the first exception thrown is
+ * rethrown on the calling thread.
+ *
+ * @tparam Reader Callable with signature `Input()` reading the next case
+ * @tparam Solver Callable with signature `Output(Input&)` solving a case
+ * @tparam Writer Callable with signature `void(Output&)` writing a result
+ *
+ * @param n_cases Number of cases to read
+ * @param read Case reader
+ * @param solve Case solver. Must be safe to call concurrently
+ * @param write Result writer
+ * @param n_threads Number of worker threads, by default `thread_count()`
+ */
+template <typename Reader, typename Solver, typename Writer>
+void solve_cases(
+  std::size_t n_cases,
+  Reader&& read,
+  Solver&& solve,
+  Writer&& write,
+  unsigned int n_threads = thread_count())
+{
+  using input_type = std::decay_t<std::invoke_result_t<Reader&>>;
+  using output_type = std::decay_t<
+    std::invoke_result_t<Solver&, input_type&>
+  >;
+  // serial fallback
+  if (n_threads <= 1 || n_cases <= 1) {
+    for (decltype(n_cases) i = 0; i < n_cases; i++) {
+      auto input = read();
+      auto output = solve(input);
+      write(output);
+    }
+    return;
+  }
+  // no point in having more workers than cases
+  n_threads = static_cast<unsigned int>(
+    std::min(static_cast<std::size_t>(n_threads), n_cases)
+  );
+  // reorder buffer slot. case i uses slot i % n_slots and the slot is only
+  // reused once case i has been written, so a slot is never shared
+  struct slot {
+    std::optional<input_type> input;
+    std::optional<output_type> output;
+  };
+  std::vector<slot> slots(4 * n_threads);
+  auto n_slots = slots.size();
+  // guards the slots and counters. solve() and write() are called unlocked
+  std::mutex mut;
+  // signals workers that a case was read, reader that a case was solved
+  std::condition_variable read_cv;
+  std::condition_variable solved_cv;
+  // number of cases read, claimed by workers, and written
+  std::size_t n_read = 0;
+  std::size_t n_claimed = 0;
+  std::size_t n_written = 0;
+  // set when a read, solve, or write fails so the pipeline stops early
+  bool stopped = false;
+#if PDHKR_HAS_EXCEPTIONS
+  // first exception thrown, rethrown on the calling thread once joined
+  std::exception_ptr error;
+  // stop the pipeline from a catch block, waking all waiting threads
+  auto stop = [&]
+  {
+    {
+      std::lock_guard lock{mut};
+      if (!error)
+        error = std::current_exception();
+      stopped = true;
+    }
+    read_cv.notify_all();
+    solved_cv.notify_all();
+  };
+#endif  // PDHKR_HAS_EXCEPTIONS
+  // worker loop: claim next case in input order, solve, store result
+  auto solve_loop = [&]
+  {
+    while (true) {
+      std::unique_lock lock{mut};
+      read_cv.wait(
+        lock,
+        [&] { return stopped || n_claimed < n_read || n_claimed == n_cases; }
+      );
+      if (stopped || n_claimed == n_cases)
+        return;
+      auto& cur = slots[n_claimed++ % n_slots];
+      auto input = std::move(*cur.input);
+      cur.input.reset();
+      lock.unlock();
+      auto output = solve(input);
+      lock.lock();
+      cur.output.emplace(std::move(output));
+      solved_cv.notify_one();
+    }
+  };
+  // run a loop, stopping the pipeline instead of propagating exceptions
+  auto guarded = [&](auto&& loop)
+  {
+#if PDHKR_HAS_EXCEPTIONS
+    try {
+      loop();
+    }
+    catch (...) {
+      stop();
+    }
+#else
+    loop();
+#endif  // !PDHKR_HAS_EXCEPTIONS
+  };
+  std::vector<std::thread> workers;
+  // write the next result in input order. if wait is false, returns false
+  // without writing if the result is not yet available. returns false if the
+  // pipeline was stopped
+  auto write_next = [&](bool wait)
+  {
+    std::unique_lock lock{mut};
+    auto& cur = slots[n_written % n_slots];
+    if (wait)
+      solved_cv.wait(
+        lock,
+        [&] { return stopped || cur.output.has_value(); }
+      );
+    if (stopped || !cur.output)
+      return false;
+    auto output = std::move(*cur.output);
+    cur.output.reset();
+    lock.unlock();
+    write(output);
+    // only the calling thread modifies n_written
+    n_written++;
+    return true;
+  };
+  // start workers, read cases, and write results along the way
+  auto drive_loop = [&]
+  {
+    workers.reserve(n_threads);
+    for (decltype(n_threads) i = 0; i < n_threads; i++)
+      workers.emplace_back([&] { guarded(solve_loop); });
+    for (decltype(n_cases) i = 0; i < n_cases; i++) {
+      // reorder buffer full, so block on the oldest unwritten result
+      if (i - n_written == n_slots && !write_next(true))
+        return;
+      // read without holding the lock
+      auto input = read();
+      {
+        std::lock_guard lock{mut};
+        if (stopped)
+          return;
+        slots[i % n_slots].input.emplace(std::move(input));
+        n_read++;
+      }
+      read_cv.notify_one();
+      // write results that are ready without blocking
+      while (n_written < n_read && write_next(false));
+    }
+    // wake idle workers so they can exit, then write remaining results
+    read_cv.notify_all();
+    while (n_written < n_cases)
+      if (!write_next(true))
+        return;
+  };
+  guarded(drive_loop);
+  // on failure, stopped workers exit after finishing their current case
+  for (auto& worker : workers)
+    worker.join();
+#if PDHKR_HAS_EXCEPTIONS
+  if (error)
+    std::rethrow_exception(error);
+#endif  // PDHKR_HAS_EXCEPTIONS
+}
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_CASE_DRIVER_HH_
@@ -22,6 +22,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "pdhkr/error.hh"
 #include "pdhkr/string.hh"
 #include "pdhkr/type_traits.hh"
 
@@ -341,10 +342,10 @@ T to_number(const std::string& str, int base = 0)
     auto val = std::stoull(str, nullptr, base);
     // error if exceeds limits of specified type
     if (val > std::numeric_limits<T>::max())
-      throw std::overflow_error{
+      throw_error<std::overflow_error>(
         "Value above unsigned type maximum " +
         std::to_string(static_cast<decltype(val)>(std::numeric_limits<T>::max()))
-      };
+      );
     return static_cast<T>(val);
   }
   // unknown, assumed signed integral type
@@ -352,15 +353,15 @@ T to_number(const std::string& str, int base = 0)
     auto val = std::stoll(str, nullptr, base);
     // error if exceeds limits of specified type
     if (val < std::numeric_limits<T>::min())
-      throw std::overflow_error{
+      throw_error<std::overflow_error>(
         "Value below signed type minimum " +
         std::to_string(static_cast<decltype(val)>(std::numeric_limits<T>::min()))
-      };
+      );
     if (val > std::numeric_limits<T>::max())
-      throw std::overflow_error{
+      throw_error<std::overflow_error>(
         "Value above signed type maximum " +
         std::to_string(static_cast<decltype(val)>(std::numeric_limits<T>::max()))
-      };
+      );
     return static_cast<T>(val);
   }
 }
@@ -388,15 +389,15 @@ T to_number(const std::string& str)
     auto val = std::stold(str);
     // error if exceeds limits of specified type
     if (val < std::numeric_limits<T>::lowest())
-      throw std::overflow_error{
+      throw_error<std::overflow_error>(
         "Value below floating type minimum " +
         std::to_string(static_cast<decltype(val)>(std::numeric_limits<T>::lowest()))
-      };
+      );
     if (val > std::numeric_limits<T>::max())
-      throw std::overflow_error{
+      throw_error<std::overflow_error>(
         "Value below floating type maximum " +
         std::to_string(static_cast<decltype(val)>(std::numeric_limits<T>::max()))
-      };
+      );
     return static_cast<T>(val);
   }
 }
@@ -0,0 +1,143 @@
+/**
+ * @file constraints.hh
+ * @author Derek Huang
+ * @brief C++ header for the declared HackerRank problem constraints
+ * @copyright MIT License
+ *
+ * Each problem's input constraints as stated on HackerRank, used to size
+ * preallocated containers, e.g. `pdhkr::static_vector`, so that the hot
+ * containers never reallocate on valid inputs. Inputs past these bounds, e.g.
+ * stress inputs, must still work, just without the preallocation benefit.
+ * The solver server is the exception, rejecting sizes past these bounds so
+ * that a single request cannot make it allocate without limit.
+ */
+
+#ifndef PDHKR_CONSTRAINTS_HH_
+#define PDHKR_CONSTRAINTS_HH_
+
+#include <cstddef>
+
+namespace pdhkr::constraints {
+
+/**
+ * "Array Manipulation" constraints.
+ */
+struct array_manipulation {
+  static constexpr std::size_t max_size = 10'000'000;
+  static constexpr std::size_t max_ops = 200'000;
+  static constexpr unsigned long long max_summand = 1'000'000'000;
+};
+
+/**
+ * "Equal Stacks" constraints.
+ */
+struct equal_stacks {
+  static constexpr std::size_t max_height = 100'000;
+  static constexpr unsigned int max_value = 100;
+};
+
+/**
+ * "Jesse and Cookies" constraints.
+ */
+struct jesse_and_cookies {
+  static constexpr std::size_t max_cookies = 1'000'000;
+  static constexpr unsigned long long max_target = 1'000'000'000;
+  static constexpr unsigned int max_sweetness = 1'000'000;
+};
+
+/**
+ * "Journey to the Moon" constraints.
+ */
+struct journey_to_moon {
+  static constexpr std::size_t max_astronauts = 100'000;
+  static constexpr std::size_t max_pairs = 10'000;
+};
+
+/**
+ * "Maximum Element" constraints.
+ */
+struct max_stack_element {
+  static constexpr std::size_t max_queries = 100'000;
+  static constexpr unsigned int max_value = 1'000'000'000;
+};
+
+/**
+ * "Merge two sorted linked lists" constraints.
+ */
+struct merge_sorted_linked_lists {
+  static constexpr std::size_t max_cases = 10;
+  static constexpr std::size_t max_length = 1'000;
+  static constexpr unsigned int max_value = 1'000;
+};
+
+/**
+ * "Get Node Value" constraints.
+ */
+struct node_from_tail {
+  static constexpr std::size_t max_cases = 10;
+  static constexpr std::size_t max_length = 1'000;
+  static constexpr unsigned int max_value = 1'000;
+};
+
+/**
+ * "Roads and Libraries" constraints.
+ */
+struct roads_and_libraries {
+  static constexpr std::size_t max_queries = 10;
+  static constexpr std::size_t max_cities = 100'000;
+  static constexpr std::size_t max_roads = 100'000;
+  static constexpr unsigned long long max_cost = 100'000;
+};
+
+/**
+ * "Find the Running Median" constraints.
+ */
+struct running_median {
+  static constexpr std::size_t max_values = 100'000;
+  static constexpr unsigned int max_value = 100'000;
+};
+
+/**
+ * "Subtrees And Paths" constraints.
+ */
+struct subtrees_and_paths {
+  static constexpr std::size_t max_nodes = 100'000;
+  static constexpr std::size_t max_queries = 100'000;
+  static constexpr long long max_abs_value = 10'000;
+};
+
+/**
+ * "Swap Nodes [Algo]" constraints.
+ */
+struct swap_tree_nodes {
+  static constexpr std::size_t max_nodes = 1'024;
+  static constexpr std::size_t max_queries = 100;
+};
+
+/**
+ * "Tree: Level Order Traversal" constraints.
+ */
+struct tree_level_order {
+  static constexpr std::size_t max_nodes = 500;
+};
+
+/**
+ * "Tree: Top View" constraints.
+ */
+struct tree_top_view {
+  static constexpr std::size_t max_nodes = 500;
+};
+
+/**
+ * "Game of Two Stacks" constraints.
+ */
+struct two_stack_game {
+  static constexpr std::size_t max_games = 50;
+  static constexpr std::size_t max_height = 100'000;
+  static constexpr unsigned int max_value = 1'000'000;
+  static constexpr unsigned long long max_sum = 1'000'000'000;
+};
+
+}  // namespace pdhkr::constraints
+
+#endif  // PDHKR_CONSTRAINTS_HH_
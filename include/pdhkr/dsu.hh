@@ -0,0 +1,192 @@
+/**
+ * @file dsu.hh
+ * @author Derek Huang
+ * @brief C++ header for a disjoint-set union structure
+ * @copyright MIT License
+ *
+ * `disjoint_sets<Index>` tracks the connected components of an undirected
+ * graph as its edges arrive, so problems that only need component sizes can
+ * union each edge as it is parsed instead of storing an edge list and
+ * searching an adjacency structure. The component count and the number of
+ * node pairs in different components are updated with each union, so answers
+ * depending only on these, e.g. the cost of a library per component and a
+ * road per spanning forest edge, or the number of pairs of astronauts from
+ * different countries, are available in O(1) after every edge.
+ */
+
+#ifndef PDHKR_DSU_HH_
+#define PDHKR_DSU_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr {
+
+/**
+ * Union-find forest over nodes `0` through `n_nodes() - 1`.
+ *
+ * Trees are joined by size, with the smaller tree under the larger one, and
+ * paths are halved during each find, so any sequence of operations takes
+ * near-linear time. Node indices passed to the members are not checked,
+ * except by `unite_ids()`, which takes node IDs straight from the input.
+ *
+ * @tparam Index Unsigned type that can hold the node count
+ */
+template <typename Index = std::uint32_t>
+class disjoint_sets {
+public:
+  using index_type = Index;
+
+  /**
+   * Default ctor.
+   *
+   * Creates an empty forest with no nodes.
+   */
+  disjoint_sets() = default;
+
+  /**
+   * Ctor.
+   *
+   * @param n_nodes Number of nodes, each initially its own component
+   */
+  explicit disjoint_sets(std::size_t n_nodes)
+    : parents_(n_nodes), sizes_(n_nodes, 1U), n_components_{n_nodes}
+  {
+    if (n_nodes > std::numeric_limits<Index>::max())
+      throw_error<std::overflow_error>("Node count too large for index type");
+    std::iota(parents_.begin(), parents_.end(), Index{});
+  }
+
+  /**
+   * Return the number of nodes.
+   */
+  std::size_t n_nodes() const noexcept { return parents_.size(); }
+
+  /**
+   * Return the number of connected components.
+   */
+  std::size_t n_components() const noexcept { return n_components_; }
+
+  /**
+   * Return the number of edges in a spanning forest of the components.
+   *
+   * Each component of `k` nodes is spanned by a tree of `k - 1` edges.
+   */
+  std::size_t n_forest_edges() const noexcept
+  {
+    return n_nodes() - n_components_;
+  }
+
+  /**
+   * Return the number of node pairs in the same component.
+   */
+  auto n_linked_pairs() const noexcept { return n_linked_pairs_; }
+
+  /**
+   * Return the number of node pairs in different components.
+   */
+  unsigned long long n_separate_pairs() const noexcept
+  {
+    auto n = static_cast<unsigned long long>(n_nodes());
+    return ((n) ? n * (n - 1) / 2 : n) - n_linked_pairs_;
+  }
+
+  /**
+   * Return the root node of a node's component, halving the path to it.
+   */
+  Index find(Index node) noexcept
+  {
+    while (parents_[node] != node) {
+      parents_[node] = parents_[parents_[node]];
+      node = parents_[node];
+    }
+    return node;
+  }
+
+  /**
+   * Return the number of nodes in a node's component.
+   */
+  Index size(Index node) noexcept { return sizes_[find(node)]; }
+
+  /**
+   * Join the components of the end nodes of an edge.
+   *
+   * @returns `true` if the nodes were in different components
+   */
+  bool unite(Index a, Index b) noexcept
+  {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+      return false;
+    if (sizes_[a] < sizes_[b])
+      std::swap(a, b);
+    // every node of one component now pairs with every node of the other
+    n_linked_pairs_ += static_cast<unsigned long long>(sizes_[a]) * sizes_[b];
+    parents_[b] = a;
+    sizes_[a] += sizes_[b];
+    n_components_--;
+    return true;
+  }
+
+  /**
+   * Join the components of the end nodes of an edge given by node IDs.
+   *
+   * @tparam T Integral node ID type
+   *
+   * @param a First node ID
+   * @param b Second node ID
+   * @param base ID of the first node, e.g. 1 for 1-indexed node IDs
+   * @returns `true` if the nodes were in different components
+   */
+  template <typename T>
+  bool unite_ids(T a, T b, std::size_t base = 0)
+  {
+    return unite(node_index(a, base), node_index(b, base));
+  }
+
+  /**
+   * Return the size of each component, in the order of their root nodes.
+   */
+  std::vector<Index> component_sizes() const
+  {
+    std::vector<Index> sizes;
+    sizes.reserve(n_components_);
+    for (std::size_t i = 0; i < parents_.size(); i++)
+      if (parents_[i] == i)
+        sizes.push_back(sizes_[i]);
+    return sizes;
+  }
+
+private:
+  std::vector<Index> parents_;
+  std::vector<Index> sizes_;
+  std::size_t n_components_{};
+  unsigned long long n_linked_pairs_{};
+
+  /**
+   * Convert a node ID to a 0-based node index, checking its range.
+   */
+  template <typename T>
+  Index node_index(T id, std::size_t base) const
+  {
+    auto index = static_cast<std::size_t>(id);
+    if (index < base || index - base >= n_nodes())
+      throw_error<std::out_of_range>(
+        "Node ID " + std::to_string(index) + " out of range"
+      );
+    return static_cast<Index>(index - base);
+  }
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_DSU_HH_
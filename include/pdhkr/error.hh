@@ -0,0 +1,46 @@
+/**
+ * @file error.hh
+ * @author Derek Huang
+ * @brief C++ header for error reporting helpers
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_ERROR_HH_
+#define PDHKR_ERROR_HH_
+
+#include <string>
+
+#include "pdhkr/features.h"
+
+#if !PDHKR_HAS_EXCEPTIONS
+#include <cstdlib>
+#include <iostream>
+#endif  // PDHKR_HAS_EXCEPTIONS
+
+namespace pdhkr {
+
+/**
+ * Throw an exception with the given message.
+ *
+ * If compiled without exception support, e.g. with `-fno-exceptions`, the
+ * message is instead written to `std::cerr` and the program is aborted. This
+ * allows headers that report errors to be used in such programs.
+ *
+ * @tparam E Exception type constructible from a `std::string`
+ *
+ * @param message Error message
+ */
+template <typename E>
+[[noreturn]] void throw_error(const std::string& message)
+{
+#if PDHKR_HAS_EXCEPTIONS
+  throw E{message};
+#else
+  std::cerr << "Error: " << message << std::endl;
+  std::abort();
+#endif  // !PDHKR_HAS_EXCEPTIONS
+}
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_ERROR_HH_
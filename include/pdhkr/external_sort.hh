@@ -0,0 +1,336 @@
+/**
+ * @file external_sort.hh
+ * @author Derek Huang
+ * @brief C++ header for sorting more records than fit in memory
+ * @copyright MIT License
+ *
+ * `external_sorter` buffers pushed records up to a memory budget, spilling
+ * each full buffer as a sorted run to a temporary file, and then visits all
+ * the records in sorted order with a k-way merge of the runs. If the runs
+ * cannot all be merged at once within the budget, groups of runs are first
+ * merged into longer runs. Inputs that fit in the budget never touch disk.
+ */
+
+#ifndef PDHKR_EXTERNAL_SORT_HH_
+#define PDHKR_EXTERNAL_SORT_HH_
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr {
+
+/**
+ * Default memory budget in bytes for out-of-core algorithms.
+ */
+inline constexpr std::size_t default_memory_budget = 64U << 20;
+
+/**
+ * Return the memory budget in bytes for out-of-core algorithms.
+ *
+ * This is the value of the `PDHKR_MEMORY_BUDGET` environment variable if it is
+ * set to a positive number of bytes, optionally suffixed with `k`, `m`, or `g`
+ * for KiB, MiB, or GiB, e.g. `512m`, otherwise `default_memory_budget`.
+ */
+inline std::size_t memory_budget()
+{
+  // note: MSVC warns that std::getenv is unsafe (C4996)
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4996)
+#endif  // _MSC_VER
+  auto env_value = std::getenv("PDHKR_MEMORY_BUDGET");
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif  // _MSC_VER
+  if (!env_value)
+    return default_memory_budget;
+  // ignore unparseable or non-positive values
+  char* suffix;
+  auto budget = std::strtoull(env_value, &suffix, 10);
+  if (!budget)
+    return default_memory_budget;
+  switch (std::tolower(static_cast<unsigned char>(*suffix))) {
+    case '\0':
+      break;
+    case 'k':
+      budget <<= 10;
+      break;
+    case 'm':
+      budget <<= 20;
+      break;
+    case 'g':
+      budget <<= 30;
+      break;
+    default:
+      return default_memory_budget;
+  }
+  return static_cast<std::size_t>(budget);
+}
+
+/**
+ * Sorter for more trivially copyable records than fit in memory.
+ *
+ * Memory use is bounded by the budget given on construction plus a small
+ * constant per run. Reading a run is buffered in chunks of at least
+ * `min_chunk_size` records, so the number of runs merged at once is at most
+ * the number of such chunks fitting in the budget.
+ *
+ * @tparam T Trivially copyable record type
+ * @tparam Compare Strict weak ordering of the records
+ */
+template <typename T, typename Compare = std::less<>>
+class external_sorter {
+public:
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  /**
+   * Minimum number of records read from a run at once when merging.
+   */
+  static constexpr std::size_t min_chunk_size = 1024U;
+
+  /**
+   * Ctor.
+   *
+   * @param comp Record ordering
+   * @param budget Memory budget in bytes
+   */
+  explicit external_sorter(
+    Compare comp = {}, std::size_t budget = memory_budget())
+    : comp_{std::move(comp)},
+      run_capacity_{std::max(budget / sizeof(T), 3 * min_chunk_size)},
+      fan_in_{run_capacity_ / min_chunk_size - 1}
+  {}
+
+  /**
+   * Return the number of records pushed since construction or draining.
+   */
+  auto size() const noexcept
+  {
+    return size_;
+  }
+
+  /**
+   * Return the number of sorted runs spilled to temporary files.
+   */
+  auto n_runs() const noexcept
+  {
+    return runs_.size();
+  }
+
+  /**
+   * Add a record, spilling the buffered records if the buffer is full.
+   *
+   * @param value Record to add
+   */
+  void push(const T& value)
+  {
+    // grow geometrically up to the run capacity
+    if (buffer_.size() == buffer_.capacity()) {
+      auto capacity = std::max(2 * buffer_.capacity(), min_chunk_size);
+      buffer_.reserve(std::min(capacity, run_capacity_));
+    }
+    buffer_.push_back(value);
+    size_++;
+    if (buffer_.size() == run_capacity_)
+      spill();
+  }
+
+  /**
+   * Visit every record in sorted order and empty the sorter.
+   *
+   * @tparam F Callable with signature `void(const T&)`
+   *
+   * @param visit Record visitor
+   */
+  template <typename F>
+  void drain(F&& visit)
+  {
+    // everything fits in memory
+    if (runs_.empty()) {
+      std::sort(buffer_.begin(), buffer_.end(), comp_);
+      for (const auto& value : buffer_)
+        visit(value);
+    }
+    else {
+      if (buffer_.size())
+        spill();
+      // release the buffer so the merge buffers stay within the budget
+      decltype(buffer_)().swap(buffer_);
+      // merge groups of runs into longer runs until one merge is enough
+      while (runs_.size() > fan_in_) {
+        std::vector<run> merged;
+        for (std::size_t i = 0; i < runs_.size(); i += fan_in_) {
+          auto last = std::min(i + fan_in_, runs_.size());
+          auto output = make_run();
+          std::vector<T> chunk;
+          chunk.reserve(run_capacity_ / (last - i + 1));
+          merge(
+            i,
+            last,
+            [&output, &chunk](const T& value)
+            {
+              chunk.push_back(value);
+              if (chunk.size() == chunk.capacity())
+                write(output, chunk);
+            }
+          );
+          write(output, chunk);
+          merged.push_back(std::move(output));
+        }
+        runs_ = std::move(merged);
+      }
+      merge(0, runs_.size(), visit);
+    }
+    buffer_.clear();
+    runs_.clear();
+    size_ = 0;
+  }
+
+private:
+  /**
+   * Deleter closing a C stream.
+   */
+  struct file_closer {
+    void operator()(std::FILE* f) const noexcept
+    {
+      std::fclose(f);
+    }
+  };
+
+  /**
+   * Sorted run in a temporary file deleted when closed.
+   */
+  struct run {
+    std::unique_ptr<std::FILE, file_closer> file;
+    std::size_t size;
+  };
+
+  Compare comp_;
+  std::size_t run_capacity_;
+  std::size_t fan_in_;
+  std::size_t size_{};
+  std::vector<T> buffer_;
+  std::vector<run> runs_;
+
+  /**
+   * Return a new empty run.
+   */
+  static run make_run()
+  {
+    run output{std::unique_ptr<std::FILE, file_closer>{std::tmpfile()}, 0};
+    if (!output.file)
+      throw_error<std::runtime_error>("Cannot create temp file for run");
+    return output;
+  }
+
+  /**
+   * Append records to a run and clear them.
+   *
+   * @param output Run to append to
+   * @param values Records to append
+   */
+  static void write(run& output, std::vector<T>& values)
+  {
+    if (
+      std::fwrite(values.data(), sizeof(T), values.size(), output.file.get()) !=
+      values.size()
+    )
+      throw_error<std::runtime_error>("Failed to write run to temp file");
+    output.size += values.size();
+    values.clear();
+  }
+
+  /**
+   * Sort the buffered records and write them as a new run.
+   */
+  void spill()
+  {
+    std::sort(buffer_.begin(), buffer_.end(), comp_);
+    auto output = make_run();
+    write(output, buffer_);
+    runs_.push_back(std::move(output));
+  }
+
+  /**
+   * Visit the records of a range of runs in sorted order.
+   *
+   * Each run gets an equal share of the budget as its read buffer, with one
+   * share left for the visitor, e.g. for writing a merged run.
+   *
+   * @tparam F Callable with signature `void(const T&)`
+   *
+   * @param first Index of the first run to merge
+   * @param last Index one past the last run to merge
+   * @param visit Record visitor
+   */
+  template <typename F>
+  void merge(std::size_t first, std::size_t last, F&& visit)
+  {
+    // read position in a run
+    struct cursor {
+      run* source;
+      std::vector<T> chunk;
+      std::size_t pos;
+      std::size_t remaining;
+    };
+    auto chunk_size = run_capacity_ / (last - first + 1);
+    // refill a cursor's chunk, returning false if the run is exhausted
+    auto refill = [chunk_size](cursor& cur)
+    {
+      auto n_read = std::min(chunk_size, cur.remaining);
+      cur.chunk.resize(n_read);
+      if (
+        std::fread(cur.chunk.data(), sizeof(T), n_read, cur.source->file.get())
+          != n_read
+      )
+        throw_error<std::runtime_error>("Failed to read run from temp file");
+      cur.remaining -= n_read;
+      cur.pos = 0;
+      return n_read > 0;
+    };
+    std::vector<cursor> cursors;
+    cursors.reserve(last - first);
+    for (auto i = first; i < last; i++) {
+      std::rewind(runs_[i].file.get());
+      cursors.push_back({&runs_[i], {}, 0, runs_[i].size});
+      cursors.back().chunk.reserve(chunk_size);
+    }
+    // min-heap of cursors by their current record
+    auto greater = [this, &cursors](std::size_t a, std::size_t b)
+    {
+      const auto& cur_a = cursors[a];
+      const auto& cur_b = cursors[b];
+      return comp_(cur_b.chunk[cur_b.pos], cur_a.chunk[cur_a.pos]);
+    };
+    std::priority_queue<
+      std::size_t, std::vector<std::size_t>, decltype(greater)
+    > heap{greater};
+    for (std::size_t i = 0; i < cursors.size(); i++)
+      if (refill(cursors[i]))
+        heap.push(i);
+    while (heap.size()) {
+      auto i = heap.top();
+      heap.pop();
+      auto& cur = cursors[i];
+      visit(cur.chunk[cur.pos]);
+      if (++cur.pos < cur.chunk.size() || refill(cur))
+        heap.push(i);
+    }
+  }
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_EXTERNAL_SORT_HH_
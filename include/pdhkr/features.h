@@ -30,4 +30,19 @@
 #define PDHKR_HAS_CC_20 0
 #endif  // PDHKR_HAS_CC_20
 
+// constexpr for functions that can only be constant evaluated from C++20 on,
+// e.g. since they use std::vector or the <algorithm> and <numeric> algorithms
+#if PDHKR_HAS_CC_20
+#define PDHKR_CONSTEXPR20 constexpr
+#else
+#define PDHKR_CONSTEXPR20
+#endif  // !PDHKR_HAS_CC_20
+
+// exception support, e.g. no -fno-exceptions for GCC/Clang, /EHsc for MSVC
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#define PDHKR_HAS_EXCEPTIONS 1
+#else
+#define PDHKR_HAS_EXCEPTIONS 0
+#endif  // !defined(__cpp_exceptions) && !defined(_CPPUNWIND)
+
 #endif  // PDHKR_FEATURES_H_
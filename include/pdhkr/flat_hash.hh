@@ -0,0 +1,962 @@
+/**
+ * @file flat_hash.hh
+ * @author Derek Huang
+ * @brief C++ header for open-addressing flat hash sets and maps
+ * @copyright MIT License
+ *
+ * `flat_hash_set` and `flat_hash_map` store their elements in one contiguous
+ * slot array next to an array of one-byte control values, following the
+ * "Swiss table" design. A control byte is either empty, deleted, or the low 7
+ * bits of a full slot's hash, so a lookup compares a group of 16 control bytes
+ * against the hash at once and only touches the slots whose bytes match. On
+ * x86-64 the group compare is done with SSE2, with a portable scalar loop
+ * otherwise.
+ *
+ * Unlike `std::unordered_set` and `std::unordered_map`, insertion does not
+ * allocate a node per element, and iteration walks an array instead of a
+ * linked list. The trade-off is that rehashing invalidates all iterators and
+ * references, and that iteration order is unspecified and changes on rehash.
+ */
+
+#ifndef PDHKR_FLAT_HASH_HH_
+#define PDHKR_FLAT_HASH_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PDHKR_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define PDHKR_FLAT_HASH_SSE2 0
+#endif  // !defined(__SSE2__) && !defined(_M_X64) && ...
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr {
+
+namespace detail {
+
+/**
+ * Control byte type.
+ *
+ * Full slots have a non-negative value, the 7-bit hash fragment.
+ */
+using flat_ctrl = signed char;
+
+inline constexpr flat_ctrl flat_ctrl_empty = -128;
+inline constexpr flat_ctrl flat_ctrl_deleted = -2;
+
+/**
+ * Number of control bytes probed at once.
+ */
+inline constexpr std::size_t flat_group_width = 16;
+
+/**
+ * Bit mask of the positions within a group that matched a query.
+ */
+class flat_group_mask {
+public:
+  explicit flat_group_mask(std::uint32_t mask) noexcept : mask_{mask} {}
+
+  /**
+   * Return `true` if any position matched.
+   */
+  explicit operator bool() const noexcept { return mask_; }
+
+  /**
+   * Return the lowest matched position and clear it.
+   */
+  unsigned int next() noexcept
+  {
+#if defined(__GNUC__)
+    auto i = static_cast<unsigned int>(__builtin_ctz(mask_));
+#else
+    unsigned int i = 0;
+    while (!(mask_ & (1U << i)))
+      i++;
+#endif  // !defined(__GNUC__)
+    mask_ &= mask_ - 1;
+    return i;
+  }
+
+private:
+  std::uint32_t mask_;
+};
+
+/**
+ * View of a group of control bytes.
+ */
+class flat_group {
+public:
+  explicit flat_group(const flat_ctrl* ctrl) noexcept
+#if PDHKR_FLAT_HASH_SSE2
+    : ctrl_{_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))}
+#else
+    : ctrl_{ctrl}
+#endif  // !PDHKR_FLAT_HASH_SSE2
+  {}
+
+  /**
+   * Return the positions whose control byte equals the given value.
+   */
+  flat_group_mask match(flat_ctrl value) const noexcept
+  {
+#if PDHKR_FLAT_HASH_SSE2
+    return flat_group_mask{
+      static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrl_))
+      )
+    };
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < flat_group_width; i++)
+      mask |= static_cast<std::uint32_t>(ctrl_[i] == value) << i;
+    return flat_group_mask{mask};
+#endif  // !PDHKR_FLAT_HASH_SSE2
+  }
+
+  /**
+   * Return the empty positions.
+   */
+  flat_group_mask match_empty() const noexcept
+  {
+    return match(flat_ctrl_empty);
+  }
+
+  /**
+   * Return the empty or deleted positions, i.e. those with the high bit set.
+   */
+  flat_group_mask match_free() const noexcept
+  {
+#if PDHKR_FLAT_HASH_SSE2
+    return flat_group_mask{
+      static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_))
+    };
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < flat_group_width; i++)
+      mask |= static_cast<std::uint32_t>(ctrl_[i] < 0) << i;
+    return flat_group_mask{mask};
+#endif  // !PDHKR_FLAT_HASH_SSE2
+  }
+
+private:
+#if PDHKR_FLAT_HASH_SSE2
+  __m128i ctrl_;
+#else
+  const flat_ctrl* ctrl_;
+#endif  // !PDHKR_FLAT_HASH_SSE2
+};
+
+/**
+ * Return a hash with its bits mixed.
+ *
+ * `std::hash` is the identity for integers in the common standard libraries,
+ * so without mixing, the group index and the 7-bit control fragment of small
+ * integer IDs would come from a few correlated low bits.
+ *
+ * @param hash Hash value
+ */
+inline std::uint64_t flat_mix(std::size_t hash) noexcept
+{
+  auto x = static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ULL;
+  return x ^ (x >> 32);
+}
+
+/**
+ * Slot key extractor for sets.
+ */
+struct flat_set_key {
+  template <typename T>
+  static const T& get(const T& value) noexcept { return value; }
+};
+
+/**
+ * Slot key extractor for maps.
+ */
+struct flat_map_key {
+  template <typename T>
+  static const auto& get(const T& value) noexcept { return value.first; }
+};
+
+/**
+ * Open-addressing hash table shared by the set and map.
+ *
+ * The capacity is zero or a power of two that is at least the group width,
+ * and groups are aligned to multiples of the group width. The probe sequence
+ * visits the groups in triangular order, which covers every group for a power
+ * of two group count, until a group with an empty control byte is reached.
+ *
+ * @tparam Key Key type
+ * @tparam Slot Element type
+ * @tparam KeyOf Key extractor with a static `get(const Slot&)`
+ * @tparam Hash Key hasher
+ * @tparam KeyEqual Key equality predicate
+ */
+template <
+  typename Key, typename Slot, typename KeyOf, typename Hash, typename KeyEqual>
+class flat_table {
+public:
+  using key_type = Key;
+  using value_type = Slot;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  /**
+   * Forward iterator over the full slots.
+   *
+   * @tparam Const `true` for a const iterator
+   */
+  template <bool Const>
+  class basic_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Slot;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, const Slot&, Slot&>;
+    using pointer = std::conditional_t<Const, const Slot*, Slot*>;
+
+    basic_iterator() noexcept = default;
+
+    /**
+     * Conversion ctor from a non-const iterator.
+     */
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    basic_iterator(const basic_iterator<false>& other) noexcept
+      : ctrl_{other.ctrl_}, slot_{other.slot_}, last_{other.last_}
+    {}
+
+    reference operator*() const noexcept { return *slot_; }
+    pointer operator->() const noexcept { return slot_; }
+
+    basic_iterator& operator++() noexcept
+    {
+      ++ctrl_;
+      ++slot_;
+      skip_free();
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(
+      const basic_iterator& a, const basic_iterator& b) noexcept
+    {
+      return a.ctrl_ == b.ctrl_;
+    }
+
+    friend bool operator!=(
+      const basic_iterator& a, const basic_iterator& b) noexcept
+    {
+      return a.ctrl_ != b.ctrl_;
+    }
+
+  private:
+    friend class flat_table;
+    template <bool>
+    friend class basic_iterator;
+
+    const flat_ctrl* ctrl_{};
+    pointer slot_{};
+    const flat_ctrl* last_{};
+
+    basic_iterator(
+      const flat_ctrl* ctrl, pointer slot, const flat_ctrl* last) noexcept
+      : ctrl_{ctrl}, slot_{slot}, last_{last}
+    {}
+
+    /**
+     * Advance to the next full slot or the end.
+     */
+    void skip_free() noexcept
+    {
+      while (ctrl_ != last_ && *ctrl_ < 0) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  /**
+   * Default ctor.
+   */
+  flat_table() noexcept = default;
+
+  /**
+   * Copy ctor.
+   */
+  flat_table(const flat_table& other)
+    : hash_{other.hash_}, equal_{other.equal_}
+  {
+    reserve(other.size_);
+    for (const auto& value : other)
+      insert_unique(value);
+  }
+
+  /**
+   * Move ctor.
+   */
+  flat_table(flat_table&& other) noexcept
+    : hash_{std::move(other.hash_)},
+      equal_{std::move(other.equal_)},
+      ctrl_{std::exchange(other.ctrl_, nullptr)},
+      slots_{std::exchange(other.slots_, nullptr)},
+      capacity_{std::exchange(other.capacity_, 0)},
+      size_{std::exchange(other.size_, 0)},
+      growth_left_{std::exchange(other.growth_left_, 0)},
+      first_full_{std::exchange(other.first_full_, 0)}
+  {}
+
+  /**
+   * Dtor.
+   */
+  ~flat_table()
+  {
+    destroy();
+  }
+
+  /**
+   * Copy assignment operator.
+   */
+  flat_table& operator=(const flat_table& other)
+  {
+    if (this != &other) {
+      auto copy = other;
+      swap(copy);
+    }
+    return *this;
+  }
+
+  /**
+   * Move assignment operator.
+   */
+  flat_table& operator=(flat_table&& other) noexcept
+  {
+    if (this != &other) {
+      destroy();
+      swap(other);
+    }
+    return *this;
+  }
+
+  /**
+   * Swap contents with another table.
+   */
+  void swap(flat_table& other) noexcept
+  {
+    using std::swap;
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+    swap(ctrl_, other.ctrl_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+    swap(growth_left_, other.growth_left_);
+    swap(first_full_, other.first_full_);
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return !size_; }
+
+  /**
+   * Return the number of slots.
+   */
+  size_type capacity() const noexcept { return capacity_; }
+
+  /**
+   * Return an iterator to the first element.
+   *
+   * The search starts from a lower bound on the first full slot that is
+   * advanced past the free slots found, so repeatedly erasing the first element
+   * costs amortized constant time instead of rescanning the erased prefix.
+   */
+  iterator begin() noexcept
+  {
+    skip_to_first_full();
+    return iterator_at(first_full_);
+  }
+
+  /**
+   * Return a const iterator to the first element.
+   */
+  const_iterator begin() const noexcept
+  {
+    skip_to_first_full();
+    return {ctrl_ + first_full_, slots_ + first_full_, ctrl_ + capacity_};
+  }
+
+  iterator end() noexcept
+  {
+    return {ctrl_ + capacity_, slots_ + capacity_, ctrl_ + capacity_};
+  }
+
+  const_iterator end() const noexcept
+  {
+    return {ctrl_ + capacity_, slots_ + capacity_, ctrl_ + capacity_};
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  /**
+   * Return an iterator to the element with the given key or `end()`.
+   *
+   * @param key Key to find
+   */
+  iterator find(const Key& key)
+  {
+    auto i = find_index(key);
+    return (i == capacity_) ? end() : iterator_at(i);
+  }
+
+  /**
+   * Return a const iterator to the element with the given key or `end()`.
+   *
+   * @param key Key to find
+   */
+  const_iterator find(const Key& key) const
+  {
+    auto i = find_index(key);
+    if (i == capacity_)
+      return end();
+    return {ctrl_ + i, slots_ + i, ctrl_ + capacity_};
+  }
+
+  /**
+   * Return `true` if an element with the given key exists.
+   */
+  bool contains(const Key& key) const { return find_index(key) != capacity_; }
+
+  /**
+   * Return 1 if an element with the given key exists, 0 otherwise.
+   */
+  size_type count(const Key& key) const { return contains(key); }
+
+  /**
+   * Insert an element if no element with an equal key exists.
+   *
+   * @param value Element to insert
+   * @returns Iterator to the element with the key and `true` if inserted
+   */
+  std::pair<iterator, bool> insert(const Slot& value)
+  {
+    return emplace_key(KeyOf::get(value), value);
+  }
+
+  /**
+   * Insert an element if no element with an equal key exists.
+   *
+   * @param value Element to insert
+   * @returns Iterator to the element with the key and `true` if inserted
+   */
+  std::pair<iterator, bool> insert(Slot&& value)
+  {
+    return emplace_key(KeyOf::get(value), std::move(value));
+  }
+
+  /**
+   * Insert elements from an iterator range.
+   *
+   * @tparam InputIt Input iterator
+   *
+   * @param first Iterator to the first element
+   * @param last Iterator one past the last element
+   */
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  /**
+   * Erase the element with the given key, if any.
+   *
+   * @param key Key to erase
+   * @returns Number of elements erased
+   */
+  size_type erase(const Key& key)
+  {
+    auto i = find_index(key);
+    if (i == capacity_)
+      return 0;
+    erase_index(i);
+    return 1;
+  }
+
+  /**
+   * Erase the element at the given iterator.
+   *
+   * Unlike the node-based containers, this does not return the next iterator,
+   * although the given iterator may be incremented after erasure.
+   *
+   * @param pos Iterator to an element
+   */
+  void erase(const_iterator pos)
+  {
+    erase_index(static_cast<size_type>(pos.ctrl_ - ctrl_));
+  }
+
+  /**
+   * Erase all the elements, keeping the capacity.
+   */
+  void clear() noexcept
+  {
+    if (!capacity_)
+      return;
+    for (size_type i = 0; i < capacity_; i++)
+      if (ctrl_[i] >= 0)
+        std::destroy_at(slots_ + i);
+    std::memset(ctrl_, flat_ctrl_empty, capacity_);
+    size_ = 0;
+    growth_left_ = max_load(capacity_);
+    first_full_ = capacity_;
+  }
+
+  /**
+   * Ensure that the given number of elements fit without rehashing.
+   *
+   * @param n Number of elements
+   */
+  void reserve(size_type n)
+  {
+    if (n > size_ + growth_left_)
+      rehash(capacity_for(n));
+  }
+
+protected:
+  /**
+   * Insert an element constructed from arguments if the key does not exist.
+   *
+   * @param key Key of the element to insert
+   * @param args Slot ctor arguments
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_key(const Key& key, Args&&... args)
+  {
+    auto hash = flat_mix(hash_(key));
+    auto i = find_index(key, hash);
+    if (i != capacity_)
+      return {iterator_at(i), false};
+    i = prepare_insert(hash);
+    ::new (slots_ + i) Slot(std::forward<Args>(args)...);
+    set_ctrl(i, h2(hash));
+    size_++;
+    return {iterator_at(i), true};
+  }
+
+  /**
+   * Return the index of the element with the given key or the capacity.
+   */
+  size_type find_index(const Key& key) const
+  {
+    return capacity_ ? find_index(key, flat_mix(hash_(key))) : capacity_;
+  }
+
+private:
+  hasher hash_{};
+  key_equal equal_{};
+  flat_ctrl* ctrl_{};
+  Slot* slots_{};
+  size_type capacity_{};
+  size_type size_{};
+  size_type growth_left_{};
+  // no slot before this index is full
+  mutable size_type first_full_{};
+
+  static flat_ctrl h2(std::uint64_t hash) noexcept
+  {
+    return static_cast<flat_ctrl>(hash & 0x7f);
+  }
+
+  /**
+   * Return the number of elements allowed for a capacity, at 7/8 load.
+   */
+  static size_type max_load(size_type capacity) noexcept
+  {
+    return capacity - capacity / 8;
+  }
+
+  /**
+   * Return the smallest valid capacity that can hold the given elements.
+   */
+  static size_type capacity_for(size_type n) noexcept
+  {
+    size_type capacity = flat_group_width;
+    while (max_load(capacity) < n)
+      capacity *= 2;
+    return capacity;
+  }
+
+  iterator iterator_at(size_type i) noexcept
+  {
+    return {ctrl_ + i, slots_ + i, ctrl_ + capacity_};
+  }
+
+  /**
+   * Set a control byte, lowering the first full slot bound if now full.
+   */
+  void set_ctrl(size_type i, flat_ctrl value) noexcept
+  {
+    ctrl_[i] = value;
+    if (value >= 0 && i < first_full_)
+      first_full_ = i;
+  }
+
+  /**
+   * Advance the first full slot bound to the first full slot or the capacity.
+   */
+  void skip_to_first_full() const noexcept
+  {
+    while (first_full_ < capacity_ && ctrl_[first_full_] < 0)
+      first_full_++;
+  }
+
+  /**
+   * Return the index of the element with the key and hash or the capacity.
+   */
+  size_type find_index(const Key& key, std::uint64_t hash) const
+  {
+    if (!capacity_)
+      return capacity_;
+    auto n_groups_mask = capacity_ / flat_group_width - 1;
+    auto group = static_cast<size_type>(hash >> 7) & n_groups_mask;
+    for (size_type step = 1; ; step++) {
+      auto offset = group * flat_group_width;
+      flat_group ctrl{ctrl_ + offset};
+      for (auto mask = ctrl.match(h2(hash)); mask; ) {
+        auto i = offset + mask.next();
+        if (equal_(KeyOf::get(slots_[i]), key))
+          return i;
+      }
+      if (ctrl.match_empty())
+        return capacity_;
+      group = (group + step) & n_groups_mask;
+    }
+  }
+
+  /**
+   * Return the index of the first free slot in the probe sequence of a hash.
+   *
+   * There must be at least one free slot.
+   */
+  size_type find_free(std::uint64_t hash) const noexcept
+  {
+    auto n_groups_mask = capacity_ / flat_group_width - 1;
+    auto group = static_cast<size_type>(hash >> 7) & n_groups_mask;
+    for (size_type step = 1; ; step++) {
+      auto offset = group * flat_group_width;
+      if (auto mask = flat_group{ctrl_ + offset}.match_free())
+        return offset + mask.next();
+      group = (group + step) & n_groups_mask;
+    }
+  }
+
+  /**
+   * Return the index of the slot to insert a new element with a hash into.
+   *
+   * The table is rehashed if inserting into an empty slot would exceed the
+   * max load. Reusing a deleted slot never does.
+   */
+  size_type prepare_insert(std::uint64_t hash)
+  {
+    if (capacity_) {
+      auto i = find_free(hash);
+      if (ctrl_[i] == flat_ctrl_deleted)
+        return i;
+      if (growth_left_) {
+        growth_left_--;
+        return i;
+      }
+      // rehash in place if mostly tombstones, otherwise grow
+      rehash((size_ < max_load(capacity_) / 2) ? capacity_ : 2 * capacity_);
+    }
+    else
+      rehash(flat_group_width);
+    growth_left_--;
+    return find_free(hash);
+  }
+
+  /**
+   * Erase the element at the given index.
+   *
+   * If the slot's group has an empty byte, no probe sequence continues past
+   * the group, so the slot can become empty instead of a tombstone.
+   */
+  void erase_index(size_type i) noexcept
+  {
+    std::destroy_at(slots_ + i);
+    size_--;
+    auto offset = i - i % flat_group_width;
+    if (flat_group{ctrl_ + offset}.match_empty()) {
+      set_ctrl(i, flat_ctrl_empty);
+      growth_left_++;
+    }
+    else
+      set_ctrl(i, flat_ctrl_deleted);
+  }
+
+  /**
+   * Move the elements into new arrays with the given capacity.
+   *
+   * @param new_capacity Power of two at least the group width
+   */
+  void rehash(size_type new_capacity)
+  {
+    auto old_ctrl = ctrl_;
+    auto old_slots = slots_;
+    auto old_capacity = capacity_;
+    ctrl_ = std::allocator<flat_ctrl>{}.allocate(new_capacity);
+    slots_ = std::allocator<Slot>{}.allocate(new_capacity);
+    capacity_ = new_capacity;
+    std::memset(ctrl_, flat_ctrl_empty, capacity_);
+    growth_left_ = max_load(capacity_) - size_;
+    first_full_ = capacity_;
+    for (size_type i = 0; i < old_capacity; i++) {
+      if (old_ctrl[i] < 0)
+        continue;
+      auto hash = flat_mix(hash_(KeyOf::get(old_slots[i])));
+      auto j = find_free(hash);
+      ::new (slots_ + j) Slot(std::move(old_slots[i]));
+      std::destroy_at(old_slots + i);
+      set_ctrl(j, h2(hash));
+    }
+    if (old_capacity) {
+      std::allocator<flat_ctrl>{}.deallocate(old_ctrl, old_capacity);
+      std::allocator<Slot>{}.deallocate(old_slots, old_capacity);
+    }
+  }
+
+  /**
+   * Destroy the elements and free the arrays.
+   */
+  void destroy() noexcept
+  {
+    if (!capacity_)
+      return;
+    for (size_type i = 0; i < capacity_; i++)
+      if (ctrl_[i] >= 0)
+        std::destroy_at(slots_ + i);
+    std::allocator<flat_ctrl>{}.deallocate(ctrl_, capacity_);
+    std::allocator<Slot>{}.deallocate(slots_, capacity_);
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = size_ = growth_left_ = first_full_ = 0;
+  }
+
+  /**
+   * Insert an element known not to be in the table.
+   */
+  void insert_unique(const Slot& value)
+  {
+    auto hash = flat_mix(hash_(KeyOf::get(value)));
+    auto i = prepare_insert(hash);
+    ::new (slots_ + i) Slot(value);
+    set_ctrl(i, h2(hash));
+    size_++;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Flat open-addressing hash set.
+ *
+ * Elements are immutable through iterators, as with `std::unordered_set`.
+ *
+ * @tparam Key Key type
+ * @tparam Hash Key hasher
+ * @tparam KeyEqual Key equality predicate
+ */
+template <
+  typename Key,
+  typename Hash = std::hash<Key>,
+  typename KeyEqual = std::equal_to<Key> >
+class flat_hash_set
+  : public detail::flat_table<Key, Key, detail::flat_set_key, Hash, KeyEqual> {
+private:
+  using base_type =
+    detail::flat_table<Key, Key, detail::flat_set_key, Hash, KeyEqual>;
+
+public:
+  using iterator = typename base_type::const_iterator;
+  using const_iterator = typename base_type::const_iterator;
+
+  /**
+   * Default ctor.
+   */
+  flat_hash_set() noexcept = default;
+
+  /**
+   * Ctor.
+   *
+   * @param values Initial values
+   */
+  flat_hash_set(std::initializer_list<Key> values)
+  {
+    this->reserve(values.size());
+    this->insert(values.begin(), values.end());
+  }
+
+  const_iterator begin() const noexcept { return base_type::begin(); }
+  const_iterator end() const noexcept { return base_type::end(); }
+
+  const_iterator find(const Key& key) const { return base_type::find(key); }
+
+  /**
+   * Insert a value if it does not exist.
+   *
+   * @param value Value to insert
+   * @returns Iterator to the value and `true` if inserted
+   */
+  std::pair<const_iterator, bool> insert(const Key& value)
+  {
+    return base_type::insert(value);
+  }
+
+  /**
+   * Insert values from an iterator range.
+   */
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last)
+  {
+    base_type::insert(first, last);
+  }
+
+  /**
+   * Construct a value in place if it does not exist.
+   *
+   * @param args Key ctor arguments
+   */
+  template <typename... Args>
+  std::pair<const_iterator, bool> emplace(Args&&... args)
+  {
+    Key key(std::forward<Args>(args)...);
+    return this->emplace_key(key, std::move(key));
+  }
+};
+
+/**
+ * Flat open-addressing hash map.
+ *
+ * Elements are `std::pair<const Key, T>`, as with `std::unordered_map`.
+ *
+ * @tparam Key Key type
+ * @tparam T Mapped type
+ * @tparam Hash Key hasher
+ * @tparam KeyEqual Key equality predicate
+ */
+template <
+  typename Key,
+  typename T,
+  typename Hash = std::hash<Key>,
+  typename KeyEqual = std::equal_to<Key> >
+class flat_hash_map
+  : public detail::flat_table<
+      Key, std::pair<const Key, T>, detail::flat_map_key, Hash, KeyEqual
+    > {
+private:
+  using base_type = detail::flat_table<
+    Key, std::pair<const Key, T>, detail::flat_map_key, Hash, KeyEqual
+  >;
+
+public:
+  using mapped_type = T;
+  using typename base_type::iterator;
+  using typename base_type::const_iterator;
+
+  /**
+   * Insert a value constructed from arguments if the key does not exist.
+   *
+   * @param key Key
+   * @param args Mapped value ctor arguments
+   * @returns Iterator to the element with the key and `true` if inserted
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+  {
+    return this->emplace_key(
+      key,
+      std::piecewise_construct,
+      std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...)
+    );
+  }
+
+  /**
+   * Insert a key and value.
+   *
+   * @param key Key
+   * @param value Mapped value
+   * @returns Iterator to the element with the key and `true` if inserted
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+  {
+    return try_emplace(key, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Return a reference to the value for a key, inserting a default if needed.
+   *
+   * @param key Key
+   */
+  T& operator[](const Key& key)
+  {
+    return try_emplace(key).first->second;
+  }
+
+  /**
+   * Return a reference to the value for an existing key.
+   *
+   * If the key does not exist, `std::out_of_range` is thrown.
+   *
+   * @param key Key
+   */
+  T& at(const Key& key)
+  {
+    auto it = this->find(key);
+    if (it == this->end())
+      throw_error<std::out_of_range>("flat_hash_map::at: key not found");
+    return it->second;
+  }
+
+  /**
+   * Return a const reference to the value for an existing key.
+   *
+   * If the key does not exist, `std::out_of_range` is thrown.
+   *
+   * @param key Key
+   */
+  const T& at(const Key& key) const
+  {
+    auto it = this->find(key);
+    if (it == this->end())
+      throw_error<std::out_of_range>("flat_hash_map::at: key not found");
+    return it->second;
+  }
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_FLAT_HASH_HH_
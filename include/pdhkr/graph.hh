@@ -0,0 +1,416 @@
+/**
+ * @file graph.hh
+ * @author Derek Huang
+ * @brief C++ header for compressed sparse row graphs and their traversal
+ * @copyright MIT License
+ *
+ * `csr_graph<Index>` stores the neighbors of every node contiguously in one
+ * array, with a second array of offsets giving where each node's neighbors
+ * start, so a traversal reads neighbors sequentially instead of chasing hash
+ * buckets. It is built from an edge list in O(V + E) time with a counting sort
+ * on the source nodes.
+ *
+ * `graph_search<Index>` holds the visited bitset and the node array used as
+ * the BFS queue and the DFS stack. Since a node is only ever enqueued once, the
+ * arrays never grow past the node count and are allocated once up front, so
+ * traversals from any number of roots do no allocation.
+ */
+
+#ifndef PDHKR_GRAPH_HH_
+#define PDHKR_GRAPH_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr {
+
+/**
+ * Whether each input edge is stored as one or two arcs.
+ */
+enum class edge_direction {
+  directed,   // arc from the first to the second node only
+  undirected  // arcs in both directions
+};
+
+/**
+ * Fixed-size set of node flags packed 64 to a word.
+ */
+class node_bitset {
+public:
+  /**
+   * Ctor.
+   *
+   * @param size Number of flags, all initially unset
+   */
+  explicit node_bitset(std::size_t size = 0)
+    : size_{size}, words_((size + word_bits - 1) / word_bits)
+  {}
+
+  /**
+   * Return the number of flags.
+   */
+  auto size() const noexcept { return size_; }
+
+  /**
+   * Return `true` if the flag at the index is set.
+   */
+  bool test(std::size_t i) const noexcept
+  {
+    return (words_[i / word_bits] >> (i % word_bits)) & 1U;
+  }
+
+  /**
+   * Set the flag at the index.
+   */
+  void set(std::size_t i) noexcept
+  {
+    words_[i / word_bits] |= std::uint64_t{1} << (i % word_bits);
+  }
+
+  /**
+   * Unset all the flags.
+   */
+  void clear() noexcept
+  {
+    std::fill(words_.begin(), words_.end(), std::uint64_t{});
+  }
+
+  /**
+   * Return the index of the first unset flag at or past `i`, else `size()`.
+   *
+   * Set flags are skipped a word at a time.
+   */
+  std::size_t next_unset(std::size_t i) const noexcept
+  {
+    while (i < size_) {
+      auto word = ~words_[i / word_bits] >> (i % word_bits);
+      if (word) {
+        while (!(word & 1U)) {
+          word >>= 1;
+          i++;
+        }
+        return std::min(i, size_);
+      }
+      i += word_bits - i % word_bits;
+    }
+    return size_;
+  }
+
+private:
+  static constexpr std::size_t word_bits = 64U;
+  std::size_t size_;
+  std::vector<std::uint64_t> words_;
+};
+
+/**
+ * Graph in compressed sparse row form.
+ *
+ * Node `u` has the neighbors `targets_[offsets_[u]]` through
+ * `targets_[offsets_[u + 1] - 1]`, in the order their edges were given.
+ * Duplicate edges are kept as duplicate arcs.
+ *
+ * @tparam Index Unsigned type that can hold the node and arc counts
+ */
+template <typename Index = std::uint32_t>
+class csr_graph {
+public:
+  using index_type = Index;
+
+  /**
+   * Contiguous range of nodes, e.g. a node's neighbors.
+   */
+  class node_range {
+  public:
+    node_range(const Index* first, const Index* last) noexcept
+      : first_{first}, last_{last}
+    {}
+
+    auto begin() const noexcept { return first_; }
+    auto end() const noexcept { return last_; }
+    std::size_t size() const noexcept { return last_ - first_; }
+    bool empty() const noexcept { return first_ == last_; }
+
+  private:
+    const Index* first_;
+    const Index* last_;
+  };
+
+  /**
+   * Default ctor.
+   *
+   * Creates an empty graph with no nodes.
+   */
+  csr_graph() : offsets_(1) {}
+
+  /**
+   * Ctor.
+   *
+   * Each node's degree is counted, the offsets are the exclusive prefix sums
+   * of the degrees, and each arc is then placed at its source's next free
+   * slot, all in O(V + E) time with a single allocation per array.
+   *
+   * @tparam ForwardIt Forward iterator over pair-like edges
+   *
+   * @param n_nodes Number of nodes
+   * @param first Iterator to the first edge
+   * @param last Iterator one past the last edge
+   * @param direction Whether edges are directed or undirected
+   * @param base ID of the first node, e.g. 1 for 1-indexed node IDs
+   */
+  template <typename ForwardIt>
+  csr_graph(
+    std::size_t n_nodes,
+    ForwardIt first,
+    ForwardIt last,
+    edge_direction direction = edge_direction::undirected,
+    std::size_t base = 0)
+    : offsets_(n_nodes + 1)
+  {
+    if (n_nodes > std::numeric_limits<Index>::max())
+      throw_error<std::overflow_error>("Node count too large for index type");
+    auto undirected = (direction == edge_direction::undirected);
+    // count arcs out of each node, offset by one for the prefix sum
+    std::size_t n_arcs = 0;
+    for (auto it = first; it != last; ++it) {
+      offsets_[node_index(std::get<0>(*it), base) + 1]++;
+      if (undirected)
+        offsets_[node_index(std::get<1>(*it), base) + 1]++;
+      n_arcs += undirected ? 2U : 1U;
+    }
+    if (n_arcs > std::numeric_limits<Index>::max())
+      throw_error<std::overflow_error>("Arc count too large for index type");
+    for (std::size_t i = 0; i < n_nodes; i++)
+      offsets_[i + 1] += offsets_[i];
+    // place arcs at the next free slot of their source node
+    targets_.resize(n_arcs);
+    std::vector<Index> cursors(offsets_.begin(), offsets_.end() - 1);
+    for (; first != last; ++first) {
+      auto a = node_index(std::get<0>(*first), base);
+      auto b = node_index(std::get<1>(*first), base);
+      targets_[cursors[a]++] = b;
+      if (undirected)
+        targets_[cursors[b]++] = a;
+    }
+  }
+
+  /**
+   * Return the number of nodes.
+   */
+  std::size_t n_nodes() const noexcept { return offsets_.size() - 1; }
+
+  /**
+   * Return the number of arcs, which is twice the edges if undirected.
+   */
+  std::size_t n_arcs() const noexcept { return targets_.size(); }
+
+  /**
+   * Return the number of arcs out of a node.
+   */
+  std::size_t degree(Index node) const noexcept
+  {
+    return offsets_[node + 1] - offsets_[node];
+  }
+
+  /**
+   * Return the neighbors of a node.
+   */
+  node_range neighbors(Index node) const noexcept
+  {
+    auto data = targets_.data();
+    return {data + offsets_[node], data + offsets_[node + 1]};
+  }
+
+private:
+  std::vector<Index> offsets_;
+  std::vector<Index> targets_;
+
+  /**
+   * Convert a node ID to a 0-based node index, checking its range.
+   */
+  template <typename T>
+  Index node_index(T id, std::size_t base) const
+  {
+    auto index = static_cast<std::size_t>(id);
+    if (index < base || index - base >= n_nodes())
+      throw_error<std::out_of_range>(
+        "Node ID " + std::to_string(index) + " out of range"
+      );
+    return static_cast<Index>(index - base);
+  }
+};
+
+/**
+ * Reusable BFS and DFS workspace for graphs with a fixed number of nodes.
+ *
+ * Nodes stay visited across traversals until `clear()` is called, so calling
+ * `bfs()` from every unvisited node visits each connected component once.
+ *
+ * @tparam Index Unsigned node index type of the `csr_graph`
+ */
+template <typename Index = std::uint32_t>
+class graph_search {
+public:
+  /**
+   * Ctor.
+   *
+   * @param n_nodes Number of nodes of the graphs to search
+   */
+  explicit graph_search(std::size_t n_nodes)
+    : visited_{n_nodes}, nodes_(n_nodes), cursors_(n_nodes)
+  {}
+
+  /**
+   * Return `true` if the node has been visited.
+   */
+  bool visited(Index node) const noexcept { return visited_.test(node); }
+
+  /**
+   * Return the visited node flags.
+   */
+  const auto& visited() const noexcept { return visited_; }
+
+  /**
+   * Mark every node as unvisited.
+   */
+  void clear() noexcept { visited_.clear(); }
+
+  /**
+   * Visit the unvisited nodes reachable from a node in breadth-first order.
+   *
+   * Nodes are marked visited when enqueued, so each enters the flat queue at
+   * most once and the queue is a plain array with no wraparound.
+   *
+   * @tparam Visit Callable with signature `void(Index)`
+   * @tparam Follow Callable with signature `bool(Index, Index)`
+   *
+   * @param graph Graph with at most as many nodes as the workspace
+   * @param root Node to start from, skipped if already visited
+   * @param visit Called for each newly visited node
+   * @param follow Return `true` if the arc from a node to a neighbor is used
+   * @returns Number of nodes visited
+   */
+  template <typename Visit, typename Follow>
+  std::size_t bfs(
+    const csr_graph<Index>& graph, Index root, Visit&& visit, Follow&& follow)
+  {
+    if (visited_.test(root))
+      return 0;
+    visited_.set(root);
+    nodes_[0] = root;
+    std::size_t head = 0;
+    std::size_t tail = 1;
+    while (head < tail) {
+      auto cur = nodes_[head++];
+      visit(cur);
+      for (auto next : graph.neighbors(cur)) {
+        if (!visited_.test(next) && follow(cur, next)) {
+          visited_.set(next);
+          nodes_[tail++] = next;
+        }
+      }
+    }
+    return tail;
+  }
+
+  /**
+   * Visit the unvisited nodes reachable from a node in breadth-first order.
+   *
+   * @tparam Visit Callable with signature `void(Index)`
+   *
+   * @param graph Graph with at most as many nodes as the workspace
+   * @param root Node to start from, skipped if already visited
+   * @param visit Called for each newly visited node
+   * @returns Number of nodes visited
+   */
+  template <typename Visit>
+  std::size_t bfs(const csr_graph<Index>& graph, Index root, Visit&& visit)
+  {
+    return bfs(graph, root, visit, [](Index, Index) { return true; });
+  }
+
+  /**
+   * Visit the unvisited nodes reachable from a node in depth-first preorder.
+   *
+   * The stack holds the current path from the root, each node with the
+   * position of the next of its arcs to follow.
+   *
+   * @tparam Visit Callable with signature `bool(Index)`
+   *
+   * @param graph Graph with at most as many nodes as the workspace
+   * @param root Node to start from, skipped if already visited
+   * @param visit Called for each newly visited node, returning `false` to
+   *  stop the search with the path to the node left on the stack
+   * @returns Number of nodes on the stack, zero unless stopped early
+   */
+  template <typename Visit>
+  std::size_t dfs(const csr_graph<Index>& graph, Index root, Visit&& visit)
+  {
+    if (visited_.test(root))
+      return 0;
+    visited_.set(root);
+    nodes_[0] = root;
+    cursors_[0] = 0;
+    std::size_t depth = 1;
+    if (!visit(root))
+      return depth;
+    while (depth) {
+      auto neighbors = graph.neighbors(nodes_[depth - 1]);
+      auto& cursor = cursors_[depth - 1];
+      // skip visited neighbors, popping the node once it has none left
+      auto arcs = neighbors.begin();
+      while (cursor < neighbors.size() && visited_.test(arcs[cursor]))
+        cursor++;
+      if (cursor == neighbors.size()) {
+        depth--;
+        continue;
+      }
+      auto next = arcs[cursor++];
+      visited_.set(next);
+      nodes_[depth] = next;
+      cursors_[depth] = 0;
+      depth++;
+      if (!visit(next))
+        return depth;
+    }
+    return 0;
+  }
+
+  /**
+   * Return the path between two nodes of a forest.
+   *
+   * The path is found by DFS from `source`, which is not reset beforehand, so
+   * `clear()` should be called between searches unless the nodes visited by
+   * earlier searches are to be avoided.
+   *
+   * @param graph Undirected graph with at most as many nodes as the workspace
+   * @param source First node of the path
+   * @param target Last node of the path
+   * @returns Range of the path's nodes, empty if `target` is not reachable,
+   *  valid until the next search
+   */
+  typename csr_graph<Index>::node_range path(
+    const csr_graph<Index>& graph, Index source, Index target)
+  {
+    auto length = dfs(
+      graph, source, [target](Index node) { return node != target; }
+    );
+    return {nodes_.data(), nodes_.data() + length};
+  }
+
+private:
+  node_bitset visited_;
+  std::vector<Index> nodes_;
+  std::vector<std::size_t> cursors_;
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_GRAPH_HH_
@@ -0,0 +1,460 @@
+/**
+ * @file lz.hh
+ * @author Derek Huang
+ * @brief C++ header for the compressed test data format
+ * @copyright MIT License
+ *
+ * Large test case files can be stored compressed in a simple LZ77 block
+ * format in the style of LZ4, implemented here so there is no external
+ * dependency. A compressed file is a sequence of independently compressed
+ * blocks of at most 64 KiB of original data, so it can be decompressed one
+ * block at a time while it is being parsed:
+ *
+ *    file  := "PDLZ" block* end
+ *    block := u32 raw_size, u32 stored_size, u32 checksum, stored_size bytes
+ *    end   := u32 0
+ *
+ * Integers are little endian. `raw_size` is the original block size, from 1
+ * to `lz_block_size`, and `checksum` is the 32-bit FNV-1a hash of the original
+ * bytes. If `stored_size` equals `raw_size` the block is stored as-is since it
+ * did not compress, otherwise it is a sequence of LZ4-style commands:
+ *
+ *    command := token [literal_ext] literals [offset [match_ext]]
+ *
+ * The high nibble of the one-byte token is the literal count and the low
+ * nibble is the match length minus 4, where a nibble of 15 is followed by
+ * extension bytes that are added to it, up to and including the first byte
+ * that is not 255. The 2-byte offset is the distance back to the start of the
+ * match. The last command of a block has literals only.
+ */
+
+#ifndef PDHKR_LZ_HH_
+#define PDHKR_LZ_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr {
+
+/**
+ * Magic bytes at the start of a compressed file.
+ */
+inline constexpr std::string_view lz_magic{"PDLZ"};
+
+/**
+ * Max number of original bytes in a block.
+ */
+inline constexpr std::size_t lz_block_size = 1U << 16;
+
+/**
+ * Size of a block header.
+ */
+inline constexpr std::size_t lz_header_size = 12;
+
+/**
+ * File name suffix used for compressed files.
+ */
+inline constexpr std::string_view lz_suffix{".lz"};
+
+namespace detail {
+
+/**
+ * Min match length, which is also the number of bytes hashed to find matches.
+ */
+inline constexpr std::size_t lz_min_match = 4;
+
+/**
+ * Read a little-endian 32-bit unsigned integer.
+ */
+inline std::uint32_t lz_load_u32(const char* data) noexcept
+{
+  std::uint32_t value = 0;
+  for (unsigned int i = 0; i < 4; i++)
+    value |= std::uint32_t{static_cast<unsigned char>(data[i])} << (8 * i);
+  return value;
+}
+
+/**
+ * Append a little-endian 32-bit unsigned integer.
+ */
+inline void lz_store_u32(std::string& out, std::uint32_t value)
+{
+  for (unsigned int i = 0; i < 4; i++)
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+/**
+ * Append a length nibble's extension bytes.
+ *
+ * @param out Output buffer
+ * @param length Length minus the nibble value of 15
+ */
+inline void lz_store_length(std::string& out, std::size_t length)
+{
+  for (; length >= 255; length -= 255)
+    out.push_back(static_cast<char>(255));
+  out.push_back(static_cast<char>(length));
+}
+
+/**
+ * Report a corrupt compressed file.
+ */
+[[noreturn]] inline void lz_corrupt()
+{
+  throw_error<std::runtime_error>("Corrupt compressed data");
+}
+
+}  // namespace detail
+
+/**
+ * Return the 32-bit FNV-1a hash of some bytes.
+ *
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ */
+inline std::uint32_t lz_checksum(const char* data, std::size_t size) noexcept
+{
+  std::uint32_t hash = 2166136261U;
+  for (std::size_t i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+/**
+ * Compress a block and append it, with its header, to an output buffer.
+ *
+ * Matches are found greedily with a single-entry hash table of the last
+ * position each 4-byte sequence hash was seen at, as in LZ4's fast mode.
+ *
+ * @param data Original bytes
+ * @param size Number of bytes, from 1 to `lz_block_size`
+ * @param out Output buffer
+ */
+inline void lz_compress_block(
+  const char* data, std::size_t size, std::string& out)
+{
+  using detail::lz_min_match;
+  constexpr unsigned int hash_bits = 13;
+  constexpr std::uint32_t no_pos = ~std::uint32_t{};
+  std::vector<std::uint32_t> table(std::size_t{1} << hash_bits, no_pos);
+  std::string compressed;
+  compressed.reserve(size + size / 255 + 16);
+  // append a command with the given literals and match, if any
+  auto emit = [&compressed](
+    const char* literals, std::size_t n_literals,
+    std::size_t offset, std::size_t match_length)
+  {
+    auto literal_nibble = std::min<std::size_t>(n_literals, 15);
+    std::size_t match_nibble = 0;
+    if (match_length)
+      match_nibble = std::min<std::size_t>(match_length - lz_min_match, 15);
+    compressed.push_back(
+      static_cast<char>((literal_nibble << 4) | match_nibble)
+    );
+    if (literal_nibble == 15)
+      detail::lz_store_length(compressed, n_literals - 15);
+    compressed.append(literals, n_literals);
+    if (!match_length)
+      return;
+    compressed.push_back(static_cast<char>(offset & 0xff));
+    compressed.push_back(static_cast<char>(offset >> 8));
+    if (match_nibble == 15)
+      detail::lz_store_length(compressed, match_length - lz_min_match - 15);
+  };
+  std::size_t anchor = 0;
+  std::size_t i = 0;
+  while (i + lz_min_match <= size) {
+    std::uint32_t sequence;
+    std::memcpy(&sequence, data + i, sizeof sequence);
+    auto hash = (sequence * 2654435761U) >> (32 - hash_bits);
+    auto candidate = table[hash];
+    table[hash] = static_cast<std::uint32_t>(i);
+    if (
+      candidate == no_pos ||
+      std::memcmp(data + candidate, data + i, lz_min_match)
+    ) {
+      i++;
+      continue;
+    }
+    // extend the match as far as possible
+    auto length = lz_min_match;
+    while (i + length < size && data[candidate + length] == data[i + length])
+      length++;
+    emit(data + anchor, i - anchor, i - candidate, length);
+    i += length;
+    anchor = i;
+  }
+  emit(data + anchor, size - anchor, 0, 0);
+  // header, storing the block as-is if it did not compress
+  detail::lz_store_u32(out, static_cast<std::uint32_t>(size));
+  auto stored = (compressed.size() < size) ?
+    std::string_view{compressed} : std::string_view{data, size};
+  detail::lz_store_u32(out, static_cast<std::uint32_t>(stored.size()));
+  detail::lz_store_u32(out, lz_checksum(data, size));
+  out.append(stored);
+}
+
+/**
+ * Decompress a block.
+ *
+ * @param stored Stored block bytes, excluding the header
+ * @param stored_size Number of stored bytes
+ * @param out Output buffer with room for `raw_size` bytes
+ * @param raw_size Original block size from the header
+ * @param checksum Original block checksum from the header
+ */
+inline void lz_decompress_block(
+  const char* stored,
+  std::size_t stored_size,
+  char* out,
+  std::size_t raw_size,
+  std::uint32_t checksum)
+{
+  if (stored_size == raw_size)
+    std::memcpy(out, stored, raw_size);
+  else {
+    auto in = reinterpret_cast<const unsigned char*>(stored);
+    auto in_end = in + stored_size;
+    std::size_t pos = 0;
+    // read a length nibble's extension bytes
+    auto read_length = [&in, in_end](std::size_t nibble)
+    {
+      if (nibble != 15)
+        return nibble;
+      for (;;) {
+        if (in == in_end)
+          detail::lz_corrupt();
+        auto byte = *in++;
+        nibble += byte;
+        if (byte != 255)
+          return nibble;
+      }
+    };
+    while (in != in_end) {
+      auto token = *in++;
+      auto n_literals = read_length(token >> 4);
+      if (n_literals > static_cast<std::size_t>(in_end - in) ||
+          n_literals > raw_size - pos)
+        detail::lz_corrupt();
+      std::memcpy(out + pos, in, n_literals);
+      in += n_literals;
+      pos += n_literals;
+      // last command has no match
+      if (in == in_end)
+        break;
+      if (in_end - in < 2)
+        detail::lz_corrupt();
+      std::size_t offset = in[0] | (in[1] << 8);
+      in += 2;
+      auto length = read_length(token & 0xf) + detail::lz_min_match;
+      if (!offset || offset > pos || length > raw_size - pos)
+        detail::lz_corrupt();
+      // byte by byte since the match may overlap the bytes being written
+      for (auto end = pos + length; pos < end; pos++)
+        out[pos] = out[pos - offset];
+    }
+    if (pos != raw_size)
+      detail::lz_corrupt();
+  }
+  if (lz_checksum(out, raw_size) != checksum)
+    detail::lz_corrupt();
+}
+
+/**
+ * Compress a stream into a compressed file.
+ *
+ * @param in Input stream
+ * @param out Output stream
+ */
+inline void lz_compress(std::istream& in, std::ostream& out)
+{
+  std::vector<char> block(lz_block_size);
+  std::string compressed{lz_magic};
+  while (in) {
+    in.read(block.data(), static_cast<std::streamsize>(block.size()));
+    auto size = static_cast<std::size_t>(in.gcount());
+    if (!size)
+      break;
+    lz_compress_block(block.data(), size, compressed);
+    out.write(
+      compressed.data(), static_cast<std::streamsize>(compressed.size())
+    );
+    compressed.clear();
+  }
+  detail::lz_store_u32(compressed, 0);
+  out.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+}
+
+/**
+ * Return `true` if some bytes start with the compressed file magic.
+ *
+ * @param data Bytes, e.g. an entire file
+ */
+inline bool lz_compressed(std::string_view data) noexcept
+{
+  return data.substr(0, lz_magic.size()) == lz_magic;
+}
+
+/**
+ * Decompress an entire compressed file in memory.
+ *
+ * @param data Compressed file contents, including the magic
+ */
+inline std::string lz_decompress(std::string_view data)
+{
+  if (!lz_compressed(data))
+    detail::lz_corrupt();
+  data.remove_prefix(lz_magic.size());
+  std::string out;
+  for (;;) {
+    if (data.size() < 4)
+      detail::lz_corrupt();
+    auto raw_size = detail::lz_load_u32(data.data());
+    if (!raw_size)
+      break;
+    if (data.size() < lz_header_size || raw_size > lz_block_size)
+      detail::lz_corrupt();
+    auto stored_size = detail::lz_load_u32(data.data() + 4);
+    auto checksum = detail::lz_load_u32(data.data() + 8);
+    data.remove_prefix(lz_header_size);
+    if (stored_size > data.size() || stored_size > raw_size)
+      detail::lz_corrupt();
+    auto pos = out.size();
+    out.resize(pos + raw_size);
+    lz_decompress_block(
+      data.data(), stored_size, out.data() + pos, raw_size, checksum
+    );
+    data.remove_prefix(stored_size);
+  }
+  return out;
+}
+
+/**
+ * Stream buffer decompressing a compressed file one block at a time.
+ *
+ * The magic must already have been consumed from the source.
+ */
+class lz_streambuf : public std::streambuf {
+public:
+  /**
+   * Ctor.
+   *
+   * @param source Source of the compressed blocks, which must outlive this
+   */
+  explicit lz_streambuf(std::streambuf* source)
+    : source_{source}, block_(lz_block_size)
+  {}
+
+protected:
+  /**
+   * Decompress the next block into the get area.
+   */
+  int_type underflow() override
+  {
+    if (gptr() < egptr())
+      return traits_type::to_int_type(*gptr());
+    if (done_)
+      return traits_type::eof();
+    char header[lz_header_size];
+    read(header, 4);
+    auto raw_size = detail::lz_load_u32(header);
+    if (!raw_size) {
+      done_ = true;
+      return traits_type::eof();
+    }
+    if (raw_size > lz_block_size)
+      detail::lz_corrupt();
+    read(header + 4, lz_header_size - 4);
+    auto stored_size = detail::lz_load_u32(header + 4);
+    if (stored_size > raw_size)
+      detail::lz_corrupt();
+    stored_.resize(stored_size);
+    read(stored_.data(), stored_size);
+    lz_decompress_block(
+      stored_.data(),
+      stored_size,
+      block_.data(),
+      raw_size,
+      detail::lz_load_u32(header + 8)
+    );
+    setg(block_.data(), block_.data(), block_.data() + raw_size);
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+  std::streambuf* source_;
+  std::vector<char> block_;
+  std::vector<char> stored_;
+  bool done_{};
+
+  /**
+   * Read exactly the given number of bytes from the source.
+   */
+  void read(char* data, std::size_t size)
+  {
+    auto n_read = source_->sgetn(data, static_cast<std::streamsize>(size));
+    if (n_read != static_cast<std::streamsize>(size))
+      detail::lz_corrupt();
+  }
+};
+
+/**
+ * Input file stream that transparently decompresses compressed files.
+ *
+ * If the file does not exist but the file with `lz_suffix` appended does, that
+ * is opened instead, so a data file can be replaced by its compressed version
+ * without changing the path it is opened with. Files without the magic are
+ * read as-is.
+ */
+class lz_ifstream : public std::istream {
+public:
+  /**
+   * Ctor.
+   *
+   * @param path File path
+   */
+  explicit lz_ifstream(const std::string& path)
+    : std::istream{nullptr}, lz_buf_{&file_}
+  {
+    if (!file_.open(path, std::ios_base::in | std::ios_base::binary) &&
+        !file_.open(
+          path + std::string{lz_suffix},
+          std::ios_base::in | std::ios_base::binary
+        )) {
+      setstate(std::ios_base::failbit);
+      return;
+    }
+    // check for the magic, rewinding if it is not there
+    char magic[lz_magic.size()];
+    auto n_read = file_.sgetn(magic, sizeof magic);
+    if (lz_compressed({magic, static_cast<std::size_t>(n_read)}))
+      rdbuf(&lz_buf_);
+    else {
+      file_.pubseekpos(0, std::ios_base::in);
+      rdbuf(&file_);
+    }
+  }
+
+private:
+  std::filebuf file_;
+  lz_streambuf lz_buf_;
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_LZ_HH_
@@ -0,0 +1,188 @@
+/**
+ * @file mapped_input.hh
+ * @author Derek Huang
+ * @brief C++ header for reading entire inputs as contiguous memory
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_MAPPED_INPUT_HH_
+#define PDHKR_MAPPED_INPUT_HH_
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "pdhkr/error.hh"
+#include "pdhkr/lz.hh"
+
+// POSIX memory mapping
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace pdhkr {
+
+/**
+ * Read-only view of an entire input file or standard input.
+ *
+ * On POSIX systems a regular file is memory mapped, so no copy is made and
+ * pages are only read in as they are touched. Otherwise, e.g. for pipes or on
+ * Windows, the input is read into an owned buffer.
+ *
+ * Compressed inputs, see `lz.hh`, are decompressed into the owned buffer. As
+ * with `lz_ifstream`, if a file does not exist, its `.lz` version is used.
+ */
+class mapped_input {
+public:
+  /**
+   * Ctor.
+   *
+   * Map or read all of standard input.
+   */
+  mapped_input()
+  {
+#ifndef _WIN32
+    auto mapped = map(STDIN_FILENO);
+#else
+    auto mapped = false;
+#endif  // _WIN32
+    if (!mapped)
+      read(stdin);
+    decompress();
+  }
+
+  /**
+   * Ctor.
+   *
+   * Map or read all of the given file.
+   *
+   * @param path File path
+   */
+  explicit mapped_input(const char* path)
+  {
+    std::string lz_path{path};
+    lz_path += lz_suffix;
+#ifndef _WIN32
+    auto fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+      fd = ::open(lz_path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw_error<std::runtime_error>(std::string{"Cannot open "} + path);
+    auto mapped = map(fd);
+    ::close(fd);
+    if (mapped) {
+      decompress();
+      return;
+    }
+#endif  // _WIN32
+    auto f = std::fopen(path, "rb");
+    if (!f)
+      f = std::fopen(lz_path.c_str(), "rb");
+    if (!f)
+      throw_error<std::runtime_error>(std::string{"Cannot open "} + path);
+    read(f);
+    std::fclose(f);
+    decompress();
+  }
+
+  mapped_input(const mapped_input&) = delete;
+  mapped_input& operator=(const mapped_input&) = delete;
+
+  /**
+   * Dtor.
+   */
+  ~mapped_input()
+  {
+    unmap();
+  }
+
+  /**
+   * Return a view of the input contents.
+   */
+  std::string_view view() const noexcept
+  {
+    if (mapping_)
+      return {static_cast<const char*>(mapping_), size_};
+    return buffer_;
+  }
+
+private:
+  // mapped address and size if memory mapped
+  void* mapping_{};
+  std::size_t size_{};
+  // owned copy if not memory mapped
+  std::string buffer_;
+
+#ifndef _WIN32
+  /**
+   * Memory map a regular file from its file descriptor.
+   *
+   * @returns `true` on success, `false` if not a non-empty regular file or if
+   *  mapping failed, in which case the input should be read instead
+   */
+  bool map(int fd)
+  {
+    struct stat info;
+    if (::fstat(fd, &info) || !S_ISREG(info.st_mode) || !info.st_size)
+      return false;
+    auto size = static_cast<std::size_t>(info.st_size);
+    auto mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+      return false;
+    // input is read sequentially and exactly once
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+    mapping_ = mapping;
+    size_ = size;
+    return true;
+  }
+#endif  // _WIN32
+
+  /**
+   * Unmap the input if it is memory mapped.
+   */
+  void unmap() noexcept
+  {
+#ifndef _WIN32
+    if (mapping_)
+      ::munmap(mapping_, size_);
+#endif  // _WIN32
+    mapping_ = nullptr;
+    size_ = 0;
+  }
+
+  /**
+   * Replace a compressed input with its decompressed contents.
+   */
+  void decompress()
+  {
+    auto input = view();
+    if (!lz_compressed(input))
+      return;
+    auto contents = lz_decompress(input);
+    unmap();
+    buffer_ = std::move(contents);
+  }
+
+  /**
+   * Read the rest of a C stream into the owned buffer.
+   *
+   * @param f C stream
+   */
+  void read(std::FILE* f)
+  {
+    char chunk[1 << 16];
+    std::size_t n_read;
+    while ((n_read = std::fread(chunk, 1, sizeof chunk, f)))
+      buffer_.append(chunk, n_read);
+  }
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_MAPPED_INPUT_HH_
@@ -0,0 +1,236 @@
+/**
+ * @file parallel_components.hh
+ * @author Derek Huang
+ * @brief C++ header for parallel connected components of undirected graphs
+ * @copyright MIT License
+ *
+ * `parallel_component_sizes` labels the connected components of a `csr_graph`
+ * on a `thread_pool` using the Afforest algorithm of Sutton, Ben-Nun, and
+ * Barak. Every node starts as its own tree, and each edge is linked by hooking
+ * the higher of its two roots onto the lower one with a compare-and-swap, so
+ * threads can link edges concurrently without locks. The trees are flattened
+ * by pointer jumping between rounds.
+ *
+ * Most real graphs have one giant component, so only the first few neighbors
+ * of each node are linked at first. A random sample of nodes then identifies
+ * the component that is probably the giant one, and its nodes skip the rest of
+ * their neighbors, since any edge leaving the giant component is also linked
+ * from its other end. This skips most of the edges of graphs like power-law
+ * graphs, while BFS has to read all of them on a single thread.
+ */
+
+#ifndef PDHKR_PARALLEL_COMPONENTS_HH_
+#define PDHKR_PARALLEL_COMPONENTS_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "pdhkr/graph.hh"
+#include "pdhkr/thread_pool.hh"
+
+namespace pdhkr {
+
+namespace detail {
+
+/**
+ * Link the trees of two nodes by hooking the higher root onto the lower one.
+ *
+ * Since a node only ever points at a lower node, the trees stay acyclic. The
+ * loads and stores are relaxed since trees are only read for their final
+ * shape after `thread_pool::parallel_for` returns, which synchronizes.
+ *
+ * @param labels Parent of each node, with roots being their own parents
+ * @param u First node of the edge
+ * @param v Second node of the edge
+ */
+template <typename Index>
+void afforest_link(std::vector<std::atomic<Index>>& labels, Index u, Index v)
+{
+  constexpr auto relaxed = std::memory_order_relaxed;
+  auto p1 = labels[u].load(relaxed);
+  auto p2 = labels[v].load(relaxed);
+  while (p1 != p2) {
+    auto high = std::max(p1, p2);
+    auto low = std::min(p1, p2);
+    auto p_high = labels[high].load(relaxed);
+    // already linked, or high is a root that we managed to hook onto low
+    if (p_high == low)
+      return;
+    if (p_high == high && labels[high].compare_exchange_strong(p_high, low))
+      return;
+    // lost a race or high is not a root, so retry one level further up
+    p1 = labels[labels[high].load(relaxed)].load(relaxed);
+    p2 = labels[low].load(relaxed);
+  }
+}
+
+/**
+ * Point every node in `[first, last)` directly at its root.
+ *
+ * @param labels Parent of each node, with roots being their own parents
+ * @param first First node
+ * @param last One past the last node
+ */
+template <typename Index>
+void afforest_compress(
+  std::vector<std::atomic<Index>>& labels, std::size_t first, std::size_t last)
+{
+  constexpr auto relaxed = std::memory_order_relaxed;
+  for (auto i = first; i < last; i++) {
+    auto label = labels[i].load(relaxed);
+    while (label != labels[label].load(relaxed))
+      label = labels[label].load(relaxed);
+    labels[i].store(label, relaxed);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Number of nodes sampled to find the most frequent component label.
+ */
+inline constexpr std::size_t afforest_samples = 1024U;
+
+/**
+ * Return the sizes of the connected components of an undirected graph.
+ *
+ * The Afforest algorithm links each node with its first `neighbor_rounds`
+ * neighbors, one neighbor per round, and then finds the most frequent
+ * component among `afforest_samples` random nodes. Only nodes outside that
+ * component then link their remaining neighbors. Each phase is a
+ * `parallel_for` over the nodes on the given pool, so with `P` threads the
+ * expected time is O((V + E) / P) for graphs with a giant component.
+ *
+ * @tparam Index Unsigned node index type of the graph
+ *
+ * @param graph Undirected graph, i.e. with arcs in both directions
+ * @param pool Thread pool to run on
+ * @param neighbor_rounds Number of neighbors of each node linked before
+ *  sampling, where 2 is usually enough to form the giant component
+ * @returns Component sizes in unspecified order
+ */
+template <typename Index>
+std::vector<Index> parallel_component_sizes(
+  const csr_graph<Index>& graph,
+  thread_pool& pool = thread_pool::default_pool(),
+  std::size_t neighbor_rounds = 2U)
+{
+  constexpr auto relaxed = std::memory_order_relaxed;
+  auto n_nodes = graph.n_nodes();
+  if (!n_nodes)
+    return {};
+  // std::atomic is not value-initialized before C++20 so stores are explicit
+  std::vector<std::atomic<Index>> labels(n_nodes);
+  pool.parallel_for(
+    0,
+    n_nodes,
+    [&labels](std::size_t first, std::size_t last)
+    {
+      for (auto i = first; i < last; i++)
+        labels[i].store(static_cast<Index>(i), relaxed);
+    }
+  );
+  auto compress = [&labels](std::size_t first, std::size_t last)
+  {
+    detail::afforest_compress(labels, first, last);
+  };
+  // link each node with one more of its neighbors per round
+  for (std::size_t round = 0; round < neighbor_rounds; round++) {
+    pool.parallel_for(
+      0,
+      n_nodes,
+      [&graph, &labels, round](std::size_t first, std::size_t last)
+      {
+        for (auto i = first; i < last; i++) {
+          auto neighbors = graph.neighbors(static_cast<Index>(i));
+          if (round < neighbors.size())
+            detail::afforest_link(
+              labels, static_cast<Index>(i), neighbors.begin()[round]
+            );
+        }
+      }
+    );
+    pool.parallel_for(0, n_nodes, compress);
+  }
+  // most frequent root among the sampled nodes. the seed is fixed so that
+  // runs are repeatable, and the result is correct for any sample anyway
+  std::vector<Index> sample(afforest_samples);
+  std::mt19937_64 rng{n_nodes};
+  for (auto& label : sample)
+    label = labels[rng() % n_nodes].load(relaxed);
+  std::sort(sample.begin(), sample.end());
+  auto giant = sample.front();
+  std::size_t giant_count = 0;
+  for (std::size_t i = 0, j = 0; i < sample.size(); i = j) {
+    while (j < sample.size() && sample[j] == sample[i])
+      j++;
+    if (j - i > giant_count) {
+      giant = sample[i];
+      giant_count = j - i;
+    }
+  }
+  // link the remaining neighbors of the nodes outside the giant component
+  pool.parallel_for(
+    0,
+    n_nodes,
+    [&graph, &labels, giant, neighbor_rounds](
+      std::size_t first, std::size_t last)
+    {
+      for (auto i = first; i < last; i++) {
+        if (labels[i].load(relaxed) == giant)
+          continue;
+        auto neighbors = graph.neighbors(static_cast<Index>(i));
+        for (auto j = neighbor_rounds; j < neighbors.size(); j++)
+          detail::afforest_link(
+            labels, static_cast<Index>(i), neighbors.begin()[j]
+          );
+      }
+    }
+  );
+  pool.parallel_for(0, n_nodes, compress);
+  // the sampled root may have been hooked onto a lower one since
+  giant = labels[giant].load(relaxed);
+  // count the nodes of each root. the giant component is counted locally so
+  // that the threads do not all contend for its counter
+  std::vector<std::atomic<Index>> counts(n_nodes);
+  pool.parallel_for(
+    0,
+    n_nodes,
+    [&counts](std::size_t first, std::size_t last)
+    {
+      for (auto i = first; i < last; i++)
+        counts[i].store(0, relaxed);
+    }
+  );
+  std::atomic<std::size_t> n_giant{};
+  pool.parallel_for(
+    0,
+    n_nodes,
+    [&labels, &counts, &n_giant, giant](std::size_t first, std::size_t last)
+    {
+      std::size_t local_giant = 0;
+      for (auto i = first; i < last; i++) {
+        auto label = labels[i].load(relaxed);
+        if (label == giant)
+          local_giant++;
+        else
+          counts[label].fetch_add(1, relaxed);
+      }
+      n_giant.fetch_add(local_giant, relaxed);
+    }
+  );
+  counts[giant].fetch_add(static_cast<Index>(n_giant.load()), relaxed);
+  std::vector<Index> sizes;
+  for (std::size_t i = 0; i < n_nodes; i++)
+    if (labels[i].load(relaxed) == i)
+      sizes.push_back(counts[i].load(relaxed));
+  return sizes;
+}
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_PARALLEL_COMPONENTS_HH_
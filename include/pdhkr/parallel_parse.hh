@@ -0,0 +1,163 @@
+/**
+ * @file parallel_parse.hh
+ * @author Derek Huang
+ * @brief C++ header for parsing integer inputs in parallel
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_PARALLEL_PARSE_HH_
+#define PDHKR_PARALLEL_PARSE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "pdhkr/thread.hh"
+#include "pdhkr/thread_pool.hh"
+
+namespace pdhkr {
+
+/**
+ * Minimum number of bytes each thread parses in `parse_integers`.
+ *
+ * Smaller inputs use fewer chunks since handing off a chunk to another thread
+ * costs more than parsing this many bytes.
+ */
+inline constexpr std::size_t parse_chunk_min_size = 1U << 16;
+
+/**
+ * Parse all the whitespace-separated integers in a chunk of text.
+ *
+ * Any character that is not a digit, or a minus sign for signed `T`, is a
+ * separator. No overflow checking is done.
+ *
+ * @tparam T Integral type
+ *
+ * @param text Text to parse
+ * @param values Vector to append parsed values to
+ */
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+void parse_integers(std::string_view text, std::vector<T>& values)
+{
+  auto it = text.begin();
+  auto end = text.end();
+  while (true) {
+    // skip to start of next value
+    while (
+      it != end &&
+      !(*it >= '0' && *it <= '9') &&
+      !(std::is_signed_v<T> && *it == '-')
+    )
+      it++;
+    if (it == end)
+      return;
+    // sign
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+      if (*it == '-') {
+        negative = true;
+        it++;
+      }
+    }
+    // digits
+    T value = 0;
+    for (; it != end && *it >= '0' && *it <= '9'; it++)
+      value = static_cast<T>(10 * value + (*it - '0'));
+    values.push_back((negative) ? static_cast<T>(-value) : value);
+  }
+}
+
+/**
+ * Parse all the whitespace-separated integers in some text in parallel.
+ *
+ * The text is split into per-thread chunks at whitespace boundaries so no
+ * value straddles two chunks. The chunks are parsed into their own vectors on
+ * the default `thread_pool` and the vectors are then copied in parallel into
+ * one flat vector, so the result is the same as parsing the text serially.
+ *
+ * @tparam T Integral type
+ *
+ * @param text Text to parse, e.g. from a `mapped_input`
+ * @param n_threads Maximum number of threads to use, by default the value of
+ *  `thread_count()`. Inputs smaller than `parse_chunk_min_size` bytes per
+ *  thread use fewer threads, with 1 parsing on the calling thread.
+ */
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto parse_integers(
+  std::string_view text, unsigned int n_threads = thread_count())
+{
+  // number of chunks, at least 1
+  auto n_chunks = static_cast<unsigned int>(
+    std::max<std::size_t>(
+      1U,
+      std::min<std::size_t>(n_threads, text.size() / parse_chunk_min_size)
+    )
+  );
+  std::vector<T> values;
+  // parse serially on calling thread
+  if (n_chunks == 1) {
+    // guess about two bytes per value, e.g. single digit + separator
+    values.reserve(text.size() / 2);
+    parse_integers(text, values);
+    return values;
+  }
+  // chunk boundaries, each moved forward past any value it lands in so that
+  // chunks do not split values. boundaries may coincide, giving empty chunks
+  std::vector<std::size_t> bounds(n_chunks + 1);
+  bounds[n_chunks] = text.size();
+  for (decltype(n_chunks) i = 1; i < n_chunks; i++) {
+    auto pos = std::max(bounds[i - 1], text.size() / n_chunks * i);
+    while (
+      pos > 0 && pos < text.size() &&
+      ((text[pos - 1] >= '0' && text[pos - 1] <= '9') || text[pos - 1] == '-')
+    )
+      pos++;
+    bounds[i] = pos;
+  }
+  // parse each chunk into its own vector
+  auto& pool = thread_pool::default_pool();
+  std::vector<std::vector<T>> chunk_values(n_chunks);
+  pool.parallel_for(
+    0,
+    n_chunks,
+    [&](std::size_t first, std::size_t last)
+    {
+      for (auto i = first; i < last; i++) {
+        auto chunk = text.substr(bounds[i], bounds[i + 1] - bounds[i]);
+        chunk_values[i].reserve(chunk.size() / 2);
+        parse_integers(chunk, chunk_values[i]);
+      }
+    },
+    1
+  );
+  // offsets of each chunk's values in the flat vector
+  std::vector<std::size_t> offsets(n_chunks + 1);
+  for (decltype(n_chunks) i = 0; i < n_chunks; i++)
+    offsets[i + 1] = offsets[i] + chunk_values[i].size();
+  // stitch together, again in parallel
+  values.resize(offsets[n_chunks]);
+  pool.parallel_for(
+    0,
+    n_chunks,
+    [&](std::size_t first, std::size_t last)
+    {
+      for (auto i = first; i < last; i++) {
+        std::copy(
+          chunk_values[i].begin(),
+          chunk_values[i].end(),
+          values.begin() + offsets[i]
+        );
+        // release memory as soon as possible
+        chunk_values[i] = {};
+      }
+    },
+    1
+  );
+  return values;
+}
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_PARALLEL_PARSE_HH_
@@ -0,0 +1,118 @@
+/**
+ * @file pipeline.hh
+ * @author Derek Huang
+ * @brief C++ header for pipelining parsing, solving, and writing of queries
+ * @copyright MIT License
+ *
+ * Query-stream problems parse a query, execute it against some state, and
+ * possibly write a result, all on one thread. `pipeline_queries` instead parses
+ * queries on one thread and writes results on another, passing fixed-size
+ * records through `spsc_queue` ring buffers to and from the calling thread that
+ * executes the queries in order. For long streams the throughput approaches
+ * that of the slowest stage instead of that of all three stages combined.
+ */
+
+#ifndef PDHKR_PIPELINE_HH_
+#define PDHKR_PIPELINE_HH_
+
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "pdhkr/spsc_queue.hh"
+#include "pdhkr/thread.hh"
+
+namespace pdhkr {
+
+/**
+ * Parse, execute, and write the results of a stream of queries.
+ *
+ * Queries are executed on the calling thread strictly in input order, each
+ * emitting zero or more results that are written in the order emitted. With
+ * 3+ threads, parsing and writing each get their own thread. With 2 threads,
+ * only parsing does and results are written on the calling thread. With 1
+ * thread, no threads are started and each query is parsed, executed, and has
+ * its results written in turn, exactly as a serial loop would.
+ *
+ * @note Since parsing and writing may happen on different threads, if the input
+ *  stream is tied to the output stream, e.g. `std::cin` and `std::cout`, it
+ *  must be untied first so that reading does not flush the output stream.
+ *
+ * @tparam Output Result type
+ * @tparam Parser Callable with signature `Query()` parsing the next query
+ * @tparam Solver Callable with signature `void(Query&, Emit&)`, where `Emit` is
+ *  callable with an `Output` to emit a result, executing a query
+ * @tparam Writer Callable with signature `void(Output&)` writing a result
+ *
+ * @param n_queries Number of queries to parse
+ * @param parse Query parser
+ * @param solve Query executor
+ * @param write Result writer
+ * @param n_threads Number of threads to use, by default `thread_count()`
+ */
+template <typename Output, typename Parser, typename Solver, typename Writer>
+void pipeline_queries(
+  std::size_t n_queries,
+  Parser&& parse,
+  Solver&& solve,
+  Writer&& write,
+  unsigned int n_threads = thread_count())
+{
+  using query_type = std::decay_t<std::invoke_result_t<Parser&>>;
+  // write results on the calling thread
+  auto write_inline = [&write](Output result) { write(result); };
+  // serial fallback
+  if (n_threads <= 1 || n_queries <= 1) {
+    for (decltype(n_queries) i = 0; i < n_queries; i++) {
+      auto query = parse();
+      solve(query, write_inline);
+    }
+    return;
+  }
+  // parsing stage. exactly n_queries queries are pushed
+  spsc_queue<query_type> queries;
+  std::thread parser{
+    [&]
+    {
+      for (decltype(n_queries) i = 0; i < n_queries; i++)
+        queries.push(parse());
+    }
+  };
+  // solve on the calling thread, writing results directly
+  if (n_threads == 2) {
+    for (decltype(n_queries) i = 0; i < n_queries; i++) {
+      auto query = queries.pop();
+      solve(query, write_inline);
+    }
+    parser.join();
+    return;
+  }
+  // writing stage. an empty optional marks the end of the results
+  spsc_queue<std::optional<Output>> results;
+  std::thread writer{
+    [&]
+    {
+      while (true) {
+        auto result = results.pop();
+        if (!result)
+          return;
+        write(*result);
+      }
+    }
+  };
+  // execute queries, sending results to the writer
+  auto emit = [&results](Output result) { results.push(std::move(result)); };
+  for (decltype(n_queries) i = 0; i < n_queries; i++) {
+    auto query = queries.pop();
+    solve(query, emit);
+  }
+  results.push(std::optional<Output>{});
+  parser.join();
+  writer.join();
+}
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_PIPELINE_HH_
@@ -0,0 +1,681 @@
+/**
+ * @file profile.hh
+ * @author Derek Huang
+ * @brief C++ header for timing the phases of a program
+ * @copyright MIT License
+ *
+ * If the `PDHKR_PROFILE` environment variable is set to a nonzero value, the
+ * wall and CPU time spent in the standard program phases, i.e. parsing input,
+ * building data structures, solving, formatting output, and comparing against
+ * the expected output, is accumulated and written to `std::cerr` as one line
+ * per phase when the program exits. Otherwise marking a phase only costs a
+ * check of a cached flag.
+ *
+ * Programs mark phases with `PDHKR_PROFILE_PHASE`, which ends the calling
+ * thread's current phase and starts another, and `PDHKR_PROFILE_SCOPE`, which
+ * times the rest of the enclosing scope and pauses any phase it interrupts, so
+ * time is only ever counted against the innermost phase. Switching phases
+ * inside a scope only changes the phase the rest of the scope is timed as,
+ * which lets code shared by the serial loops and the worker threads of the
+ * parallel variants mark its own phases. `PDHKR_PROFILE_DETAIL` additionally
+ * times one step within a phase, e.g. building one data structure, and
+ * `PDHKR_PROFILE_MEMORY` attaches a memory size to it, both written after the
+ * phase lines. The submissions define the macros they use as empty when built
+ * without `PDHKR_TEST` or `PDHKR_LOCAL`, so the HackerRank builds do not
+ * include this header.
+ */
+
+#ifndef PDHKR_PROFILE_HH_
+#define PDHKR_PROFILE_HH_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // NOMINMAX
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif  // WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif  // _WIN32
+
+#include "pdhkr/common.h"
+
+namespace pdhkr {
+
+/**
+ * Standard program phase.
+ */
+enum class profile_phase : unsigned int {
+  parse,
+  build,
+  solve,
+  output,
+  compare
+};
+
+/**
+ * Number of standard program phases.
+ */
+inline constexpr std::size_t profile_phase_count = 5U;
+
+/**
+ * Return the name of a program phase.
+ *
+ * @param phase Program phase
+ */
+constexpr std::string_view profile_phase_name(profile_phase phase) noexcept
+{
+  switch (phase) {
+    case profile_phase::parse:
+      return "parse";
+    case profile_phase::build:
+      return "build";
+    case profile_phase::solve:
+      return "solve";
+    case profile_phase::output:
+      return "output";
+    case profile_phase::compare:
+      return "compare";
+  }
+  return "unknown";
+}
+
+/**
+ * Wall and CPU time in nanoseconds at a point in time.
+ *
+ * CPU time is either that of the calling thread or of the whole process.
+ */
+struct profile_sample {
+  std::uint64_t wall_nsec;
+  std::uint64_t cpu_nsec;
+};
+
+namespace detail {
+
+/**
+ * Return the steady clock time in nanoseconds.
+ */
+inline std::uint64_t profile_wall_nsec() noexcept
+{
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()
+    ).count()
+  );
+}
+
+#ifdef _WIN32
+/**
+ * Return the sum of the kernel and user times reported in 100 ns units.
+ *
+ * @param kernel_time Kernel time
+ * @param user_time User time
+ */
+inline std::uint64_t profile_filetime_nsec(
+  const FILETIME& kernel_time, const FILETIME& user_time) noexcept
+{
+  auto to_ticks = [](const FILETIME& time)
+  {
+    return (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) |
+      time.dwLowDateTime;
+  };
+  return 100U * (to_ticks(kernel_time) + to_ticks(user_time));
+}
+#endif  // _WIN32
+
+/**
+ * Return the CPU time of the calling thread in nanoseconds.
+ */
+inline std::uint64_t profile_thread_cpu_nsec() noexcept
+{
+#if defined(_WIN32)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (
+    !GetThreadTimes(
+      GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time
+    )
+  )
+    return 0U;
+  return profile_filetime_nsec(kernel_time, user_time);
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time))
+    return 0U;
+  return 1000000000U * static_cast<std::uint64_t>(time.tv_sec) +
+    static_cast<std::uint64_t>(time.tv_nsec);
+#endif  // !defined(_WIN32)
+}
+
+/**
+ * Return the CPU time of all the process's threads in nanoseconds.
+ */
+inline std::uint64_t profile_process_cpu_nsec() noexcept
+{
+#if defined(_WIN32)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (
+    !GetProcessTimes(
+      GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time
+    )
+  )
+    return 0U;
+  return profile_filetime_nsec(kernel_time, user_time);
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time))
+    return 0U;
+  return 1000000000U * static_cast<std::uint64_t>(time.tv_sec) +
+    static_cast<std::uint64_t>(time.tv_nsec);
+#endif  // !defined(_WIN32)
+}
+
+}  // namespace detail
+
+/**
+ * Accumulator for the time spent in each program phase.
+ *
+ * Phases may be timed on any thread. The wall times of phases running
+ * concurrently on different threads add up, so with pipelined or parallel
+ * execution the phase wall times can sum to more than the total wall time.
+ */
+class profiler {
+public:
+  /**
+   * Return the global profiler, enabled by the `PDHKR_PROFILE` variable.
+   *
+   * The summary is written when the global profiler is destroyed on exit.
+   */
+  static profiler& global()
+  {
+    static profiler instance{env_enabled()};
+    return instance;
+  }
+
+  /**
+   * Ctor.
+   *
+   * @param enabled `true` to accumulate times and write the summary on exit
+   */
+  explicit profiler(bool enabled) noexcept
+    : enabled_{enabled},
+      start_{detail::profile_wall_nsec(), detail::profile_process_cpu_nsec()}
+  {}
+
+  profiler(const profiler&) = delete;
+  profiler& operator=(const profiler&) = delete;
+
+  /**
+   * Dtor.
+   *
+   * Writes the summary to `std::cerr` if enabled.
+   */
+  ~profiler()
+  {
+    if (enabled_)
+      write(std::cerr);
+  }
+
+  /**
+   * Indicate if times are being accumulated.
+   */
+  bool enabled() const noexcept
+  {
+    return enabled_;
+  }
+
+  /**
+   * Add time spent in a phase.
+   *
+   * @param phase Program phase
+   * @param elapsed Elapsed wall and thread CPU time
+   * @param entered `true` if this ends an entry into the phase
+   */
+  void add(
+    profile_phase phase,
+    const profile_sample& elapsed,
+    bool entered = true) noexcept
+  {
+    auto& totals = totals_[static_cast<std::size_t>(phase)];
+    totals.wall_nsec.fetch_add(elapsed.wall_nsec, std::memory_order_relaxed);
+    totals.cpu_nsec.fetch_add(elapsed.cpu_nsec, std::memory_order_relaxed);
+    if (entered)
+      totals.entries.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  /**
+   * Add time spent in a named detail, e.g. one step of a phase.
+   *
+   * Details are written after the phases in the order first added. Their
+   * time is also counted in whatever phase they ran in.
+   *
+   * @param name Detail name
+   * @param elapsed Elapsed wall and thread CPU time
+   */
+  void add_detail(std::string_view name, const profile_sample& elapsed)
+  {
+    std::lock_guard lock{details_mutex_};
+    auto& detail = find_detail(name);
+    detail.elapsed.wall_nsec += elapsed.wall_nsec;
+    detail.elapsed.cpu_nsec += elapsed.cpu_nsec;
+    detail.timed = true;
+  }
+
+  /**
+   * Add a memory size in bytes to a named detail.
+   *
+   * @param name Detail name
+   * @param bytes Memory size
+   */
+  void add_detail_memory(std::string_view name, std::size_t bytes)
+  {
+    std::lock_guard lock{details_mutex_};
+    find_detail(name).bytes += bytes;
+  }
+
+  /**
+   * Write one line per phase that was entered and a line with the totals.
+   *
+   * The total CPU time is that of the whole process, so it includes the time
+   * spent by worker threads outside any phase.
+   *
+   * @param out Stream to write to
+   */
+  void write(std::ostream& out) const
+  {
+    auto write_line = [&out](
+      std::string_view name, std::uint64_t wall, std::uint64_t cpu)
+    {
+      out << "pdhkr_profile: " << std::left << std::setw(8) << name <<
+        std::right << std::fixed << std::setprecision(3) << "wall " <<
+        std::setw(11) << 1e-6 * wall << " ms  cpu " << std::setw(11) <<
+        1e-6 * cpu << " ms";
+    };
+    for (std::size_t i = 0; i < profile_phase_count; i++) {
+      const auto& totals = totals_[i];
+      auto entries = totals.entries.load(std::memory_order_relaxed);
+      if (!entries)
+        continue;
+      write_line(
+        profile_phase_name(static_cast<profile_phase>(i)),
+        totals.wall_nsec.load(std::memory_order_relaxed),
+        totals.cpu_nsec.load(std::memory_order_relaxed)
+      );
+      out << "  entries " << entries << "\n";
+    }
+    {
+      std::lock_guard lock{details_mutex_};
+      for (const auto& entry : details_) {
+        if (entry.timed)
+          write_line(
+            entry.name, entry.elapsed.wall_nsec, entry.elapsed.cpu_nsec
+          );
+        else
+          out << "pdhkr_profile: " << std::left << std::setw(8) <<
+            entry.name << std::right;
+        if (entry.bytes)
+          out << "  memory " << entry.bytes << " bytes";
+        out << "\n";
+      }
+    }
+    write_line(
+      "total",
+      detail::profile_wall_nsec() - start_.wall_nsec,
+      detail::profile_process_cpu_nsec() - start_.cpu_nsec
+    );
+    out << std::endl;
+  }
+
+private:
+  /**
+   * Accumulated phase times and number of entries into the phase.
+   */
+  struct phase_totals {
+    std::atomic<std::uint64_t> wall_nsec{};
+    std::atomic<std::uint64_t> cpu_nsec{};
+    std::atomic<std::uint64_t> entries{};
+  };
+
+  /**
+   * Accumulated time and memory of a named detail.
+   */
+  struct detail_totals {
+    std::string name;
+    profile_sample elapsed{};
+    std::size_t bytes{};
+    bool timed{};
+  };
+
+  bool enabled_;
+  profile_sample start_;
+  std::array<phase_totals, profile_phase_count> totals_;
+  mutable std::mutex details_mutex_;
+  std::vector<detail_totals> details_;
+
+  /**
+   * Return the detail with the given name, adding it if necessary.
+   *
+   * The details mutex must be held by the caller.
+   */
+  detail_totals& find_detail(std::string_view name)
+  {
+    for (auto& detail : details_)
+      if (detail.name == name)
+        return detail;
+    return details_.emplace_back(detail_totals{std::string{name}});
+  }
+
+  /**
+   * Indicate if `PDHKR_PROFILE` is set to a value other than empty or 0.
+   */
+  static bool env_enabled() noexcept
+  {
+    // note: MSVC warns that std::getenv is unsafe (C4996)
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4996)
+#endif  // _MSC_VER
+    auto env_value = std::getenv("PDHKR_PROFILE");
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif  // _MSC_VER
+    return env_value && *env_value && std::string_view{env_value} != "0";
+  }
+};
+
+namespace detail {
+
+/**
+ * Phase being timed on a thread.
+ *
+ * Active phases on a thread form a stack, where only the top phase is timed.
+ */
+struct profile_frame {
+  profile_phase phase;
+  profile_sample start;
+  profile_frame* outer;
+};
+
+/**
+ * Return the current wall and thread CPU time.
+ */
+inline profile_sample profile_now() noexcept
+{
+  return {profile_wall_nsec(), profile_thread_cpu_nsec()};
+}
+
+/**
+ * Add the time since the frame was last resumed to the frame's phase.
+ *
+ * @param frame Frame to charge
+ * @param now Current time
+ * @param entered `true` if the frame is ending
+ */
+inline void profile_charge(
+  const profile_frame& frame, const profile_sample& now, bool entered) noexcept
+{
+  profiler::global().add(
+    frame.phase,
+    {now.wall_nsec - frame.start.wall_nsec, now.cpu_nsec - frame.start.cpu_nsec},
+    entered
+  );
+}
+
+/**
+ * Per-thread phase state.
+ *
+ * The base frame is the one started by `PDHKR_PROFILE_PHASE` outside of any
+ * scope and is ended when the thread exits, before the global profiler writes
+ * its summary.
+ */
+class profile_thread_state {
+public:
+  profile_thread_state() = default;
+  profile_thread_state(const profile_thread_state&) = delete;
+  profile_thread_state& operator=(const profile_thread_state&) = delete;
+
+  /**
+   * Dtor.
+   *
+   * Ends the base phase if one is active.
+   */
+  ~profile_thread_state()
+  {
+    if (base_active_)
+      pop(base_);
+  }
+
+  /**
+   * Return the calling thread's state.
+   */
+  static profile_thread_state& current()
+  {
+    static thread_local profile_thread_state state;
+    return state;
+  }
+
+  /**
+   * Start timing a frame, pausing the frame it interrupts.
+   *
+   * @param frame Frame to start
+   * @param phase Frame phase
+   */
+  void push(profile_frame& frame, profile_phase phase) noexcept
+  {
+    auto now = profile_now();
+    if (top_)
+      profile_charge(*top_, now, false);
+    frame.phase = phase;
+    frame.start = now;
+    frame.outer = top_;
+    top_ = &frame;
+  }
+
+  /**
+   * End timing a frame, resuming the frame it interrupted.
+   *
+   * The frame must be the most recently pushed one.
+   *
+   * @param frame Frame to end
+   */
+  void pop(profile_frame& frame) noexcept
+  {
+    auto now = profile_now();
+    profile_charge(frame, now, true);
+    top_ = frame.outer;
+    if (top_)
+      top_->start = now;
+  }
+
+  /**
+   * Switch the phase of the innermost frame.
+   *
+   * If no frame is active the base frame is started. Nothing is done if the
+   * innermost frame already has the given phase.
+   *
+   * @param phase Phase to switch to
+   */
+  void switch_phase(profile_phase phase) noexcept
+  {
+    if (!top_) {
+      push(base_, phase);
+      base_active_ = true;
+      return;
+    }
+    if (top_->phase == phase)
+      return;
+    auto now = profile_now();
+    profile_charge(*top_, now, true);
+    top_->phase = phase;
+    top_->start = now;
+  }
+
+private:
+  profile_frame base_{};
+  bool base_active_{};
+  profile_frame* top_{};
+};
+
+}  // namespace detail
+
+/**
+ * End the calling thread's current phase, if any, and start another.
+ *
+ * Inside a `profile_scope` the phase lasts until the next switch or until the
+ * scope ends, otherwise until the next switch or until the thread exits.
+ *
+ * @param phase Phase to switch to
+ */
+inline void profile_switch(profile_phase phase)
+{
+  if (profiler::global().enabled())
+    detail::profile_thread_state::current().switch_phase(phase);
+}
+
+/**
+ * Scope guard timing a phase until the end of the enclosing scope.
+ *
+ * Any phase the scope interrupts on the same thread is paused until the scope
+ * ends, so nested phases are not counted twice.
+ */
+class profile_scope {
+public:
+  /**
+   * Ctor.
+   *
+   * @param phase Phase to time
+   */
+  explicit profile_scope(profile_phase phase)
+    : active_{profiler::global().enabled()}
+  {
+    if (active_)
+      detail::profile_thread_state::current().push(frame_, phase);
+  }
+
+  profile_scope(const profile_scope&) = delete;
+  profile_scope& operator=(const profile_scope&) = delete;
+
+  /**
+   * Dtor.
+   */
+  ~profile_scope()
+  {
+    if (active_)
+      detail::profile_thread_state::current().pop(frame_);
+  }
+
+private:
+  bool active_;
+  detail::profile_frame frame_{};
+};
+
+/**
+ * Scope guard timing a named detail until the end of the enclosing scope.
+ *
+ * Unlike `profile_scope`, this does not affect the phases, so the time is
+ * counted both in the detail and in the phase the scope runs in.
+ */
+class profile_detail_scope {
+public:
+  /**
+   * Ctor.
+   *
+   * @param name Detail name, which must outlive the scope
+   */
+  explicit profile_detail_scope(std::string_view name)
+    : name_{name}, active_{profiler::global().enabled()}
+  {
+    if (active_)
+      start_ = detail::profile_now();
+  }
+
+  profile_detail_scope(const profile_detail_scope&) = delete;
+  profile_detail_scope& operator=(const profile_detail_scope&) = delete;
+
+  /**
+   * Dtor.
+   */
+  ~profile_detail_scope()
+  {
+    if (!active_)
+      return;
+    auto now = detail::profile_now();
+    profiler::global().add_detail(
+      name_,
+      {now.wall_nsec - start_.wall_nsec, now.cpu_nsec - start_.cpu_nsec}
+    );
+  }
+
+private:
+  std::string_view name_;
+  bool active_;
+  profile_sample start_{};
+};
+
+/**
+ * Add a memory size in bytes to a named detail if profiling is enabled.
+ *
+ * @param name Detail name
+ * @param bytes Memory size
+ */
+inline void profile_memory(std::string_view name, std::size_t bytes)
+{
+  if (profiler::global().enabled())
+    profiler::global().add_detail_memory(name, bytes);
+}
+
+}  // namespace pdhkr
+
+/**
+ * Switch the calling thread to a phase named by a `profile_phase` enumerator.
+ *
+ * @param phase `parse`, `build`, `solve`, `output`, or `compare`
+ */
+#define PDHKR_PROFILE_PHASE(phase) \
+  pdhkr::profile_switch(pdhkr::profile_phase::phase)
+
+/**
+ * Time the rest of the enclosing scope as a phase.
+ *
+ * @param phase `parse`, `build`, `solve`, `output`, or `compare`
+ */
+#define PDHKR_PROFILE_SCOPE(phase) \
+  pdhkr::profile_scope PDHKR_CONCAT(pdhkr_profile_scope_, __LINE__){ \
+    pdhkr::profile_phase::phase \
+  }
+
+/**
+ * Time the rest of the enclosing scope as a named detail.
+ *
+ * @param name Detail name, an identifier such as `index`
+ */
+#define PDHKR_PROFILE_DETAIL(name) \
+  pdhkr::profile_detail_scope PDHKR_CONCAT(pdhkr_profile_detail_, __LINE__){ \
+    #name \
+  }
+
+/**
+ * Add a memory size in bytes to a named detail.
+ *
+ * @param name Detail name, an identifier such as `index`
+ * @param bytes Memory size
+ */
+#define PDHKR_PROFILE_MEMORY(name, bytes) pdhkr::profile_memory(#name, bytes)
+
+#endif  // PDHKR_PROFILE_HH_
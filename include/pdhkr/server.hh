@@ -0,0 +1,715 @@
+/**
+ * @file server.hh
+ * @author Derek Huang
+ * @brief C++ header for the solver server binary protocol
+ * @copyright MIT License
+ *
+ * Requests and responses are frames made of an 8-byte header followed by a
+ * payload. The header is the payload size in bytes as a 32-bit unsigned
+ * integer, a 16-bit code, and 16 reserved bits, all little-endian. The code
+ * of a request is the `problem_id` and the code of a response is its
+ * `response_status`.
+ *
+ * A request payload is the problem input as packed little-endian 64-bit
+ * signed integers, in the same order as in the HackerRank text input, with
+ * the `subtrees_add` and `subtrees_max` op codes in place of the words. A
+ * successful response payload is the results as packed 64-bit integers laid
+ * out as described by the problem's `output_layout`. A failed response
+ * payload is an error message.
+ */
+
+#ifndef PDHKR_SERVER_HH_
+#define PDHKR_SERVER_HH_
+
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/algo.hh"
+#include "pdhkr/constraints.hh"
+#include "pdhkr/error.hh"
+
+// POSIX file descriptor I/O
+#include <unistd.h>
+
+namespace pdhkr {
+
+/**
+ * Problem ID used as the request frame code.
+ */
+enum class problem_id : std::uint16_t {
+  array_manipulation = 1,
+  equal_stacks,
+  jesse_and_cookies,
+  journey_to_moon,
+  max_stack_element,
+  merge_sorted_linked_lists,
+  node_from_tail,
+  roads_and_libraries,
+  running_median,
+  subtrees_and_paths,
+  swap_tree_nodes,
+  tree_level_order,
+  tree_top_view,
+  two_stack_game
+};
+
+/**
+ * Response status used as the response frame code.
+ */
+enum class response_status : std::uint16_t {
+  ok = 0,
+  unknown_problem,
+  bad_payload
+};
+
+/**
+ * How a problem's result values are laid out in its text output.
+ */
+enum class output_layout {
+  // one value per line
+  value_lines,
+  // all the values on one line
+  single_line,
+  // each line is a count followed by that many values
+  counted_lines,
+  // one value per line, each twice the actual value, which is written with
+  // one decimal place
+  half_value_lines
+};
+
+/**
+ * Problem name and output layout.
+ */
+struct problem_info {
+  problem_id id;
+  std::string_view name;
+  output_layout layout;
+};
+
+/**
+ * All the problems served, in `problem_id` order.
+ */
+inline constexpr std::array<problem_info, 14> problems{{
+  {
+    problem_id::array_manipulation,
+    "array_manipulation",
+    output_layout::value_lines
+  },
+  {problem_id::equal_stacks, "equal_stacks", output_layout::value_lines},
+  {
+    problem_id::jesse_and_cookies,
+    "jesse_and_cookies",
+    output_layout::value_lines
+  },
+  {problem_id::journey_to_moon, "journey_to_moon", output_layout::value_lines},
+  {
+    problem_id::max_stack_element,
+    "max_stack_element",
+    output_layout::value_lines
+  },
+  {
+    problem_id::merge_sorted_linked_lists,
+    "merge_sorted_linked_lists",
+    output_layout::counted_lines
+  },
+  {problem_id::node_from_tail, "node_from_tail", output_layout::value_lines},
+  {
+    problem_id::roads_and_libraries,
+    "roads_and_libraries",
+    output_layout::value_lines
+  },
+  {
+    problem_id::running_median,
+    "running_median",
+    output_layout::half_value_lines
+  },
+  {
+    problem_id::subtrees_and_paths,
+    "subtrees_and_paths",
+    output_layout::value_lines
+  },
+  {
+    problem_id::swap_tree_nodes,
+    "swap_tree_nodes",
+    output_layout::counted_lines
+  },
+  {
+    problem_id::tree_level_order,
+    "tree_level_order",
+    output_layout::single_line
+  },
+  {problem_id::tree_top_view, "tree_top_view", output_layout::single_line},
+  {problem_id::two_stack_game, "two_stack_game", output_layout::value_lines}
+}};
+
+/**
+ * Return the problem with the given name, `nullptr` if there is none.
+ *
+ * @param name Problem name, e.g. `"roads_and_libraries"`
+ */
+inline const problem_info* find_problem(std::string_view name) noexcept
+{
+  for (const auto& problem : problems)
+    if (problem.name == name)
+      return &problem;
+  return nullptr;
+}
+
+/**
+ * Return the problem with the given ID, `nullptr` if there is none.
+ *
+ * @param id Problem ID
+ */
+inline const problem_info* find_problem(problem_id id) noexcept
+{
+  auto index = static_cast<std::size_t>(id) - 1;
+  return (index < problems.size()) ? &problems[index] : nullptr;
+}
+
+/**
+ * "Subtrees And Paths" op codes replacing the `add` and `max` words.
+ */
+inline constexpr std::int64_t subtrees_add = 1;
+inline constexpr std::int64_t subtrees_max = 2;
+
+/**
+ * Frame header size in bytes.
+ */
+inline constexpr std::size_t frame_header_size = 8;
+
+/**
+ * Largest accepted frame payload size in bytes.
+ */
+inline constexpr std::uint32_t max_payload_size = 1U << 30;
+
+/**
+ * Frame header.
+ */
+struct frame_header {
+  std::uint32_t size;
+  std::uint16_t code;
+};
+
+/**
+ * Write a little-endian unsigned integer to a byte buffer.
+ *
+ * @tparam T Unsigned integral type
+ *
+ * @param out Buffer with at least `sizeof(T)` bytes
+ * @param value Value to write
+ */
+template <typename T>
+inline void store_le(char* out, T value) noexcept
+{
+  for (std::size_t i = 0; i < sizeof(T); i++)
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+/**
+ * Read a little-endian unsigned integer from a byte buffer.
+ *
+ * @tparam T Unsigned integral type
+ *
+ * @param in Buffer with at least `sizeof(T)` bytes
+ */
+template <typename T>
+inline T load_le(const char* in) noexcept
+{
+  T value = 0;
+  for (std::size_t i = 0; i < sizeof(T); i++)
+    value |= static_cast<T>(static_cast<unsigned char>(in[i])) << (8 * i);
+  return value;
+}
+
+/**
+ * Append packed 64-bit integers to a byte buffer.
+ *
+ * @param out Byte buffer
+ * @param values Values to pack
+ */
+inline void pack_values(
+  std::string& out, const std::vector<std::int64_t>& values)
+{
+  auto offset = out.size();
+  out.resize(offset + 8 * values.size());
+  for (auto value : values) {
+    store_le(&out[offset], static_cast<std::uint64_t>(value));
+    offset += 8;
+  }
+}
+
+/**
+ * Unpack 64-bit integers from a byte buffer.
+ *
+ * Any trailing bytes that do not make up a whole value are an error.
+ *
+ * @param in Packed values
+ */
+inline auto unpack_values(std::string_view in)
+{
+  if (in.size() % 8)
+    throw_error<std::invalid_argument>("Payload is not packed 64-bit values");
+  std::vector<std::int64_t> values(in.size() / 8);
+  for (std::size_t i = 0; i < values.size(); i++)
+    values[i] = static_cast<std::int64_t>(load_le<std::uint64_t>(&in[8 * i]));
+  return values;
+}
+
+/**
+ * Sequential reader of request payload values with bounds checking.
+ */
+class payload_reader {
+public:
+  /**
+   * Ctor.
+   *
+   * @param values Unpacked payload values
+   */
+  explicit payload_reader(const std::vector<std::int64_t>& values) noexcept
+    : values_{values}
+  {}
+
+  /**
+   * Return the next value.
+   */
+  std::int64_t next()
+  {
+    if (pos_ == values_.size())
+      throw_error<std::invalid_argument>("Payload ended early");
+    return values_[pos_++];
+  }
+
+  /**
+   * Return the next value as a count of items made of `width` values each.
+   *
+   * The count is checked against the remaining values, dividing instead of
+   * multiplying so that the check cannot wrap, and against `max_count`, so
+   * that a malformed payload cannot cause huge allocations. Counts of items
+   * that are not in the payload, e.g. an array size, have zero width and are
+   * only bounded by `max_count`.
+   *
+   * @param width Number of values per item
+   * @param max_count Largest count allowed
+   */
+  std::size_t next_count(
+    std::size_t width = 1U,
+    std::size_t max_count = std::numeric_limits<std::size_t>::max())
+  {
+    auto count = next();
+    auto n_items = static_cast<std::uint64_t>(count);
+    if (count < 0 || (width && n_items > remaining() / width))
+      throw_error<std::invalid_argument>(
+        "Count " + std::to_string(count) + " exceeds the payload"
+      );
+    if (n_items > max_count)
+      throw_error<std::invalid_argument>(
+        "Count " + std::to_string(count) + " exceeds the limit of " +
+        std::to_string(max_count)
+      );
+    return static_cast<std::size_t>(count);
+  }
+
+  /**
+   * Return the next `n` values.
+   *
+   * @param n Number of values
+   */
+  std::vector<std::int64_t> next_values(std::size_t n)
+  {
+    if (n > remaining())
+      throw_error<std::invalid_argument>("Payload ended early");
+    std::vector<std::int64_t> values(
+      values_.begin() + static_cast<std::ptrdiff_t>(pos_),
+      values_.begin() + static_cast<std::ptrdiff_t>(pos_ + n)
+    );
+    pos_ += n;
+    return values;
+  }
+
+  /**
+   * Return the next `n` pairs of values.
+   *
+   * @param n Number of pairs
+   */
+  auto next_pairs(std::size_t n)
+  {
+    if (n > remaining() / 2)
+      throw_error<std::invalid_argument>("Payload ended early");
+    std::vector<std::pair<std::int64_t, std::int64_t>> pairs(n);
+    for (auto& [a, b] : pairs) {
+      a = values_[pos_++];
+      b = values_[pos_++];
+    }
+    return pairs;
+  }
+
+  /**
+   * Return the number of values left.
+   */
+  std::size_t remaining() const noexcept
+  {
+    return values_.size() - pos_;
+  }
+
+private:
+  const std::vector<std::int64_t>& values_;
+  std::size_t pos_{};
+};
+
+/**
+ * Solve a request, appending the result values.
+ *
+ * Malformed inputs throw `std::invalid_argument` or `std::out_of_range`.
+ *
+ * @param id Problem ID
+ * @param values Unpacked request payload
+ * @param results Vector to append the results to
+ */
+inline void solve_request(
+  problem_id id,
+  const std::vector<std::int64_t>& values,
+  std::vector<std::int64_t>& results)
+{
+  payload_reader in{values};
+  auto emit = [&results](auto value)
+  {
+    results.push_back(static_cast<std::int64_t>(value));
+  };
+  switch (id) {
+    case problem_id::array_manipulation: {
+      // the difference array has one value per element
+      auto n = in.next_count(0U, constraints::array_manipulation::max_size);
+      auto n_ops = in.next_count(3U);
+      std::vector<std::array<std::int64_t, 3>> ops(n_ops);
+      for (auto& op : ops)
+        op = {in.next(), in.next(), in.next()};
+      emit(algo::array_manipulation(n, ops.begin(), ops.end()));
+      break;
+    }
+    case problem_id::equal_stacks: {
+      auto n_1 = in.next_count();
+      auto n_2 = in.next_count();
+      auto n_3 = in.next_count();
+      auto stack_1 = in.next_values(n_1);
+      auto stack_2 = in.next_values(n_2);
+      auto stack_3 = in.next_values(n_3);
+      emit(
+        algo::max_equal_height(
+          stack_1.begin(),
+          stack_1.end(),
+          stack_2.begin(),
+          stack_2.end(),
+          stack_3.begin(),
+          stack_3.end()
+        )
+      );
+      break;
+    }
+    case problem_id::jesse_and_cookies: {
+      auto n = in.next_count();
+      auto target = in.next();
+      auto cookies = in.next_values(n);
+      emit(
+        algo::mixing_count(
+          cookies.begin(),
+          cookies.end(),
+          static_cast<unsigned long long>(target)
+        )
+      );
+      break;
+    }
+    case problem_id::journey_to_moon: {
+      // the union-find forest has one node per astronaut
+      auto n = in.next_count(0U, constraints::journey_to_moon::max_astronauts);
+      auto pairs = in.next_pairs(in.next_count(2U));
+      emit(algo::journey_to_moon(n, pairs.begin(), pairs.end()));
+      break;
+    }
+    case problem_id::max_stack_element: {
+      auto n_queries = in.next_count();
+      algo::max_stack<std::int64_t> stack;
+      for (std::size_t i = 0; i < n_queries; i++) {
+        switch (in.next()) {
+          case 1:
+            stack.push(in.next());
+            break;
+          case 2:
+            stack.pop();
+            break;
+          case 3:
+            emit(stack.max());
+            break;
+          default:
+            throw_error<std::invalid_argument>("Unknown stack query");
+        }
+      }
+      break;
+    }
+    case problem_id::merge_sorted_linked_lists: {
+      auto n_cases = in.next_count();
+      for (std::size_t i = 0; i < n_cases; i++) {
+        auto list_a = in.next_values(in.next_count());
+        auto list_b = in.next_values(in.next_count());
+        emit(list_a.size() + list_b.size());
+        algo::merge_lists(
+          list_a.begin(),
+          list_a.end(),
+          list_b.begin(),
+          list_b.end(),
+          std::back_inserter(results)
+        );
+      }
+      break;
+    }
+    case problem_id::node_from_tail: {
+      auto n_cases = in.next_count();
+      for (std::size_t i = 0; i < n_cases; i++) {
+        auto list = in.next_values(in.next_count());
+        auto tail_pos = in.next_count(0U);
+        emit(algo::position_from_tail(list.begin(), list.end(), tail_pos));
+      }
+      break;
+    }
+    case problem_id::roads_and_libraries: {
+      auto n_queries = in.next_count();
+      for (std::size_t i = 0; i < n_queries; i++) {
+        // the union-find forest has one node per city
+        auto n_cities = in.next_count(
+          0U, constraints::roads_and_libraries::max_cities
+        );
+        auto n_roads = in.next_count();
+        auto lib_cost = in.next_count(0U);
+        auto road_cost = in.next_count(0U);
+        auto roads = in.next_pairs(n_roads);
+        emit(
+          algo::roads_and_libraries(
+            n_cities, lib_cost, road_cost, roads.begin(), roads.end()
+          )
+        );
+      }
+      break;
+    }
+    case problem_id::running_median: {
+      algo::running_median<std::int64_t> median;
+      auto n = in.next_count();
+      for (std::size_t i = 0; i < n; i++)
+        emit(std::llround(2 * median(in.next())));
+      break;
+    }
+    case problem_id::subtrees_and_paths: {
+      auto n_nodes = in.next_count();
+      auto edges = in.next_pairs((n_nodes) ? n_nodes - 1 : 0U);
+      // narrowest node index type for denser per-node arrays
+      algo::dispatch_index(
+        n_nodes,
+        [&](auto index)
+        {
+          using index_type = typename decltype(index)::type;
+          algo::subtree_path_tree<std::int64_t, index_type> tree{
+            n_nodes, edges.begin(), edges.end()
+          };
+          auto n_queries = in.next_count(3U);
+          for (std::size_t i = 0; i < n_queries; i++) {
+            auto op = in.next();
+            auto a = in.next_count(0U);
+            auto b = in.next();
+            if (op == subtrees_add)
+              tree.add(a, b);
+            else if (op == subtrees_max)
+              emit(tree.max(a, static_cast<std::size_t>(b)));
+            else
+              throw_error<std::invalid_argument>("Unknown tree query");
+          }
+        }
+      );
+      break;
+    }
+    case problem_id::swap_tree_nodes: {
+      auto n_nodes = in.next_count(2U);
+      auto children = in.next_pairs(n_nodes);
+      algo::swap_tree tree{children.begin(), children.end()};
+      auto n_swaps = in.next_count();
+      for (std::size_t i = 0; i < n_swaps; i++) {
+        tree.swap_depths(in.next_count(0U));
+        emit(tree.size());
+        tree.inorder(std::back_inserter(results));
+      }
+      break;
+    }
+    case problem_id::tree_level_order:
+    case problem_id::tree_top_view: {
+      algo::binary_search_tree<std::int64_t> tree;
+      for (auto value : in.next_values(in.next_count()))
+        tree.insert(value);
+      if (id == problem_id::tree_level_order)
+        tree.level_order(std::back_inserter(results));
+      else
+        tree.top_view(std::back_inserter(results));
+      break;
+    }
+    case problem_id::two_stack_game: {
+      auto n_games = in.next_count();
+      for (std::size_t i = 0; i < n_games; i++) {
+        auto n_a = in.next_count();
+        auto n_b = in.next_count();
+        auto max_sum = in.next_count(0U);
+        auto stack_a = in.next_values(n_a);
+        auto stack_b = in.next_values(n_b);
+        emit(
+          algo::max_game_score(
+            stack_a.begin(),
+            stack_a.end(),
+            stack_b.begin(),
+            stack_b.end(),
+            max_sum
+          )
+        );
+      }
+      break;
+    }
+    default:
+      throw_error<std::invalid_argument>("Unknown problem ID");
+  }
+}
+
+/**
+ * Read exactly `size` bytes from a file descriptor.
+ *
+ * @param fd File descriptor
+ * @param data Buffer to read into
+ * @param size Number of bytes to read
+ * @returns `true` on success, `false` on EOF before any bytes were read
+ */
+inline bool read_exact(int fd, char* data, std::size_t size)
+{
+  std::size_t n_read = 0;
+  while (n_read < size) {
+    auto n = ::read(fd, data + n_read, size - n_read);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      throw_error<std::runtime_error>("read() failed");
+    if (!n) {
+      if (!n_read)
+        return false;
+      throw_error<std::runtime_error>("Connection closed mid-frame");
+    }
+    n_read += static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+/**
+ * Write all of a buffer to a file descriptor.
+ *
+ * @param fd File descriptor
+ * @param data Bytes to write
+ */
+inline void write_all(int fd, std::string_view data)
+{
+  std::size_t n_written = 0;
+  while (n_written < data.size()) {
+    auto n = ::write(fd, data.data() + n_written, data.size() - n_written);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      throw_error<std::runtime_error>("write() failed");
+    n_written += static_cast<std::size_t>(n);
+  }
+}
+
+/**
+ * Read a frame from a file descriptor.
+ *
+ * @param fd File descriptor
+ * @param header Frame header to fill
+ * @param payload Buffer to hold the payload
+ * @returns `true` on success, `false` on EOF before the frame
+ */
+inline bool read_frame(int fd, frame_header& header, std::string& payload)
+{
+  char header_bytes[frame_header_size];
+  if (!read_exact(fd, header_bytes, frame_header_size))
+    return false;
+  header.size = load_le<std::uint32_t>(header_bytes);
+  header.code = load_le<std::uint16_t>(header_bytes + 4);
+  if (header.size > max_payload_size)
+    throw_error<std::runtime_error>("Frame payload too large");
+  payload.resize(header.size);
+  if (header.size && !read_exact(fd, payload.data(), header.size))
+    throw_error<std::runtime_error>("Connection closed mid-frame");
+  return true;
+}
+
+/**
+ * Write a frame to a file descriptor.
+ *
+ * @param fd File descriptor
+ * @param code Frame code
+ * @param payload Frame payload
+ * @param buffer Scratch buffer reused across calls to avoid reallocation
+ */
+inline void write_frame(
+  int fd, std::uint16_t code, std::string_view payload, std::string& buffer)
+{
+  buffer.resize(frame_header_size);
+  store_le(buffer.data(), static_cast<std::uint32_t>(payload.size()));
+  store_le(buffer.data() + 4, code);
+  store_le(buffer.data() + 6, std::uint16_t{});
+  buffer.append(payload);
+  write_all(fd, buffer);
+}
+
+/**
+ * Serve requests from one connection until it is closed.
+ *
+ * Malformed payloads and unknown problems get error responses and the
+ * connection is kept open. I/O errors end the connection.
+ *
+ * @param in_fd File descriptor to read requests from
+ * @param out_fd File descriptor to write responses to
+ */
+inline void serve_connection(int in_fd, int out_fd)
+{
+  frame_header header;
+  std::string request;
+  std::string response;
+  std::string frame;
+  std::vector<std::int64_t> results;
+  while (read_frame(in_fd, header, request)) {
+    response.clear();
+    results.clear();
+    auto status = response_status::ok;
+    auto problem = find_problem(static_cast<problem_id>(header.code));
+    if (!problem) {
+      status = response_status::unknown_problem;
+      response = "Unknown problem ID " + std::to_string(header.code);
+    }
+    else {
+      try {
+        solve_request(problem->id, unpack_values(request), results);
+        pack_values(response, results);
+      }
+      catch (const std::exception& exc) {
+        status = response_status::bad_payload;
+        response = exc.what();
+      }
+    }
+    write_frame(out_fd, static_cast<std::uint16_t>(status), response, frame);
+  }
+}
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_SERVER_HH_
@@ -0,0 +1,153 @@
+/**
+ * @file spsc_queue.hh
+ * @author Derek Huang
+ * @brief C++ header for a lock-free single-producer single-consumer queue
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_SPSC_QUEUE_HH_
+#define PDHKR_SPSC_QUEUE_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "pdhkr/thread.hh"
+
+namespace pdhkr {
+
+/**
+ * Bounded lock-free ring buffer for one producer and one consumer thread.
+ *
+ * The producer only writes the tail index and the consumer only writes the
+ * head index, so a push or pop is a single release store. Each side also keeps
+ * a cached copy of the other side's index and only reloads it when the cached
+ * copy says the queue is full or empty, so in steady state the two threads do
+ * not touch each other's cache lines on every operation.
+ *
+ * @tparam T Element type. Intended to be a small, trivially copyable record
+ */
+template <typename T>
+class spsc_queue {
+public:
+  static_assert(std::is_default_constructible_v<T>);
+  static_assert(std::is_move_assignable_v<T>);
+
+  using value_type = T;
+  using size_type = std::size_t;
+
+  /**
+   * Ctor.
+   *
+   * @param capacity Minimum capacity, rounded up to a power of 2
+   */
+  explicit spsc_queue(size_type capacity = 1024U)
+    : capacity_{round_capacity(capacity)},
+      mask_{capacity_ - 1},
+      buffer_{std::make_unique<T[]>(capacity_)}
+  {}
+
+  /**
+   * Return the queue capacity.
+   */
+  auto capacity() const noexcept { return capacity_; }
+
+  /**
+   * Push a value if the queue is not full.
+   *
+   * Must only be called from the producer thread.
+   *
+   * @returns `true` if the value was pushed, `false` if the queue was full
+   */
+  template <typename U>
+  bool try_push(U&& value)
+  {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    // refresh cached head only if the queue looks full
+    if (tail - cached_head_ == capacity_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == capacity_)
+        return false;
+    }
+    buffer_[tail & mask_] = std::forward<U>(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Push a value, spinning while the queue is full.
+   *
+   * Must only be called from the producer thread.
+   */
+  template <typename U>
+  void push(U&& value)
+  {
+    // note: only moved from on success, so forwarding in a loop is fine
+    while (!try_push(std::forward<U>(value)))
+      std::this_thread::yield();
+  }
+
+  /**
+   * Pop a value if the queue is not empty.
+   *
+   * Must only be called from the consumer thread.
+   *
+   * @param value Value to move the front element into
+   * @returns `true` if a value was popped, `false` if the queue was empty
+   */
+  bool try_pop(T& value)
+  {
+    auto head = head_.load(std::memory_order_relaxed);
+    // refresh cached tail only if the queue looks empty
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_)
+        return false;
+    }
+    value = std::move(buffer_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop a value, spinning while the queue is empty.
+   *
+   * Must only be called from the consumer thread.
+   */
+  T pop()
+  {
+    T value;
+    while (!try_pop(value))
+      std::this_thread::yield();
+    return value;
+  }
+
+private:
+  size_type capacity_;
+  size_type mask_;
+  std::unique_ptr<T[]> buffer_;
+  // consumer cache line: next slot to pop + cached copy of tail_
+  alignas(cache_line_size) std::atomic<size_type> head_{};
+  size_type cached_tail_{};
+  // producer cache line: next slot to push + cached copy of head_
+  alignas(cache_line_size) std::atomic<size_type> tail_{};
+  size_type cached_head_{};
+
+  /**
+   * Round a requested capacity up to a power of 2 that is at least 2.
+   */
+  static size_type round_capacity(size_type capacity) noexcept
+  {
+    size_type rounded = 2U;
+    while (rounded < capacity)
+      rounded <<= 1;
+    return rounded;
+  }
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_SPSC_QUEUE_HH_
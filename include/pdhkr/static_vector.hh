@@ -0,0 +1,444 @@
+/**
+ * @file static_vector.hh
+ * @author Derek Huang
+ * @brief C++ header for containers with preallocated inline capacity
+ * @copyright MIT License
+ *
+ * `static_vector<T, N>` and `ring_buffer<T, N>` hold up to `N` elements in
+ * storage inside the container object itself, so a container sized from the
+ * problem constraints never allocates or reallocates on valid inputs. When
+ * more elements are added, e.g. for stress inputs past the constraints, the
+ * elements move to a heap buffer that grows geometrically like `std::vector`.
+ *
+ * Since the inline storage makes the container object as large as its
+ * capacity, large containers should be heap allocated once, e.g. with
+ * `std::make_unique`, or have static storage duration, instead of being put
+ * on the stack.
+ */
+
+#ifndef PDHKR_STATIC_VECTOR_HH_
+#define PDHKR_STATIC_VECTOR_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "pdhkr/error.hh"
+
+namespace pdhkr {
+
+/**
+ * Contiguous sequence container with inline capacity and a heap fallback.
+ *
+ * This supports the `std::vector` operations needed for stacks and as the
+ * container of `std::priority_queue`, with insertion only at the end.
+ *
+ * @tparam T Value type
+ * @tparam N Inline capacity
+ */
+template <typename T, std::size_t N>
+class static_vector {
+  static_assert(N > 0, "inline capacity must be positive");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  /**
+   * Default ctor.
+   */
+  static_vector() noexcept : data_{inline_data()} {}
+
+  /**
+   * Ctor.
+   *
+   * Copy the values from an iterator range.
+   *
+   * @tparam InputIt Input iterator
+   *
+   * @param first Iterator to the first value
+   * @param last Iterator one past the last value
+   */
+  template <typename InputIt>
+  static_vector(InputIt first, InputIt last) : static_vector()
+  {
+    insert(end(), first, last);
+  }
+
+  /**
+   * Copy ctor.
+   */
+  static_vector(const static_vector& other) : static_vector()
+  {
+    insert(end(), other.begin(), other.end());
+  }
+
+  /**
+   * Move ctor.
+   *
+   * A heap buffer is taken over while inline elements are moved one by one.
+   */
+  static_vector(static_vector&& other) noexcept : static_vector()
+  {
+    take(std::move(other));
+  }
+
+  /**
+   * Dtor.
+   */
+  ~static_vector()
+  {
+    clear();
+    release();
+  }
+
+  /**
+   * Copy assignment operator.
+   */
+  static_vector& operator=(const static_vector& other)
+  {
+    if (this != &other) {
+      clear();
+      insert(end(), other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  /**
+   * Move assignment operator.
+   */
+  static_vector& operator=(static_vector&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      release();
+      take(std::move(other));
+    }
+    return *this;
+  }
+
+  /**
+   * Return the number of elements.
+   */
+  size_type size() const noexcept { return size_; }
+
+  /**
+   * Return the number of elements that fit without reallocation.
+   */
+  size_type capacity() const noexcept { return capacity_; }
+
+  /**
+   * Return `true` if there are no elements.
+   */
+  bool empty() const noexcept { return !size_; }
+
+  /**
+   * Return `true` if the elements have spilled to a heap buffer.
+   */
+  bool on_heap() const noexcept { return data_ != inline_data(); }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+  iterator begin() noexcept { return data_; }
+  const_iterator begin() const noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+  T& operator[](size_type i) noexcept { return data_[i]; }
+  const T& operator[](size_type i) const noexcept { return data_[i]; }
+  T& front() noexcept { return data_[0]; }
+  const T& front() const noexcept { return data_[0]; }
+  T& back() noexcept { return data_[size_ - 1]; }
+  const T& back() const noexcept { return data_[size_ - 1]; }
+
+  /**
+   * Ensure capacity for at least the given number of elements.
+   *
+   * @param new_capacity Minimum capacity
+   */
+  void reserve(size_type new_capacity)
+  {
+    if (new_capacity > capacity_)
+      reallocate(new_capacity);
+  }
+
+  /**
+   * Construct an element at the end.
+   *
+   * @param args Constructor arguments
+   */
+  template <typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    if (size_ == capacity_)
+      reallocate(2 * capacity_);
+    auto element = ::new (data_ + size_) T(std::forward<Args>(args)...);
+    size_++;
+    return *element;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * Remove the last element, which must exist.
+   */
+  void pop_back() noexcept
+  {
+    std::destroy_at(data_ + --size_);
+  }
+
+  /**
+   * Remove all the elements, keeping the capacity.
+   */
+  void clear() noexcept
+  {
+    std::destroy(data_, data_ + size_);
+    size_ = 0;
+  }
+
+  /**
+   * Insert values from an iterator range at the end.
+   *
+   * Only insertion at the end is supported, which is what `std::priority_queue`
+   * uses when constructed from an iterator range.
+   *
+   * @tparam InputIt Input iterator
+   *
+   * @param pos Insertion position, which must be `end()`
+   * @param first Iterator to the first value
+   * @param last Iterator one past the last value
+   * @returns Iterator to the first inserted value
+   */
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last)
+  {
+    auto offset = static_cast<size_type>(pos - data_);
+    if constexpr (
+      std::is_base_of_v<
+        std::forward_iterator_tag,
+        typename std::iterator_traits<InputIt>::iterator_category
+      >
+    )
+      reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+    for (; first != last; ++first)
+      emplace_back(*first);
+    return data_ + offset;
+  }
+
+private:
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+  T* data_;
+  size_type size_{};
+  size_type capacity_{N};
+
+  T* inline_data() noexcept
+  {
+    return std::launder(reinterpret_cast<T*>(storage_));
+  }
+
+  const T* inline_data() const noexcept
+  {
+    return std::launder(reinterpret_cast<const T*>(storage_));
+  }
+
+  /**
+   * Move the elements to a new heap buffer with the given capacity.
+   */
+  void reallocate(size_type new_capacity)
+  {
+    auto new_data = std::allocator<T>{}.allocate(new_capacity);
+    std::uninitialized_move(data_, data_ + size_, new_data);
+    std::destroy(data_, data_ + size_);
+    release();
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  /**
+   * Free the heap buffer, if any, without destroying any elements.
+   */
+  void release() noexcept
+  {
+    if (on_heap())
+      std::allocator<T>{}.deallocate(data_, capacity_);
+    data_ = inline_data();
+    capacity_ = N;
+  }
+
+  /**
+   * Take the elements of another container, leaving this one's unused.
+   */
+  void take(static_vector&& other) noexcept
+  {
+    if (other.on_heap()) {
+      data_ = std::exchange(other.data_, other.inline_data());
+      capacity_ = std::exchange(other.capacity_, N);
+      size_ = std::exchange(other.size_, 0);
+      return;
+    }
+    std::uninitialized_move(other.begin(), other.end(), data_);
+    size_ = other.size_;
+    other.clear();
+  }
+};
+
+/**
+ * FIFO queue over a circular buffer with inline capacity and a heap fallback.
+ *
+ * This supports the `std::deque` operations used for breadth-first search.
+ * The container is neither copyable nor movable.
+ *
+ * @tparam T Value type
+ * @tparam N Inline capacity
+ */
+template <typename T, std::size_t N>
+class ring_buffer {
+  static_assert(N > 0, "inline capacity must be positive");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+
+  /**
+   * Default ctor.
+   */
+  ring_buffer() noexcept
+    : data_{std::launder(reinterpret_cast<T*>(storage_))}
+  {}
+
+  ring_buffer(const ring_buffer&) = delete;
+  ring_buffer& operator=(const ring_buffer&) = delete;
+
+  /**
+   * Dtor.
+   */
+  ~ring_buffer()
+  {
+    clear();
+    release();
+  }
+
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return !size_; }
+
+  /**
+   * Return `true` if the elements have spilled to a heap buffer.
+   */
+  bool on_heap() const noexcept
+  {
+    return data_ != reinterpret_cast<const T*>(storage_);
+  }
+
+  T& front() noexcept { return data_[head_]; }
+  const T& front() const noexcept { return data_[head_]; }
+  T& back() noexcept { return data_[wrap(head_ + size_ - 1)]; }
+  const T& back() const noexcept { return data_[wrap(head_ + size_ - 1)]; }
+
+  /**
+   * Construct an element at the back.
+   *
+   * @param args Constructor arguments
+   */
+  template <typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    if (size_ == capacity_)
+      grow();
+    auto element = ::new (data_ + wrap(head_ + size_)) T(
+      std::forward<Args>(args)...
+    );
+    size_++;
+    return *element;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * Remove the front element, which must exist.
+   */
+  void pop_front() noexcept
+  {
+    std::destroy_at(data_ + head_);
+    head_ = wrap(head_ + 1);
+    size_--;
+  }
+
+  /**
+   * Remove all the elements, keeping the capacity.
+   */
+  void clear() noexcept
+  {
+    while (size_)
+      pop_front();
+    head_ = 0;
+  }
+
+private:
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+  T* data_;
+  size_type head_{};
+  size_type size_{};
+  size_type capacity_{N};
+
+  /**
+   * Wrap an index that is less than twice the capacity.
+   */
+  size_type wrap(size_type i) const noexcept
+  {
+    return (i < capacity_) ? i : i - capacity_;
+  }
+
+  /**
+   * Move the elements in order to a heap buffer of twice the capacity.
+   *
+   * The new capacity is checked to exceed the size, which also tells the
+   * compiler that every element moved is within the new buffer.
+   */
+  void grow()
+  {
+    auto new_capacity = 2 * capacity_;
+    if (new_capacity <= size_)
+      throw_error<std::length_error>("ring_buffer capacity overflow");
+    auto new_data = std::allocator<T>{}.allocate(new_capacity);
+    for (size_type i = 0; i < size_; i++) {
+      auto& value = data_[wrap(head_ + i)];
+      ::new (new_data + i) T(std::move(value));
+      std::destroy_at(&value);
+    }
+    release();
+    data_ = new_data;
+    head_ = 0;
+    capacity_ = new_capacity;
+  }
+
+  /**
+   * Free the heap buffer, if any, without destroying any elements.
+   */
+  void release() noexcept
+  {
+    if (on_heap())
+      std::allocator<T>{}.deallocate(data_, capacity_);
+    data_ = std::launder(reinterpret_cast<T*>(storage_));
+    capacity_ = N;
+  }
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_STATIC_VECTOR_HH_
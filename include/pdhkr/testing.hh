@@ -27,10 +27,28 @@
  *    Defined with a string value during compilation providing an absolute path
  *    to a .out test case output file in a `data/` subdirectory
  *
+ * `PDHKR_TEST_EMBED`
+ *    Defined during compilation to indicate that the test case files are
+ *    embedded in the program instead of being read at runtime. In this case
+ *    `PDHKR_TEST_INPUT` and `PDHKR_TEST_OUTPUT` name `pdhkr::embedded_file`
+ *    objects instead of giving paths.
+ *
+ * `PDHKR_TEST_DATA_HEADER`
+ *    Defined with a string value during compilation when `PDHKR_TEST_EMBED`
+ *    is defined providing an absolute path to the header, generated at build
+ *    time, that defines the embedded test case files
+ *
  * When this header is included when `PDHKR_TEST` is defined, preprocessor
  * checks are used to ensure that `PDHKR_TEST_INPUT` and `PDHKR_TEST_OUTPUT`
  * are both defined. If not, an error is emitted during preprocessing.
  *
+ * Test programs open `PDHKR_TEST_INPUT` and `PDHKR_TEST_OUTPUT` with
+ * `pdhkr::test_ifstream`, which is an in-memory `pdhkr::embedded_istream` when
+ * the test case files are embedded, so test runs with embedded files do no file
+ * I/O and do not depend on `data/`. Otherwise it is `pdhkr::lz_ifstream`, which
+ * reads a `.in` or `.out` file that has been replaced by its compressed `.lz`
+ * version by decompressing it on the fly, one block at a time.
+ *
  * Note that `PDHKR_TEST` should be considered to have higher priority than
  * `PDHKR_LOCAL`. Therefore, if both macros are defined, code should be
  * structured such that `PDHKR_TEST` code is selected over `PDHKR_LOCAL` code.
@@ -39,7 +57,14 @@
 #ifndef PDHKR_TESTING_HH_
 #define PDHKR_TESTING_HH_
 
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <string_view>
+
 #include "pdhkr/compare.hh"
+#include "pdhkr/lz.hh"
 
 // building as standalone test program
 #ifdef PDHKR_TEST
@@ -50,6 +75,82 @@
 #ifndef PDHKR_TEST_OUTPUT
 #error "PDHKR_TEST_OUTPUT not defined"
 #endif  // PDHKR_TEST_OUTPUT
+#if defined(PDHKR_TEST_EMBED) && !defined(PDHKR_TEST_DATA_HEADER)
+#error "PDHKR_TEST_DATA_HEADER not defined"
+#endif  // defined(PDHKR_TEST_EMBED) && !defined(PDHKR_TEST_DATA_HEADER)
 #endif  // PDHKR_TEST
 
+namespace pdhkr {
+
+/**
+ * File contents embedded in a program.
+ */
+struct embedded_file {
+  // original file path, for messages only
+  const char* path;
+  // file bytes
+  const char* data;
+  std::size_t size;
+
+  /**
+   * Return a view of the file contents.
+   *
+   * This has the same signature as `mapped_input::view()` so either can be
+   * used to parse an entire input at once.
+   */
+  std::string_view view() const noexcept
+  {
+    return {data, size};
+  }
+};
+
+/**
+ * Input stream reading an embedded file in place.
+ */
+class embedded_istream : public std::istream {
+public:
+  /**
+   * Ctor.
+   *
+   * @param file Embedded file, which must outlive the stream
+   */
+  explicit embedded_istream(const embedded_file& file)
+    : std::istream{nullptr}, buf_{file}
+  {
+    rdbuf(&buf_);
+  }
+
+private:
+  /**
+   * Read-only stream buffer over an embedded file without any copying.
+   */
+  class embedded_buf : public std::streambuf {
+  public:
+    explicit embedded_buf(const embedded_file& file)
+    {
+      // get area pointers are non-const but the area is never written to
+      auto first = const_cast<char*>(file.data);
+      setg(first, first, first + file.size);
+    }
+  };
+
+  embedded_buf buf_;
+};
+
+/**
+ * Stream type used to open the test case input and output files.
+ */
+#if defined(PDHKR_TEST_EMBED)
+using test_ifstream = embedded_istream;
+#else
+using test_ifstream = lz_ifstream;
+#endif  // !defined(PDHKR_TEST_EMBED)
+
+}  // namespace pdhkr
+
+// embedded test case files named by PDHKR_TEST_INPUT and PDHKR_TEST_OUTPUT
+#if defined(PDHKR_TEST) && defined(PDHKR_TEST_EMBED)
+#include PDHKR_TEST_DATA_HEADER
+#endif  // defined(PDHKR_TEST) && defined(PDHKR_TEST_EMBED)
+
 #endif  // PDHKR_TESTING_HH_
@@ -0,0 +1,58 @@
+/**
+ * @file thread.hh
+ * @author Derek Huang
+ * @brief C++ header for threading helpers
+ * @copyright MIT License
+ */
+
+#ifndef PDHKR_THREAD_HH_
+#define PDHKR_THREAD_HH_
+
+#include <cstddef>
+#include <cstdlib>
+#include <thread>
+
+namespace pdhkr {
+
+/**
+ * Assumed cache line size used to keep data written by different threads apart.
+ *
+ * @note `std::hardware_destructive_interference_size` is not used since GCC
+ *  warns that its value may differ between compiler flags.
+ */
+inline constexpr std::size_t cache_line_size = 64U;
+
+/**
+ * Return the number of threads parallel code should use.
+ *
+ * This is the value of the `PDHKR_THREADS` environment variable if it is set
+ * to a positive integer, otherwise the hardware concurrency. The return value
+ * is always at least 1, where 1 means that work should be done inline on the
+ * calling thread without starting any other threads.
+ */
+inline unsigned int thread_count()
+{
+  // environment override
+  // note: MSVC warns that std::getenv is unsafe (C4996)
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4996)
+#endif  // _MSC_VER
+  auto env_value = std::getenv("PDHKR_THREADS");
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif  // _MSC_VER
+  if (env_value) {
+    // ignore unparseable or non-positive values
+    auto n_threads = std::strtol(env_value, nullptr, 10);
+    if (n_threads > 0)
+      return static_cast<unsigned int>(n_threads);
+  }
+  // hardware_concurrency() can return 0 if unknown
+  auto n_threads = std::thread::hardware_concurrency();
+  return (n_threads) ? n_threads : 1U;
+}
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_THREAD_HH_
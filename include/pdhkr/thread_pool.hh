@@ -0,0 +1,538 @@
+/**
+ * @file thread_pool.hh
+ * @author Derek Huang
+ * @brief C++ header for a work-stealing thread pool
+ * @copyright MIT License
+ *
+ * Each thread in the pool owns a Chase-Lev deque of tasks. A thread pushes and
+ * pops forked tasks at the bottom of its own deque in LIFO order, keeping its
+ * working set hot in cache, while idle threads steal the oldest and typically
+ * largest tasks from the top of other threads' deques. Parallelism is
+ * expressed through nested fork/join, which `parallel_for` builds on by
+ * recursively splitting ranges down to a grain size.
+ *
+ * @note Tasks must not throw. An exception escaping a stolen task terminates.
+ */
+
+#ifndef PDHKR_THREAD_POOL_HH_
+#define PDHKR_THREAD_POOL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "pdhkr/thread.hh"
+
+namespace pdhkr {
+
+/**
+ * Type-erased task that can be forked and later joined.
+ *
+ * Tasks live on the stack frame of the forking thread, which cannot return
+ * before the task is done, so no allocation is needed.
+ */
+class pool_task {
+public:
+  /**
+   * Run the task and mark it as done.
+   */
+  void run()
+  {
+    invoke_(this);
+    done_.store(true, std::memory_order_release);
+  }
+
+  /**
+   * Indicate if the task is done.
+   */
+  bool done() const noexcept { return done_.load(std::memory_order_acquire); }
+
+protected:
+  /**
+   * Ctor.
+   *
+   * @param invoke Function that invokes the derived task's callable
+   */
+  explicit pool_task(void (*invoke)(pool_task*)) noexcept : invoke_{invoke} {}
+
+private:
+  void (*invoke_)(pool_task*);
+  std::atomic<bool> done_{false};
+};
+
+/**
+ * Chase-Lev work-stealing deque of task pointers.
+ *
+ * The owner thread pushes and pops at the bottom while any other thread may
+ * steal from the top. Memory orderings follow Lê et al., "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013). Arrays
+ * replaced when growing are retired, not freed, until the deque is destroyed
+ * since a thief may still be reading from them.
+ */
+class work_deque {
+public:
+  /**
+   * Ctor.
+   *
+   * @param capacity Initial capacity, must be a power of 2
+   */
+  explicit work_deque(std::size_t capacity = 256U)
+  {
+    arrays_.push_back(std::make_unique<ring>(capacity));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  /**
+   * Push a task at the bottom. Must only be called by the owner.
+   */
+  void push(pool_task* task)
+  {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto a = array_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<index_type>(a->mask))
+      a = grow(a, t, b);
+    a->put(b, task);
+    // note: release store instead of release fence + relaxed store, which is
+    // equivalent here, as ThreadSanitizer does not understand fences
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  /**
+   * Pop a task from the bottom. Must only be called by the owner.
+   *
+   * @returns Task pointer, `nullptr` if empty or lost the race for the last
+   *  task to a thief
+   */
+  pool_task* pop()
+  {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    // empty
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto task = a->get(b);
+    // not the last task, so no thief can race us for it
+    if (t < b)
+      return task;
+    // last task, race thieves for it
+    if (
+      !top_.compare_exchange_strong(
+        t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+      )
+    )
+      task = nullptr;
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return task;
+  }
+
+  /**
+   * Steal a task from the top. May be called by any thread.
+   *
+   * @returns Task pointer, `nullptr` if empty or lost a race
+   */
+  pool_task* steal()
+  {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+      return nullptr;
+    auto a = array_.load(std::memory_order_acquire);
+    auto task = a->get(t);
+    if (
+      !top_.compare_exchange_strong(
+        t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+      )
+    )
+      return nullptr;
+    return task;
+  }
+
+  /**
+   * Indicate if the deque appears empty. May be called by any thread.
+   */
+  bool empty() const noexcept
+  {
+    auto t = top_.load(std::memory_order_acquire);
+    auto b = bottom_.load(std::memory_order_acquire);
+    return t >= b;
+  }
+
+private:
+  using index_type = std::int64_t;
+
+  /**
+   * Circular array of atomic task pointers.
+   */
+  struct ring {
+    explicit ring(std::size_t capacity)
+      : mask{capacity - 1},
+        slots{std::make_unique<std::atomic<pool_task*>[]>(capacity)}
+    {}
+
+    pool_task* get(index_type i) const noexcept
+    {
+      return slots[static_cast<std::size_t>(i) & mask].load(
+        std::memory_order_relaxed
+      );
+    }
+
+    void put(index_type i, pool_task* task) noexcept
+    {
+      slots[static_cast<std::size_t>(i) & mask].store(
+        task, std::memory_order_relaxed
+      );
+    }
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<pool_task*>[]> slots;
+  };
+
+  alignas(cache_line_size) std::atomic<index_type> top_{};
+  alignas(cache_line_size) std::atomic<index_type> bottom_{};
+  std::atomic<ring*> array_;
+  // current + retired arrays, only accessed by the owner
+  std::vector<std::unique_ptr<ring>> arrays_;
+
+  /**
+   * Replace the array with one of double the capacity.
+   */
+  ring* grow(ring* a, index_type t, index_type b)
+  {
+    arrays_.push_back(std::make_unique<ring>(2 * (a->mask + 1)));
+    auto grown = arrays_.back().get();
+    for (auto i = t; i < b; i++)
+      grown->put(i, a->get(i));
+    array_.store(grown, std::memory_order_release);
+    return grown;
+  }
+};
+
+/**
+ * Work-stealing thread pool.
+ *
+ * A pool of `n` threads starts `n - 1` workers, with the remaining slot taken
+ * by the thread calling `run`, `fork_join`, or `parallel_for` from outside the
+ * pool, which participates in executing tasks until its call returns. One such
+ * external thread is served at a time. A pool of 1 thread starts no workers
+ * and runs everything inline on the calling thread.
+ */
+class thread_pool {
+public:
+  /**
+   * Ctor.
+   *
+   * @param n_threads Number of threads including the calling thread, by
+   *  default `thread_count()`, which respects `PDHKR_THREADS`
+   */
+  explicit thread_pool(unsigned int n_threads = thread_count())
+    : deques_(std::max(n_threads, 1U))
+  {
+    workers_.reserve(deques_.size() - 1);
+    for (std::size_t i = 1; i < deques_.size(); i++)
+      workers_.emplace_back([this, i] { work(i); });
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * Dtor.
+   *
+   * Workers are stopped and joined. No tasks may be pending.
+   */
+  ~thread_pool()
+  {
+    {
+      std::lock_guard lock{sleep_mut_};
+      stop_ = true;
+      epoch_++;
+    }
+    sleep_cv_.notify_all();
+    for (auto& worker : workers_)
+      worker.join();
+  }
+
+  /**
+   * Return the number of threads, including the calling thread.
+   */
+  auto size() const noexcept
+  {
+    return static_cast<unsigned int>(deques_.size());
+  }
+
+  /**
+   * Run a callable on the calling thread as a member of the pool.
+   *
+   * Nested `fork_join` and `parallel_for` calls are then executed by the pool.
+   * If already on a thread of this pool, the callable is simply invoked.
+   *
+   * @param f Callable with signature `void()`
+   */
+  template <typename F>
+  void run(F&& f)
+  {
+    if (current_pool_ == this) {
+      f();
+      return;
+    }
+    // external thread takes slot 0
+    std::lock_guard lock{external_mut_};
+    auto prev_pool = std::exchange(current_pool_, this);
+    auto prev_index = std::exchange(current_index_, 0U);
+    f();
+    current_pool_ = prev_pool;
+    current_index_ = prev_index;
+  }
+
+  /**
+   * Invoke two callables, potentially in parallel, returning when both finish.
+   *
+   * `f2` is made available for stealing while `f1` runs on the calling thread.
+   * If no thread stole `f2` by the time `f1` returns, `f2` is run inline.
+   * Otherwise, the calling thread executes other tasks until `f2` is done.
+   *
+   * @param f1 Callable with signature `void()`
+   * @param f2 Callable with signature `void()`
+   */
+  template <typename F1, typename F2>
+  void fork_join(F1&& f1, F2&& f2)
+  {
+    // inline if single-threaded
+    if (size() == 1) {
+      f1();
+      f2();
+      return;
+    }
+    run(
+      [&]
+      {
+        auto& deque = deques_[current_index_];
+        callable_task<F2> task{f2};
+        deque.push(&task);
+        notify_push();
+        f1();
+        // if not stolen, it must be on the bottom of our deque
+        if (!task.done()) {
+          auto popped = deque.pop();
+          if (popped == &task)
+            task.run();
+          else
+            wait(task);
+        }
+      }
+    );
+  }
+
+  /**
+   * Invoke a callable over subranges of a range in parallel.
+   *
+   * The range is recursively halved with `fork_join` until subranges have at
+   * most `grain` elements, so idle threads steal large halves first.
+   *
+   * @param first First index
+   * @param last One past the last index
+   * @param f Callable with signature `void(std::size_t, std::size_t)` invoked
+   *  on disjoint `[first, last)` subranges that cover the range
+   * @param grain Maximum subrange size. If zero, the range is split into about
+   *  8 subranges per thread, which leaves room for load balancing
+   */
+  template <typename F>
+  void parallel_for(
+    std::size_t first, std::size_t last, F&& f, std::size_t grain = 0)
+  {
+    if (first >= last)
+      return;
+    if (!grain)
+      grain = std::max<std::size_t>(1U, (last - first) / (8U * size()));
+    // inline if single-threaded or small enough
+    if (size() == 1 || last - first <= grain) {
+      f(first, last);
+      return;
+    }
+    run([&] { split_for(first, last, f, grain); });
+  }
+
+  /**
+   * Return a reference to the default thread pool of `thread_count()` threads.
+   *
+   * The pool is created on first use.
+   */
+  static thread_pool& default_pool()
+  {
+    static thread_pool pool;
+    return pool;
+  }
+
+private:
+  /**
+   * Task referencing a callable on the forking thread's stack.
+   */
+  template <typename F>
+  class callable_task : public pool_task {
+  public:
+    explicit callable_task(F& f) noexcept : pool_task{invoke}, f_{f} {}
+
+  private:
+    F& f_;
+
+    static void invoke(pool_task* self)
+    {
+      static_cast<callable_task*>(self)->f_();
+    }
+  };
+
+  // one deque per thread, with deque 0 for the external calling thread
+  std::vector<work_deque> deques_;
+  std::vector<std::thread> workers_;
+  // serializes external threads using deque 0
+  std::mutex external_mut_;
+  // idle workers sleep on sleep_cv_ until epoch_ changes
+  std::mutex sleep_mut_;
+  std::condition_variable sleep_cv_;
+  std::uint64_t epoch_{};
+  bool stop_{};
+  std::atomic<unsigned int> n_sleeping_{};
+
+  // pool and deque index of the current thread, if any
+  static inline thread_local thread_pool* current_pool_{};
+  static inline thread_local unsigned int current_index_{};
+
+  /**
+   * Recursive halving for `parallel_for`.
+   */
+  template <typename F>
+  void split_for(std::size_t first, std::size_t last, F& f, std::size_t grain)
+  {
+    if (last - first <= grain) {
+      f(first, last);
+      return;
+    }
+    auto mid = first + (last - first) / 2;
+    fork_join(
+      [&] { split_for(first, mid, f, grain); },
+      [&] { split_for(mid, last, f, grain); }
+    );
+  }
+
+  /**
+   * Try to steal a task from another thread's deque.
+   *
+   * @param self Index of the current thread's deque
+   */
+  pool_task* steal(std::size_t self)
+  {
+    auto n = deques_.size();
+    for (std::size_t k = 1; k < n; k++) {
+      auto task = deques_[(self + k) % n].steal();
+      if (task)
+        return task;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Execute other tasks until the given task, which was stolen, is done.
+   *
+   * Our own deque is empty at this point since the task we are waiting on
+   * was at its bottom, so only steal.
+   */
+  void wait(const pool_task& task)
+  {
+    while (!task.done()) {
+      auto other = steal(current_index_);
+      if (other)
+        other->run();
+      else
+        std::this_thread::yield();
+    }
+  }
+
+  /**
+   * Wake a sleeping worker, if any, after pushing a task.
+   */
+  void notify_push()
+  {
+    // pairs with the fence in work() so that either we see the sleeper or
+    // the sleeper sees our pushed task
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!n_sleeping_.load(std::memory_order_relaxed))
+      return;
+    {
+      std::lock_guard lock{sleep_mut_};
+      epoch_++;
+    }
+    sleep_cv_.notify_one();
+  }
+
+  /**
+   * Indicate if any deque appears to have tasks.
+   */
+  bool has_work() const noexcept
+  {
+    return std::any_of(
+      deques_.begin(),
+      deques_.end(),
+      [](const auto& deque) { return !deque.empty(); }
+    );
+  }
+
+  /**
+   * Worker loop.
+   *
+   * Workers only ever steal since their own deques are empty between tasks.
+   * After a number of failed attempts a worker goes to sleep until a task is
+   * pushed.
+   *
+   * @param index Deque index
+   */
+  void work(std::size_t index)
+  {
+    current_pool_ = this;
+    current_index_ = static_cast<unsigned int>(index);
+    // number of failed steal attempts before sleeping
+    constexpr unsigned int max_spins = 64U;
+    while (true) {
+      for (unsigned int spins = 0; spins < max_spins; spins++) {
+        auto task = steal(index);
+        if (task) {
+          task->run();
+          spins = 0;
+        }
+        else
+          std::this_thread::yield();
+      }
+      std::unique_lock lock{sleep_mut_};
+      if (stop_)
+        return;
+      auto seen = epoch_;
+      n_sleeping_.fetch_add(1, std::memory_order_relaxed);
+      lock.unlock();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      // check again after announcing that we are sleeping
+      if (!has_work()) {
+        lock.lock();
+        sleep_cv_.wait(lock, [&] { return epoch_ != seen || stop_; });
+        lock.unlock();
+      }
+      n_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+}  // namespace pdhkr
+
+#endif  // PDHKR_THREAD_POOL_HH_
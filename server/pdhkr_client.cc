@@ -0,0 +1,328 @@
+/**
+ * @file pdhkr_client.cc
+ * @author Derek Huang
+ * @brief C++ client for the persistent solver server
+ * @copyright MIT License
+ *
+ * Converts a problem's HackerRank text input into a request frame, sends it
+ * to a solver server, and writes the response in the problem's text output
+ * format. This is used by the server tests and for measuring the per-request
+ * latency of a warm server against the cost of starting a solver process.
+ */
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pdhkr/error.hh"
+#include "pdhkr/mapped_input.hh"
+#include "pdhkr/server.hh"
+
+namespace {
+
+/**
+ * Print the usage message.
+ *
+ * @param out Stream to write to
+ */
+void print_usage(std::ostream& out)
+{
+  out << "Usage: pdhkr_client (--socket PATH | --spawn SERVER) [--repeat N]\n"
+         "         [--expected FILE] PROBLEM [INPUT]\n"
+         "\n"
+         "Send a problem's text input, read from INPUT or stdin, to a solver\n"
+         "server and write the text output. With --socket, connect to a\n"
+         "server listening on a Unix domain socket. With --spawn, start the\n"
+         "SERVER program and talk to it over its stdin and stdout.\n"
+         "\n"
+         "Options:\n"
+         "  --repeat N       Send the request N times and print the mean\n"
+         "                   latency per request to stderr\n"
+         "  --expected FILE  Compare the output tokens against FILE and exit\n"
+         "                   nonzero if they differ\n";
+}
+
+/**
+ * Convert a problem's text input into packed request values.
+ *
+ * Tokens are integers except for the "Subtrees And Paths" query words.
+ *
+ * @param text Text input
+ */
+auto parse_input(std::string_view text)
+{
+  auto is_space = [&text](std::size_t pos)
+  {
+    return std::isspace(static_cast<unsigned char>(text[pos]));
+  };
+  std::vector<std::int64_t> values;
+  std::size_t pos = 0;
+  while (true) {
+    while (pos < text.size() && is_space(pos))
+      pos++;
+    if (pos == text.size())
+      break;
+    auto end = pos;
+    while (end < text.size() && !is_space(end))
+      end++;
+    auto token = text.substr(pos, end - pos);
+    if (token == "add")
+      values.push_back(pdhkr::subtrees_add);
+    else if (token == "max")
+      values.push_back(pdhkr::subtrees_max);
+    else {
+      std::int64_t value;
+      auto token_end = token.data() + token.size();
+      auto [ptr, ec] = std::from_chars(token.data(), token_end, value);
+      if (ec != std::errc{} || ptr != token_end)
+        pdhkr::throw_error<std::invalid_argument>(
+          "Invalid input token " + std::string{token}
+        );
+      values.push_back(value);
+    }
+    pos = end;
+  }
+  return values;
+}
+
+/**
+ * Format response values in a problem's text output format.
+ *
+ * @param layout Output layout
+ * @param values Unpacked response payload
+ */
+std::string format_output(
+  pdhkr::output_layout layout, const std::vector<std::int64_t>& values)
+{
+  std::ostringstream out;
+  switch (layout) {
+    case pdhkr::output_layout::value_lines:
+      for (auto value : values)
+        out << value << '\n';
+      break;
+    case pdhkr::output_layout::single_line:
+      for (std::size_t i = 0; i < values.size(); i++)
+        out << (i ? " " : "") << values[i];
+      out << '\n';
+      break;
+    case pdhkr::output_layout::counted_lines:
+      for (std::size_t i = 0; i < values.size(); ) {
+        auto count = static_cast<std::size_t>(values[i++]);
+        if (count > values.size() - i)
+          pdhkr::throw_error<std::runtime_error>("Malformed response");
+        for (std::size_t j = 0; j < count; j++)
+          out << (j ? " " : "") << values[i++];
+        out << '\n';
+      }
+      break;
+    case pdhkr::output_layout::half_value_lines:
+      out << std::fixed << std::setprecision(1);
+      for (auto value : values)
+        out << value / 2.0 << '\n';
+      break;
+  }
+  return out.str();
+}
+
+/**
+ * Return `true` if two texts have the same whitespace-separated tokens.
+ *
+ * @param expected Expected text
+ * @param actual Actual text
+ */
+bool same_tokens(std::string_view expected, std::string_view actual)
+{
+  std::istringstream expected_in{std::string{expected}};
+  std::istringstream actual_in{std::string{actual}};
+  std::string expected_token;
+  std::string actual_token;
+  while (true) {
+    auto has_expected = static_cast<bool>(expected_in >> expected_token);
+    auto has_actual = static_cast<bool>(actual_in >> actual_token);
+    if (has_expected != has_actual)
+      return false;
+    if (!has_expected)
+      return true;
+    if (expected_token != actual_token)
+      return false;
+  }
+}
+
+/**
+ * Connect to a server listening on a Unix domain socket.
+ *
+ * @param path Socket path
+ * @returns Connected socket
+ */
+int connect_socket(const std::string& path)
+{
+  sockaddr_un addr{};
+  if (path.size() >= sizeof addr.sun_path)
+    pdhkr::throw_error<std::runtime_error>("Socket path too long: " + path);
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof addr.sun_path - 1);
+  auto fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    pdhkr::throw_error<std::runtime_error>("socket() failed");
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr)) {
+    ::close(fd);
+    pdhkr::throw_error<std::runtime_error>("Cannot connect to " + path);
+  }
+  return fd;
+}
+
+/**
+ * Start a server program connected to one end of a socket pair.
+ *
+ * @param server Server program path
+ * @param pid Process ID to set to the server's
+ * @returns Socket connected to the server's stdin and stdout
+ */
+int spawn_server(const char* server, pid_t& pid)
+{
+  int fds[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+    pdhkr::throw_error<std::runtime_error>("socketpair() failed");
+  pid = ::fork();
+  if (pid < 0)
+    pdhkr::throw_error<std::runtime_error>("fork() failed");
+  if (!pid) {
+    ::close(fds[0]);
+    ::dup2(fds[1], STDIN_FILENO);
+    ::dup2(fds[1], STDOUT_FILENO);
+    ::close(fds[1]);
+    ::execl(server, server, static_cast<char*>(nullptr));
+    std::cerr << "Error: Cannot run " << server << std::endl;
+    std::_Exit(EXIT_FAILURE);
+  }
+  ::close(fds[1]);
+  return fds[0];
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  std::signal(SIGPIPE, SIG_IGN);
+  const char* socket_path = nullptr;
+  const char* server = nullptr;
+  const char* expected_path = nullptr;
+  unsigned long repeat = 1;
+  const pdhkr::problem_info* problem = nullptr;
+  const char* input_path = nullptr;
+  // parse options then positional arguments
+  int i = 1;
+  for (; i < argc; i++) {
+    std::string_view arg{argv[i]};
+    if (arg == "-h" || arg == "--help") {
+      print_usage(std::cout);
+      return EXIT_SUCCESS;
+    }
+    if (arg.substr(0, 2) != "--")
+      break;
+    if (i + 1 == argc) {
+      std::cerr << "Error: Missing value for " << arg << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (arg == "--socket")
+      socket_path = argv[++i];
+    else if (arg == "--spawn")
+      server = argv[++i];
+    else if (arg == "--expected")
+      expected_path = argv[++i];
+    else if (arg == "--repeat")
+      repeat = std::strtoul(argv[++i], nullptr, 10);
+    else {
+      std::cerr << "Error: Unknown option " << arg << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (i == argc || argc - i > 2 || !socket_path == !server || !repeat) {
+    print_usage(std::cerr);
+    return EXIT_FAILURE;
+  }
+  if (!(problem = pdhkr::find_problem(argv[i]))) {
+    std::cerr << "Error: Unknown problem " << argv[i] << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (argc - i == 2)
+    input_path = argv[i + 1];
+  pid_t server_pid = -1;
+  int fd = -1;
+  int status = EXIT_SUCCESS;
+  try {
+    // build request frame once so repeats only measure the round trip
+    std::string payload;
+    if (input_path)
+      pdhkr::pack_values(
+        payload, parse_input(pdhkr::mapped_input{input_path}.view())
+      );
+    else
+      pdhkr::pack_values(payload, parse_input(pdhkr::mapped_input{}.view()));
+    fd = (socket_path) ?
+      connect_socket(socket_path) : spawn_server(server, server_pid);
+    std::string frame;
+    pdhkr::frame_header header{};
+    std::string response;
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    for (decltype(repeat) j = 0; j < repeat; j++) {
+      pdhkr::write_frame(
+        fd, static_cast<std::uint16_t>(problem->id), payload, frame
+      );
+      if (!pdhkr::read_frame(fd, header, response))
+        pdhkr::throw_error<std::runtime_error>("Server closed the connection");
+    }
+    std::chrono::duration<double, std::micro> elapsed = clock::now() - start;
+    if (repeat > 1)
+      std::cerr << repeat << " requests, " << std::fixed <<
+        std::setprecision(2) << elapsed.count() / repeat << " us/request" <<
+        std::endl;
+    if (header.code != static_cast<std::uint16_t>(pdhkr::response_status::ok))
+      pdhkr::throw_error<std::runtime_error>("Server error: " + response);
+    auto output = format_output(
+      problem->layout, pdhkr::unpack_values(response)
+    );
+    std::cout << output << std::flush;
+    if (expected_path) {
+      pdhkr::mapped_input expected{expected_path};
+      if (!same_tokens(expected.view(), output)) {
+        std::cerr << "Error: Output does not match " << expected_path <<
+          std::endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  catch (const std::exception& exc) {
+    std::cerr << "Error: " << exc.what() << std::endl;
+    status = EXIT_FAILURE;
+  }
+  // closing the connection ends a spawned server's request loop
+  if (fd >= 0)
+    ::close(fd);
+  if (server_pid > 0) {
+    int server_status;
+    ::waitpid(server_pid, &server_status, 0);
+    if (!WIFEXITED(server_status) || WEXITSTATUS(server_status))
+      status = EXIT_FAILURE;
+  }
+  return status;
+}
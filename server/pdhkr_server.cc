@@ -0,0 +1,124 @@
+/**
+ * @file pdhkr_server.cc
+ * @author Derek Huang
+ * @brief C++ persistent solver server using the pdhkr binary protocol
+ * @copyright MIT License
+ *
+ * Serves request frames from standard input, writing response frames to
+ * standard output, until standard input is closed. With `--socket PATH` the
+ * server instead listens on a Unix domain socket and serves each connection
+ * on its own thread. See `pdhkr/server.hh` for the frame format.
+ */
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "pdhkr/server.hh"
+
+namespace {
+
+/**
+ * Print the usage message.
+ *
+ * @param out Stream to write to
+ */
+void print_usage(std::ostream& out)
+{
+  out << "Usage: pdhkr_server [--socket PATH]\n"
+         "\n"
+         "Serve solver requests from stdin or from a Unix domain socket.\n";
+}
+
+/**
+ * Listen on a Unix domain socket, serving each connection on its own thread.
+ *
+ * @param path Socket path, which is replaced if it exists
+ * @returns Exit status
+ */
+int serve_socket(const std::string& path)
+{
+  sockaddr_un addr{};
+  if (path.size() >= sizeof addr.sun_path) {
+    std::cerr << "Error: Socket path too long: " << path << std::endl;
+    return EXIT_FAILURE;
+  }
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof addr.sun_path - 1);
+  auto listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    std::cerr << "Error: socket() failed: " << std::strerror(errno) <<
+      std::endl;
+    return EXIT_FAILURE;
+  }
+  ::unlink(path.c_str());
+  if (
+    ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) ||
+    ::listen(listen_fd, SOMAXCONN)
+  ) {
+    std::cerr << "Error: Cannot listen on " << path << ": " <<
+      std::strerror(errno) << std::endl;
+    ::close(listen_fd);
+    return EXIT_FAILURE;
+  }
+  while (true) {
+    auto fd = ::accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR)
+        continue;
+      std::cerr << "Error: accept() failed: " << std::strerror(errno) <<
+        std::endl;
+      break;
+    }
+    std::thread{
+      [fd]
+      {
+        try {
+          pdhkr::serve_connection(fd, fd);
+        }
+        catch (const std::exception& exc) {
+          std::cerr << "Error: " << exc.what() << std::endl;
+        }
+        ::close(fd);
+      }
+    }.detach();
+  }
+  ::close(listen_fd);
+  return EXIT_FAILURE;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  // closed connections are reported by write() instead of killing the server
+  std::signal(SIGPIPE, SIG_IGN);
+  if (argc == 1) {
+    try {
+      pdhkr::serve_connection(STDIN_FILENO, STDOUT_FILENO);
+    }
+    catch (const std::exception& exc) {
+      std::cerr << "Error: " << exc.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+  std::string_view arg{argv[1]};
+  if (arg == "-h" || arg == "--help") {
+    print_usage(std::cout);
+    return EXIT_SUCCESS;
+  }
+  if (arg == "--socket" && argc == 3)
+    return serve_socket(argv[2]);
+  print_usage(std::cerr);
+  return EXIT_FAILURE;
+}
@@ -6,15 +6,47 @@
  *
  * URL: https://www.hackerrank.com/challenges/crush/problem
  *
- * @note This naive solution times out on the larger test cases. We can sort
- *  the affected uniform intervals in O(nlog(n)) but since we need to track the
+ * Each addition is applied to a difference array as two endpoint deltas so
+ * the array values are the prefix sums of the difference array, giving the
+ * max value in a single O(n + m) sweep for n values and m additions. If n is
+ * much larger than m, only the 2m endpoints are stored, radix sorted, and swept
+ * instead, taking O(m) memory regardless of n. With `USE_EXTERNAL_SWEEP`
+ * defined the endpoints are spilled as sorted runs to temporary files past the
+ * `PDHKR_MEMORY_BUDGET` and merged while sweeping, for inputs that do not fit
+ * in memory. With `USE_PARALLEL_SCAN` defined, the dense sweep is split into
+ * per-thread blocks that are updated and scanned in parallel.
+ *
+ * With `USE_ONLINE_QUERIES` defined, the program instead answers range max
+ * queries interleaved with the additions, each operation taking O(log(n)) time
+ * with a range add, range max segment tree. The input then starts with n and
+ * the number of operations, followed by one operation per line, either
+ * `add l r k` or `max l r` with 1-based inclusive limits, and the output has
+ * the answer to each max query on its own line.
+ *
+ * With `USE_RANGE_MAX_INDEX` defined, the additions may be followed by the
+ * number of read-only range max queries and one `l r` query per line. The
+ * final array is then materialized into a range max index answering each
+ * query in O(1), and the answers follow the max value, one per line.
+ *
+ * With `USE_ALGO_LIBRARY` defined, the max value is instead computed by
+ * `pdhkr::algo::array_manipulation` from `pdhkr/algo/array_manipulation.hh`,
+ * which must then be pasted in with the pdhkr headers it includes when
+ * submitting to HackerRank.
+ *
+ * @note The original interval merging solution, available by defining
+ *  `USE_INTERVAL_MERGE`, times out on the larger test cases. We can sort the
+ *  affected uniform intervals in O(mlog(m)) but since we need to track the
  *  values updating is not linear and falls back into worst-case O(n^2).
  */
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -28,8 +60,82 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
-// don't use naive array updating solution
-#ifndef USE_ARRAY_UPDATE
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#define PDHKR_PROFILE_DETAIL(name)
+#define PDHKR_PROFILE_MEMORY(name, bytes)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// report invalid input with pdhkr::throw_error, defined here for HackerRank
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/error.hh"
+#else
+namespace pdhkr {
+
+template <typename E>
+[[noreturn]] void throw_error(const std::string& message)
+{
+  throw E{message};
+}
+
+}  // namespace pdhkr
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// parse the entire input up front with multiple threads
+#ifdef USE_PARALLEL_PARSE
+#include "pdhkr/mapped_input.hh"
+#include "pdhkr/parallel_parse.hh"
+#endif  // USE_PARALLEL_PARSE
+
+// spill sorted runs of endpoint events to temporary files past a memory budget
+#ifdef USE_EXTERNAL_SWEEP
+#include "pdhkr/external_sort.hh"
+#endif  // USE_EXTERNAL_SWEEP
+
+// update and scan blocks of the dense difference array with multiple threads
+#ifdef USE_PARALLEL_SCAN
+#include "pdhkr/thread_pool.hh"
+#endif  // USE_PARALLEL_SCAN
+
+// answer range max queries interleaved with the additions
+#ifdef USE_ONLINE_QUERIES
+#include "pdhkr/algo/segment_tree.hh"
+#endif  // USE_ONLINE_QUERIES
+
+// use the embeddable pdhkr::algo implementation of the solver core
+#ifdef USE_ALGO_LIBRARY
+#include "pdhkr/algo/array_manipulation.hh"
+#endif  // USE_ALGO_LIBRARY
+
+// answer read-only range max queries on the final array
+#if defined(USE_RANGE_MAX_INDEX)
+#if defined(USE_EXTERNAL_SWEEP) || defined(USE_PARALLEL_SCAN)
+#error "USE_RANGE_MAX_INDEX needs the default difference array"
+#endif  // defined(USE_EXTERNAL_SWEEP) || defined(USE_PARALLEL_SCAN)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif  // defined(__AVX2__)
+#endif  // defined(USE_RANGE_MAX_INDEX)
+
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
+
+namespace arena_std = std;
+
+}  // namespace pdhkr
+
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// don't use naive array updating solution or answer online queries
+#if !defined(USE_ARRAY_UPDATE) && !defined(USE_ONLINE_QUERIES)
 namespace {
 
 /**
@@ -37,20 +143,6 @@ namespace {
  */
 class uniform_interval {
 public:
-  /**
-   * Ctor.
-   *
-   * Construct an interval by reading 3 unsigned values from an input stream.
-   *
-   * @param in Input stream to read left limit, right limit, and value from
-   */
-  uniform_interval(std::istream& in)
-  {
-    in >> left_;
-    in >> right_;
-    in >> value_;  // will never exceed 1e9
-  }
-
   /**
    * Ctor.
    *
@@ -63,7 +155,10 @@ public:
     : left_{left}, right_{right}, value_{value}
   {
     if (right_ < left_)
-      throw std::runtime_error{"Right interval limit precedes left limit"};
+      pdhkr::throw_error<std::out_of_range>(
+        "Right interval limit " + std::to_string(right_) +
+        " precedes left limit " + std::to_string(left_)
+      );
   }
 
   /**
@@ -97,6 +192,8 @@ private:
   unsigned long long value_;
 };
 
+// merge intervals into disjoint intervals instead of using a difference array
+#if defined(USE_INTERVAL_MERGE)
 /**
  * Class representing an interval with non-uniform values over the interval.
  */
@@ -184,7 +281,7 @@ public:
 private:
   unsigned int left_;
   unsigned int right_;
-  std::vector<unsigned long long> values_;
+  pdhkr::arena_std::vector<unsigned long long> values_;
 };
 
 /**
@@ -194,11 +291,12 @@ private:
  *
  * @param intervals Vector of valued intervals to merge
  */
-auto merge_uniform_intervals(std::vector<uniform_interval> intervals)
+auto merge_uniform_intervals(
+  pdhkr::arena_std::vector<uniform_interval> intervals)
 {
   // unnecessary for this problem but should be added
   if (intervals.empty())
-    return std::vector<multivalued_interval>{};
+    return pdhkr::arena_std::vector<multivalued_interval>{};
   // sort by left endpoint
   std::sort(
     intervals.begin(),
@@ -206,7 +304,9 @@ auto merge_uniform_intervals(std::vector<uniform_interval> intervals)
     [](const auto& a, const auto& b) { return a.left() < b.left(); }
   );
   // merged intervals
-  std::vector<multivalued_interval> merged_intervals{intervals.front()};
+  pdhkr::arena_std::vector<multivalued_interval> merged_intervals{
+    intervals.front()
+  };
   // loop through sorted intervals
   for (decltype(intervals.size()) i = 1; i < intervals.size(); i++) {
     // last merged and current uniform interval to consider
@@ -221,9 +321,562 @@ auto merge_uniform_intervals(std::vector<uniform_interval> intervals)
   }
   return merged_intervals;
 }
+#else
+/**
+ * Change in the array values starting at an index.
+ */
+struct endpoint_event {
+  unsigned int index;
+  unsigned long long delta;
+};
+
+// sort runs that may not fit in memory, merging them while sweeping
+#if defined(USE_EXTERNAL_SWEEP)
+/**
+ * Ordering of endpoint events by index.
+ */
+struct endpoint_event_less {
+  bool operator()(const endpoint_event& a, const endpoint_event& b) const
+  {
+    return a.index < b.index;
+  }
+};
+#else
+
+/**
+ * Sort endpoint events by index.
+ *
+ * This is a stable LSD radix sort on the bytes of the 32-bit index, so it is
+ * linear in the number of events. Passes where every event has the same byte
+ * are skipped, e.g. the high bytes when all the indices are small.
+ *
+ * @param events Endpoint events to sort
+ */
+void radix_sort(pdhkr::arena_std::vector<endpoint_event>& events)
+{
+  constexpr unsigned int n_buckets = 256U;
+  pdhkr::arena_std::vector<endpoint_event> sorted(events.size());
+  for (unsigned int shift = 0; shift < 32U; shift += 8U) {
+    auto bucket = [shift](const auto& event)
+    {
+      return (event.index >> shift) & (n_buckets - 1);
+    };
+    // bucket counts, shifted by one so the partial sums are the offsets
+    std::array<std::size_t, n_buckets + 1> offsets{};
+    for (const auto& event : events)
+      offsets[bucket(event) + 1]++;
+    if (
+      std::find(offsets.begin(), offsets.end(), events.size()) !=
+      offsets.end()
+    )
+      continue;
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (const auto& event : events)
+      sorted[offsets[bucket(event)]++] = event;
+    events.swap(sorted);
+  }
+}
+#endif  // !defined(USE_EXTERNAL_SWEEP)
+
+// answer read-only range max queries on the final array
+#if defined(USE_RANGE_MAX_INDEX)
+/**
+ * Read-only range max index over piecewise constant array values.
+ *
+ * The values are split into blocks of `block_size` values and a sparse table
+ * holds the max of every power-of-two run of blocks, so a query is answered
+ * in O(1) from two overlapping table entries plus scans of the partial blocks
+ * at either end, which use AVX2 if available. The table adds
+ * O((n / block_size) * log(n / block_size)) values to the n values.
+ *
+ * Each value may hold over a run of array indices, given by the sorted start
+ * index of each run, so that huge arrays with few distinct runs of values can
+ * be indexed in memory proportional to the number of runs. Array indices are
+ * then mapped to runs with a binary search.
+ */
+class range_max_index {
+public:
+  /**
+   * Number of values per block.
+   */
+  static constexpr std::size_t block_size = 64U;
+
+  /**
+   * Ctor.
+   *
+   * @param values Non-empty array values
+   * @param starts Start index of each value's run, empty if there is one
+   *  value per index
+   */
+  explicit range_max_index(
+    pdhkr::arena_std::vector<unsigned long long> values,
+    pdhkr::arena_std::vector<unsigned int> starts = {})
+    : values_{std::move(values)},
+      starts_{std::move(starts)},
+      log2_((values_.size() + block_size - 1) / block_size + 1)
+  {
+    // floor(log2(i)) for every number of blocks
+    for (std::size_t i = 2; i < log2_.size(); i++)
+      log2_[i] = static_cast<unsigned char>(log2_[i / 2] + 1);
+    // block maxes, then maxes of runs of 2, 4, etc. blocks
+    auto n_blocks = log2_.size() - 1;
+    table_.resize(log2_[n_blocks] + 1U);
+    table_[0].resize(n_blocks);
+    for (std::size_t i = 0; i < n_blocks; i++) {
+      auto first = i * block_size;
+      auto last = std::min(first + block_size, values_.size());
+      table_[0][i] = scan(values_.data() + first, values_.data() + last);
+    }
+    for (std::size_t k = 1; k < table_.size(); k++) {
+      auto half = std::size_t{1} << (k - 1);
+      table_[k].resize(n_blocks - 2 * half + 1);
+      for (std::size_t i = 0; i < table_[k].size(); i++)
+        table_[k][i] = std::max(table_[k - 1][i], table_[k - 1][i + half]);
+    }
+  }
+
+  /**
+   * Return the max of the array values in `[first, last]`.
+   *
+   * @param first 0-based index of the first value
+   * @param last 0-based index of the last value
+   */
+  unsigned long long max(std::size_t first, std::size_t last) const
+  {
+    // map array indices to runs
+    if (starts_.size()) {
+      auto run = [this](std::size_t index)
+      {
+        return static_cast<std::size_t>(
+          std::upper_bound(starts_.begin(), starts_.end(), index) -
+          starts_.begin() - 1
+        );
+      };
+      first = run(first);
+      last = run(last);
+    }
+    const auto* data = values_.data();
+    auto first_block = first / block_size;
+    auto last_block = last / block_size;
+    if (first_block == last_block)
+      return scan(data + first, data + last + 1);
+    // partial blocks at either end, then whole blocks in between
+    auto result = std::max(
+      scan(data + first, data + (first_block + 1) * block_size),
+      scan(data + last_block * block_size, data + last + 1)
+    );
+    if (first_block + 1 < last_block) {
+      auto a = first_block + 1;
+      auto b = last_block - 1;
+      auto k = log2_[b - a + 1];
+      result = std::max(
+        {result, table_[k][a], table_[k][b + 1 - (std::size_t{1} << k)]}
+      );
+    }
+    return result;
+  }
+
+  /**
+   * Return the number of bytes of memory used.
+   */
+  std::size_t memory_bytes() const noexcept
+  {
+    auto n_bytes = sizeof(*this) +
+      values_.capacity() * sizeof(decltype(values_)::value_type) +
+      starts_.capacity() * sizeof(decltype(starts_)::value_type) +
+      log2_.capacity() + table_.capacity() * sizeof(table_[0]);
+    for (const auto& level : table_)
+      n_bytes += level.capacity() * sizeof(unsigned long long);
+    return n_bytes;
+  }
+
+private:
+  pdhkr::arena_std::vector<unsigned long long> values_;
+  pdhkr::arena_std::vector<unsigned int> starts_;
+  pdhkr::arena_std::vector<unsigned char> log2_;
+  pdhkr::arena_std::vector<pdhkr::arena_std::vector<unsigned long long>> table_;
+
+  /**
+   * Return the max of a non-empty range of values.
+   *
+   * @param first Pointer to the first value
+   * @param last Pointer one past the last value
+   */
+  static unsigned long long scan(
+    const unsigned long long* first, const unsigned long long* last) noexcept
+  {
+    unsigned long long result = 0;
+#if defined(__AVX2__)
+    // values are at most 2e14 so the signed 64-bit compare orders them
+    auto acc = _mm256_setzero_si256();
+    for (; last - first >= 4; first += 4) {
+      auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+      acc = _mm256_blendv_epi8(acc, v, _mm256_cmpgt_epi64(v, acc));
+    }
+    alignas(32) unsigned long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    result = std::max({lanes[0], lanes[1], lanes[2], lanes[3]});
+#else
+    // independent maxes that the compiler can vectorize
+    unsigned long long lanes[4]{};
+    for (; last - first >= 4; first += 4)
+      for (unsigned int i = 0; i < 4U; i++)
+        lanes[i] = std::max(lanes[i], first[i]);
+    result = std::max({lanes[0], lanes[1], lanes[2], lanes[3]});
+#endif  // !defined(__AVX2__)
+    for (; first != last; first++)
+      result = std::max(result, *first);
+    return result;
+  }
+};
+#endif  // defined(USE_RANGE_MAX_INDEX)
+
+/**
+ * Difference array of an array of values that starts out zeroed.
+ *
+ * Each uniform interval is applied as two endpoint deltas, adding the value at
+ * the left limit and subtracting it after the right limit, so the array values
+ * are the prefix sums of the deltas.
+ *
+ * If the array is much larger than the number of intervals, only the 2m
+ * endpoint events of the m intervals are stored and the max value is found by
+ * sorting them and sweeping a running sum, so memory use is O(m) regardless of
+ * the array size. Otherwise the deltas are stored densely, one per index.
+ *
+ * If `USE_EXTERNAL_SWEEP` is defined, the endpoint events are instead handed
+ * to a `pdhkr::external_sorter`, which spills sorted runs to temporary files
+ * once they exceed the `pdhkr::memory_budget()`, and the sweep is done while
+ * merging the runs, so inputs of any size can be handled in bounded memory.
+ * Storage is then also sparse if the dense deltas would exceed the budget.
+ *
+ * If `USE_RANGE_MAX_INDEX` is defined, the array values can instead be
+ * materialized into a `range_max_index`, one value per index for dense storage
+ * or one value per run between endpoint indices for sparse storage.
+ *
+ * If `USE_PARALLEL_SCAN` is defined, dense storage is split into one block of
+ * indices per thread of the default `pdhkr::thread_pool`. The endpoint events
+ * are bucketed by block as they are added and the max value is found in two
+ * parallel passes. First each thread zeroes its own block delta array, applies
+ * its bucket of events, and sums its deltas. An exclusive scan of the block
+ * sums then gives each block's starting value, from which each thread scans
+ * its block for the block max, so the whole array is swept by all the threads
+ * instead of one.
+ */
+class difference_array {
+public:
+  /**
+   * Ratio of array size to number of intervals past which storage is sparse.
+   *
+   * A sparse event takes 16 bytes and is copied once when sorting, so sparse
+   * storage uses less memory than a dense 8-byte delta per index past this.
+   */
+  static constexpr unsigned int sparse_ratio = 16U;
+
+#if defined(USE_PARALLEL_SCAN)
+  /**
+   * Minimum number of indices per block, so small arrays use fewer threads.
+   */
+  static constexpr std::size_t block_min_size = 1U << 16;
+#endif  // USE_PARALLEL_SCAN
+
+  /**
+   * Ctor.
+   *
+   * @param size Array size
+   * @param n_intervals Number of intervals that will be added
+   */
+  difference_array(unsigned int size, unsigned int n_intervals)
+    : size_{size}, sparse_{size / sparse_ratio > n_intervals}
+  {
+#if defined(USE_EXTERNAL_SWEEP)
+    sparse_ = sparse_ ||
+      (size_ + 1ULL) * sizeof(unsigned long long) > pdhkr::memory_budget();
+    if (sparse_)
+      return;
+#else
+    if (sparse_) {
+      events_.reserve(2UL * n_intervals);
+      return;
+    }
+#endif  // !defined(USE_EXTERNAL_SWEEP)
+    // one extra element to subtract additions ending at the last array value
+#if defined(USE_PARALLEL_SCAN)
+    auto n_blocks = std::clamp<std::size_t>(
+      (size_ + 1ULL) / block_min_size,
+      1U,
+      pdhkr::thread_pool::default_pool().size()
+    );
+    block_size_ = (size_ + 1ULL + n_blocks - 1) / n_blocks;
+    // assume the events are spread evenly over the blocks
+    buckets_.resize(n_blocks);
+    for (auto& bucket : buckets_)
+      bucket.reserve(2UL * n_intervals / n_blocks);
+#else
+    deltas_.resize(size_ + 1UL);
+#endif  // !defined(USE_PARALLEL_SCAN)
+  }
+
+  /**
+   * Indicate if only the interval endpoints are stored.
+   */
+  bool sparse() const noexcept
+  {
+    return sparse_;
+  }
+
+  /**
+   * Add a uniform interval.
+   *
+   * @param interval Uniform interval with 1-based limits
+   */
+  void add(const uniform_interval& interval)
+  {
+    // 1 <= left <= right <= size, where the uniform_interval checks the middle
+    if (!interval.left() || interval.right() > size_)
+      pdhkr::throw_error<std::out_of_range>(
+        "Interval [" + std::to_string(interval.left()) + ", " +
+        std::to_string(interval.right()) + "] outside of array of size " +
+        std::to_string(size_)
+      );
+    // unsigned wraparound is fine since every prefix sum is nonnegative
+    if (sparse_) {
+#if defined(USE_EXTERNAL_SWEEP)
+      events_.push({interval.left() - 1, interval.value()});
+      events_.push({interval.right(), 0ULL - interval.value()});
+#else
+      events_.push_back({interval.left() - 1, interval.value()});
+      events_.push_back({interval.right(), 0ULL - interval.value()});
+#endif  // !defined(USE_EXTERNAL_SWEEP)
+    }
+    else {
+#if defined(USE_PARALLEL_SCAN)
+      buckets_[(interval.left() - 1) / block_size_].push_back(
+        {interval.left() - 1, interval.value()}
+      );
+      buckets_[interval.right() / block_size_].push_back(
+        {interval.right(), 0ULL - interval.value()}
+      );
+#else
+      deltas_[interval.left() - 1] += interval.value();
+      deltas_[interval.right()] -= interval.value();
+#endif  // !defined(USE_PARALLEL_SCAN)
+    }
+  }
+
+  /**
+   * Return the max array value.
+   *
+   * If storage is sparse, the endpoint events are sorted by index.
+   */
+  unsigned long long max_value()
+  {
+    unsigned long long value = 0;
+    unsigned long long max_value = 0;
+    if (sparse_) {
+      // values only change at event indices, where all the events at the same
+      // index must be applied before the value is considered
+      bool started = false;
+      unsigned int index = 0;
+      auto sweep = [&](const endpoint_event& event)
+      {
+        if (started && event.index != index)
+          max_value = std::max(max_value, value);
+        started = true;
+        index = event.index;
+        value += event.delta;
+      };
+#if defined(USE_EXTERNAL_SWEEP)
+      events_.drain(sweep);
+#else
+      radix_sort(events_);
+      std::for_each(events_.begin(), events_.end(), sweep);
+#endif  // !defined(USE_EXTERNAL_SWEEP)
+      max_value = std::max(max_value, value);
+    }
+    // last element only cancels out the additions to the last array value
+    else {
+#if defined(USE_PARALLEL_SCAN)
+      max_value = parallel_max_value();
+#else
+      for (std::size_t i = 0; i < size_; i++) {
+        value += deltas_[i];
+        max_value = std::max(max_value, value);
+      }
+#endif  // !defined(USE_PARALLEL_SCAN)
+    }
+    return max_value;
+  }
+
+#if defined(USE_RANGE_MAX_INDEX)
+  /**
+   * Return a range max index over the array values, consuming the storage.
+   */
+  range_max_index build_index()
+  {
+    if (!sparse_) {
+      // last element only cancels out the additions to the last array value
+      deltas_.pop_back();
+      std::partial_sum(deltas_.begin(), deltas_.end(), deltas_.begin());
+      return range_max_index{std::move(deltas_)};
+    }
+    // one run starting at each distinct endpoint index within the array
+    radix_sort(events_);
+    pdhkr::arena_std::vector<unsigned long long> values{0ULL};
+    pdhkr::arena_std::vector<unsigned int> starts{0U};
+    unsigned long long value = 0;
+    for (const auto& event : events_) {
+      // events are sorted, so the rest are also past the last value
+      if (event.index == size_)
+        break;
+      value += event.delta;
+      if (event.index == starts.back())
+        values.back() = value;
+      else {
+        starts.push_back(event.index);
+        values.push_back(value);
+      }
+    }
+    events_ = {};
+    return range_max_index{std::move(values), std::move(starts)};
+  }
+#endif  // defined(USE_RANGE_MAX_INDEX)
+
+private:
+  unsigned int size_;
+  bool sparse_;
+#if defined(USE_PARALLEL_SCAN)
+  std::size_t block_size_{};
+  pdhkr::arena_std::vector<pdhkr::arena_std::vector<endpoint_event>> buckets_;
+
+  /**
+   * Return the max array value of dense storage using the thread pool.
+   */
+  unsigned long long parallel_max_value()
+  {
+    auto n_blocks = buckets_.size();
+    // per-thread block delta arrays, allocated by the thread using them
+    std::vector<std::vector<unsigned long long>> deltas(n_blocks);
+    // sum of each block's deltas, shifted by one for the exclusive scan
+    std::vector<unsigned long long> offsets(n_blocks + 1);
+    auto& pool = pdhkr::thread_pool::default_pool();
+    // first pass: apply each bucket to its block and sum the block
+    pool.parallel_for(
+      0,
+      n_blocks,
+      [&](std::size_t first, std::size_t last)
+      {
+        PDHKR_PROFILE_SCOPE(solve);
+        for (auto i = first; i < last; i++) {
+          auto block_first = i * block_size_;
+          auto block_last = std::min<std::size_t>(
+            block_first + block_size_, size_ + 1ULL
+          );
+          auto& block = deltas[i];
+          block.resize(block_last - block_first);
+          for (const auto& event : buckets_[i])
+            block[event.index - block_first] += event.delta;
+          buckets_[i] = {};
+          offsets[i + 1] = std::accumulate(block.begin(), block.end(), 0ULL);
+        }
+      },
+      1
+    );
+    // exclusive scan gives the value before each block
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    // second pass: running sum from each block's starting value
+    std::vector<unsigned long long> block_max(n_blocks);
+    pool.parallel_for(
+      0,
+      n_blocks,
+      [&](std::size_t first, std::size_t last)
+      {
+        PDHKR_PROFILE_SCOPE(solve);
+        for (auto i = first; i < last; i++) {
+          // skip the extra element at the end of the last block
+          auto n_values = std::min<std::size_t>(
+            deltas[i].size(), size_ - i * block_size_
+          );
+          auto value = offsets[i];
+          auto max_value = 0ULL;
+          for (std::size_t j = 0; j < n_values; j++) {
+            value += deltas[i][j];
+            max_value = std::max(max_value, value);
+          }
+          block_max[i] = max_value;
+          deltas[i] = {};
+        }
+      },
+      1
+    );
+    return *std::max_element(block_max.begin(), block_max.end());
+  }
+#else
+  pdhkr::arena_std::vector<unsigned long long> deltas_;
+#endif  // !defined(USE_PARALLEL_SCAN)
+#if defined(USE_EXTERNAL_SWEEP)
+  pdhkr::external_sorter<endpoint_event, endpoint_event_less> events_;
+#else
+  pdhkr::arena_std::vector<endpoint_event> events_;
+#endif  // !defined(USE_EXTERNAL_SWEEP)
+};
+#endif  // !defined(USE_INTERVAL_MERGE)
+
+}  // namespace
+#endif  // !defined(USE_ARRAY_UPDATE) && !defined(USE_ONLINE_QUERIES)
+
+// answer range max queries interleaved with the additions
+#if defined(USE_ONLINE_QUERIES)
+namespace {
+
+/**
+ * Apply range additions and answer range max queries in input order.
+ *
+ * Values are 64-bit signed integers, all initially zero, and additions may be
+ * negative. The max of each `max l r` query is written on its own line.
+ *
+ * @param in Stream to read the array size, operation count, and operations from
+ * @param out Stream to write the query answers to
+ */
+void answer_queries(std::istream& in, std::ostream& out)
+{
+  std::size_t size;
+  std::size_t n_ops;
+  in >> size >> n_ops;
+  pdhkr::algo::range_add_max_tree<long long> values{size};
+  // each operation is read, applied, and answered before the next, so the
+  // whole loop is timed as solving instead of switching phases per operation
+  PDHKR_PROFILE_PHASE(solve);
+  std::string op;
+  for (decltype(n_ops) i = 0; i < n_ops; i++) {
+    // operation name, left limit, right limit
+    std::size_t left;
+    std::size_t right;
+    if (!(in >> op >> left >> right))
+      pdhkr::throw_error<std::runtime_error>("Failed to read operation");
+    if (!left || right < left || right > size)
+      pdhkr::throw_error<std::out_of_range>(
+        "Interval [" + std::to_string(left) + ", " + std::to_string(right) +
+        "] outside of array of size " + std::to_string(size)
+      );
+    // add value to the range
+    if (op == "add") {
+      long long value;
+      if (!(in >> value))
+        pdhkr::throw_error<std::runtime_error>("Failed to read added value");
+      values.add(left - 1, right, value);
+    }
+    // write the range max
+    else if (op == "max")
+      out << values.max(left - 1, right) << '\n';
+    else
+      pdhkr::throw_error<std::runtime_error>("Unknown operation " + op);
+  }
+  PDHKR_PROFILE_PHASE(output);
+  out << std::flush;
+}
 
 }  // namespace
-#endif  // USE_ARRAY_UPDATE
+#endif  // USE_ONLINE_QUERIES
 
 int main()
 {
@@ -231,51 +884,112 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #else
   auto& fout = std::cout;
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST)
-  // array size
-  unsigned int array_size;
-  fin >> array_size;
+  PDHKR_PROFILE_PHASE(parse);
+// answer queries as they are read
+#if defined(USE_ONLINE_QUERIES)
+  answer_queries(fin, fout);
+#else
+// read next value from flat array of all the input values
+#if defined(USE_PARALLEL_PARSE)
+#if defined(PDHKR_TEST) && defined(PDHKR_TEST_EMBED)
+  const auto& input = PDHKR_TEST_INPUT;
+#elif defined(PDHKR_TEST)
+  pdhkr::mapped_input input{PDHKR_TEST_INPUT};
+#else
+  pdhkr::mapped_input input;
+#endif  // !defined(PDHKR_TEST)
+  auto input_values = pdhkr::parse_integers<unsigned int>(input.view());
+  auto input_it = input_values.cbegin();
+  auto read_value = [&input_it, &input_values]
+  {
+    if (input_it == input_values.cend())
+      pdhkr::throw_error<std::runtime_error>("Input ended before all values");
+    return *input_it++;
+  };
+  [[maybe_unused]] auto has_value = [&]
+  {
+    return input_it != input_values.cend();
+  };
+// read next value from the input stream
+#else
+  auto read_value = [&fin]
+  {
+    unsigned int value = 0;
+    if (!(fin >> value))
+      pdhkr::throw_error<std::runtime_error>("Failed to read input value");
+    return value;
+  };
+  [[maybe_unused]] auto has_value = [&fin] { return !(fin >> std::ws).eof(); };
+#endif  // !defined(USE_PARALLEL_PARSE)
+  // array size, not needed when merging intervals
+  [[maybe_unused]] auto array_size = read_value();
   // number of operations
-  unsigned int n_ops;
-  fin >> n_ops;
+  auto n_ops = read_value();
 // use naive array updating solution
 #if defined(USE_ARRAY_UPDATE)
   // create array and perform operations. we need long long (64 bits) type
-  // since based on the problem constraints, max array value can be 2e14
+  // since based on the problem constraints, max array value can be 2e14.
+  // each operation is applied as it is read, so both are timed as solving
+  PDHKR_PROFILE_PHASE(solve);
   std::vector<unsigned long long> values(array_size, 0UL);
-#else
-  std::vector<uniform_interval> intervals;
-  intervals.reserve(array_size);
-#endif  // !defined(USE_ARRAY_UPDATE)
   for (decltype(n_ops) i = 0; i < n_ops; i++) {
-#if defined(USE_ARRAY_UPDATE)
     // left index, right index, summand
-    unsigned int l_index, r_index, summand;
-    fin >> l_index;
-    fin >> r_index;
-    fin >> summand;
-    // apply to array
+    auto l_index = read_value();
+    auto r_index = read_value();
+    auto summand = read_value();
     std::transform(
       values.begin() + (l_index - 1),
       values.begin() + r_index,
       values.begin() + (l_index - 1),
       [summand](const auto& v) { return v + summand; }
     );
+  }
+#elif defined(USE_INTERVAL_MERGE)
+  pdhkr::arena_std::vector<uniform_interval> intervals;
+  intervals.reserve(n_ops);
+  for (decltype(n_ops) i = 0; i < n_ops; i++) {
+    // left limit, right limit, value
+    auto left = read_value();
+    auto right = read_value();
+    intervals.emplace_back(left, right, read_value());
+  }
+#elif defined(USE_ALGO_LIBRARY)
+  // left limit, right limit, value of each operation. the library takes the
+  // operations as an iterator range so they are all read first
+  pdhkr::arena_std::vector<std::array<unsigned int, 3>> ops(n_ops);
+  for (auto& [left, right, value] : ops) {
+    left = read_value();
+    right = read_value();
+    value = read_value();
+  }
 #else
-    intervals.emplace_back(fin);
-#endif  // !defined(USE_ARRAY_UPDATE)
+  // each operation is applied to the difference array, or streamed into the
+  // external sorter, as it is read, so both are timed as building
+  PDHKR_PROFILE_PHASE(build);
+  difference_array deltas{array_size, n_ops};
+  for (decltype(n_ops) i = 0; i < n_ops; i++) {
+    // left limit, right limit, value
+    auto left = read_value();
+    auto right = read_value();
+    deltas.add({left, right, read_value()});
   }
+#endif  // !defined(USE_ARRAY_UPDATE) && !defined(USE_INTERVAL_MERGE) && ...
   // write result
 #if defined(USE_ARRAY_UPDATE)
-  fout << *std::max_element(values.begin(), values.end()) << std::endl;
-#else
+  auto max_value = *std::max_element(values.begin(), values.end());
+  PDHKR_PROFILE_PHASE(output);
+  fout << max_value << std::endl;
+#elif defined(USE_INTERVAL_MERGE)
+  PDHKR_PROFILE_PHASE(build);
   auto merged_intervals = merge_uniform_intervals(std::move(intervals));
+  PDHKR_PROFILE_PHASE(solve);
   auto max_it = std::max_element(
     merged_intervals.begin(),
     merged_intervals.end(),
@@ -286,17 +1000,76 @@ int main()
       return max_a < max_b;
     }
   );
-  fout << *std::max_element(max_it->begin(), max_it->end()) << std::endl;
-#endif  // !defined(USE_ARRAY_UPDATE)
+  auto max_value = *std::max_element(max_it->begin(), max_it->end());
+  PDHKR_PROFILE_PHASE(output);
+  fout << max_value << std::endl;
+#elif defined(USE_ALGO_LIBRARY)
+  PDHKR_PROFILE_PHASE(solve);
+  auto max_value = pdhkr::algo::array_manipulation(
+    array_size, ops.begin(), ops.end()
+  );
+  PDHKR_PROFILE_PHASE(output);
+  fout << max_value << std::endl;
+#elif defined(USE_RANGE_MAX_INDEX)
+  // materialize the array into the index, still in the build phase but also
+  // timed on its own as the index detail along with its memory use
+  auto index = [&deltas]
+  {
+    PDHKR_PROFILE_DETAIL(index);
+    return deltas.build_index();
+  }();
+  PDHKR_PROFILE_MEMORY(index, index.memory_bytes());
+  // read-only queries, if any, as 0-based index ranges
+  PDHKR_PROFILE_PHASE(parse);
+  std::vector<std::pair<unsigned int, unsigned int>> queries;
+  if (has_value()) {
+    queries.resize(read_value());
+    for (auto& [left, right] : queries) {
+      left = read_value();
+      right = read_value();
+      if (!left || right < left || right > array_size)
+        pdhkr::throw_error<std::out_of_range>(
+          "Query [" + std::to_string(left) + ", " + std::to_string(right) +
+          "] outside of array of size " + std::to_string(array_size)
+        );
+      left--;
+      right--;
+    }
+  }
+  // max value then answers
+  PDHKR_PROFILE_PHASE(solve);
+  auto max_value = index.max(0, array_size - 1);
+  std::vector<unsigned long long> answers(queries.size());
+  for (std::size_t i = 0; i < queries.size(); i++)
+    answers[i] = index.max(queries[i].first, queries[i].second);
+  PDHKR_PROFILE_PHASE(output);
+  fout << max_value << '\n';
+  for (auto answer : answers)
+    fout << answer << '\n';
+  fout << std::flush;
+#else
+  PDHKR_PROFILE_PHASE(solve);
+  auto max_value = deltas.max_value();
+  PDHKR_PROFILE_PHASE(output);
+  fout << max_value << std::endl;
+#endif  // !defined(USE_ARRAY_UPDATE) && !defined(USE_INTERVAL_MERGE) && ...
+#endif  // !defined(USE_ONLINE_QUERIES)
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(compare);
+#if defined(USE_ONLINE_QUERIES)
+  return pdhkr::exit_compare<long long>(fans, fout);
+#else
 #if defined(USE_ARRAY_UPDATE)
   return pdhkr::exit_compare<decltype(values)::value_type>(fans, fout);
-#else
+#elif defined(USE_INTERVAL_MERGE)
   // or std::remove_const_t<std::remove_reference_t<...>>
   using value_type = std::decay_t<decltype(max_it->values())>::value_type;
   return pdhkr::exit_compare<value_type>(fans, fout);
-#endif  // !defined(USE_ARRAY_UPDATE)
+#else
+  return pdhkr::exit_compare<decltype(max_value)>(fans, fout);
+#endif  // !defined(USE_ARRAY_UPDATE) && !defined(USE_INTERVAL_MERGE)
+#endif  // !defined(USE_ONLINE_QUERIES)
 #else
   return EXIT_SUCCESS;
 #endif  // !defined(PDHKR_TEST)
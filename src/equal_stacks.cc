@@ -5,12 +5,15 @@
  * @copyright MIT License
  *
  * URL: https://www.hackerrank.com/challenges/equal-stacks/problem
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::max_equal_height` from
+ * `pdhkr/algo/equal_stacks.hh`, which must be pasted in with the pdhkr headers
+ * it includes when submitting to HackerRank.
  */
 
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
-#include <numeric>
 #include <vector>
 
 // only used when compiling as standalone test program
@@ -21,16 +24,22 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/equal_stacks.hh"
+
 namespace {
 
 /**
  * Return maximum equalized height of the three "stacks" after element removal.
  *
- * Elements are treated as being removed from the front of the vectors, i.e.
- * from the "top" of the "stack". Nothing is actually physically removed and
- * instead we track the sum of the stack values, incrementally removing until
- * we are able to equalize the heights or until a stack in empty (zero).
- *
  * @param stack_1 First "stack"
  * @param stack_2 Second "stack"
  * @param stack_3 Third "stack"
@@ -40,39 +49,14 @@ auto max_equal_height(
   const std::vector<unsigned int>& stack_2,
   const std::vector<unsigned int>& stack_3)
 {
-  // if any is empty, zero
-  if (stack_1.empty() || stack_2.empty() || stack_3.empty())
-    return 0U;
-  // compute totals for each "stack"
-  auto total_1 = std::accumulate(stack_1.begin(), stack_1.end(), 0U);
-  auto total_2 = std::accumulate(stack_2.begin(), stack_2.end(), 0U);
-  auto total_3 = std::accumulate(stack_3.begin(), stack_3.end(), 0U);
-  // iterators tracking the "top" of each "stack"
-  auto top_it_1 = stack_1.begin();
-  auto top_it_2 = stack_2.begin();
-  auto top_it_3 = stack_3.begin();
-  // while the totals are unequal
-  while (total_1 != total_2 || total_2 != total_3) {
-    // if a stack runs empty, must return zero
-    if (
-      top_it_1 == stack_1.end() ||
-      top_it_2 == stack_2.end() ||
-      top_it_3 == stack_3.end()
-    )
-      return 0U;
-    // compute total of totals and floor divide by 3 to estimate max height.
-    // no need to worry about addition overflow given the problem limits
-    auto est_max = (total_1 + total_2 + total_3) / 3U;
-    // if a total exceeds est_max, remove an element and adjust iterator
-    if (total_1 > est_max)
-      total_1 -= *top_it_1++;
-    if (total_2 > est_max)
-      total_2 -= *top_it_2++;
-    if (total_3 > est_max)
-      total_3 -= *top_it_3++;
-  }
-  // all totals same when done (first picked arbitrarily)
-  return total_1;
+  return pdhkr::algo::max_equal_height(
+    stack_1.begin(),
+    stack_1.end(),
+    stack_2.begin(),
+    stack_2.end(),
+    stack_3.begin(),
+    stack_3.end()
+  );
 }
 
 }  // namespace
@@ -83,9 +67,9 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #elif defined(PDHKR_LOCAL)
   // for local run, this is simply std::cout
   auto& fout = std::cout;
@@ -96,6 +80,7 @@ int main()
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
   // read number of items in each stack
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_1, n_2, n_3;
   fin >> n_1;
   fin >> n_2;
@@ -109,11 +94,15 @@ int main()
     fin >> stack_2[i];
   for (decltype(n_3) i = 0; i < n_3; i++)
     fin >> stack_3[i];
-  // write max height of equalized stacks
-  fout << max_equal_height(stack_1, stack_2, stack_3) << std::endl;
+  // compute + write max height of equalized stacks
+  PDHKR_PROFILE_PHASE(solve);
+  auto height = max_equal_height(stack_1, stack_2, stack_3);
+  PDHKR_PROFILE_PHASE(output);
+  fout << height << std::endl;
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
-  return pdhkr::exit_compare<decltype(max_equal_height({}, {}, {}))>(fans, fout);
+  PDHKR_PROFILE_PHASE(compare);
+  return pdhkr::exit_compare<decltype(height)>(fans, fout);
 #else
   return EXIT_SUCCESS;
 #endif  // !defined(PDHKR_TEST)
@@ -5,15 +5,15 @@
  * @copyright MIT License
  *
  * URL: https://www.hackerrank.com/challenges/jesse-and-cookies/problem
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::mixing_count` from
+ * `pdhkr/algo/jesse_and_cookies.hh`, which must be pasted in with the pdhkr
+ * headers it includes when submitting to HackerRank.
  */
 
-#include <algorithm>
 #include <cstdlib>
 #include <fstream>
-#include <functional>
 #include <iostream>
-#include <queue>
-#include <type_traits>
 #include <vector>
 
 // only used when compiling as standalone test program
@@ -24,52 +24,31 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/jesse_and_cookies.hh"
+
 namespace {
 
 /**
  * Return number of times values are mixed before they all reach the target.
  *
- * Letting, `m_1` and `m_2` be the lowest two values at any iteration, mixing
- * results in the `m_1 + 2 * m_2` value being added to the value vector while
- * removing the original `m_1` and `m_2` values from the vector. This means
- * that the returned mixing count value will never exceed `values.size() - 1`.
- *
  * @param values Values vector
  * @param target Target value to reach via mixing
  * @returns Mixing count, -1 if not possible
  */
 int mixing_count(const std::vector<unsigned int>& values, unsigned long target)
 {
-  // not possible if values is empty
-  if (values.empty())
-    return -1;
-  // mixing count
-  int count = 0;
-  // insert elements into min queue
-  using queue_type = std::priority_queue<
-    std::decay_t<decltype(values)>::value_type,
-    std::decay_t<decltype(values)>,
-    std::greater<std::decay_t<decltype(values)>::value_type>
-  >;
-  queue_type queue{values.begin(), values.end()};
-  // perform mixing while we can still mix
-  while (queue.size() >= 2) {
-    // if all remaining values >= target, we are done
-    if (queue.top() >= target)
-      return count;
-    // get minimum + delete from values
-    auto m_1 = queue.top();
-    queue.pop();
-    auto m_2 = queue.top();
-    queue.pop();
-    // add mixed value and increment count
-    queue.push(m_1 + 2 * m_2);
-    count++;
-  }
-  if (queue.top() >= target)
-    return count;
-  // otherwise failed
-  return -1;
+  return static_cast<int>(
+    pdhkr::algo::mixing_count(values.begin(), values.end(), target)
+  );
 }
 
 }  // namespace
@@ -80,9 +59,9 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #elif defined(PDHKR_LOCAL)
   // for local run, this is simply std::cout
   auto& fout = std::cout;
@@ -93,6 +72,7 @@ int main()
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
   // read number of values + target value
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_values;
   decltype(n_values) target;
   fin >> n_values;
@@ -101,11 +81,15 @@ int main()
   std::vector<unsigned int> values(n_values);
   for (auto& value : values)
     fin >> value;
-  // write mixing count (-1 if not possible)
-  fout << mixing_count(values, target) << std::endl;
+  // compute + write mixing count (-1 if not possible)
+  PDHKR_PROFILE_PHASE(solve);
+  auto count = mixing_count(values, target);
+  PDHKR_PROFILE_PHASE(output);
+  fout << count << std::endl;
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
-  return pdhkr::exit_compare<decltype(mixing_count(values, 0))>(fans, fout);
+  PDHKR_PROFILE_PHASE(compare);
+  return pdhkr::exit_compare<decltype(count)>(fans, fout);
 #else
   return EXIT_SUCCESS;
 #endif  // !defined(PDHKR_TEST)
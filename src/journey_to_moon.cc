@@ -8,6 +8,7 @@
  */
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <deque>
 #include <fstream>
@@ -28,6 +29,71 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// use the embeddable pdhkr::algo implementation of the solver core
+#ifdef USE_ALGO_LIBRARY
+#include "pdhkr/algo/journey_to_moon.hh"
+#endif  // USE_ALGO_LIBRARY
+
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
+
+namespace arena_std = std;
+
+}  // namespace pdhkr
+
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// preallocate the country sizes and BFS queue from the declared constraints
+#ifdef USE_STATIC_CAPACITY
+#include "pdhkr/constraints.hh"
+#include "pdhkr/static_vector.hh"
+#endif  // USE_STATIC_CAPACITY
+
+// use flat open-addressing hash containers instead of node-based ones
+#ifdef USE_FLAT_HASH
+#include "pdhkr/flat_hash.hh"
+#endif  // USE_FLAT_HASH
+
+// use a compressed sparse row graph with flat BFS arrays
+#ifdef USE_CSR_GRAPH
+#include "pdhkr/graph.hh"
+#endif  // USE_CSR_GRAPH
+
+// union astronaut pairs as they are parsed instead of storing and searching
+#ifdef USE_DSU
+#include "pdhkr/dsu.hh"
+#endif  // USE_DSU
+
+// print the pair count after each astronaut pair is united
+#if defined(USE_ONLINE_EDGES) && !defined(USE_DSU)
+#error "USE_ONLINE_EDGES needs the union-find of USE_DSU"
+#endif  // defined(USE_ONLINE_EDGES) && !defined(USE_DSU)
+
+// hash containers for the graph and visited tracking
+#if defined(USE_FLAT_HASH)
+template <typename T>
+using hash_set = pdhkr::flat_hash_set<T>;
+template <typename K, typename V>
+using hash_map = pdhkr::flat_hash_map<K, V>;
+#else
+template <typename T>
+using hash_set = pdhkr::arena_std::unordered_set<T>;
+template <typename K, typename V>
+using hash_map = pdhkr::arena_std::unordered_map<K, V>;
+#endif  // !defined(USE_FLAT_HASH)
+
 /**
  * Adjacency list class.
  *
@@ -128,7 +194,7 @@ public:
   }
 
 private:
-  std::unordered_map<T, std::unordered_set<T>> edges_;
+  hash_map<T, hash_set<T>> edges_;
 };
 
 /**
@@ -136,6 +202,33 @@ private:
  */
 using edge_vector = std::vector<std::pair<unsigned int, unsigned int>>;
 
+#if defined(USE_DSU)
+/**
+ * Return the number of pairs of astronauts from different countries.
+ *
+ * The count is kept up to date by each union, so this is O(1) and can be
+ * called after any astronaut pair is united.
+ *
+ * @param n Number of astronauts
+ * @param astronauts Countries of the astronauts paired so far
+ */
+auto journey_to_moon(
+  unsigned int /*n*/, const pdhkr::disjoint_sets<unsigned int>& astronauts)
+{
+  return astronauts.n_separate_pairs();
+}
+#elif defined(USE_ALGO_LIBRARY)
+/**
+ * Return the number of pairs of astronauts from different countries.
+ *
+ * @param n Number of astronauts
+ * @param a_pairs Pairs of astronauts from the same country
+ */
+auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
+{
+  return pdhkr::algo::journey_to_moon(n, a_pairs.begin(), a_pairs.end());
+}
+#else
 // part of HackerRank template code
 ////////////////////////////////////////////////////////////////////////////////
 /*
@@ -154,6 +247,14 @@ using edge_vector = std::vector<std::pair<unsigned int, unsigned int>>;
 // compiling for x86, e.g. when building PE32 binaries on Windows
 auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
 {
+  PDHKR_PROFILE_PHASE(build);
+#if defined(USE_CSR_GRAPH)
+  // CSR graph of connections between astronauts
+  pdhkr::csr_graph<decltype(n)> edges{n, a_pairs.begin(), a_pairs.end()};
+  // visited astronauts and the BFS queue
+  PDHKR_PROFILE_PHASE(solve);
+  pdhkr::graph_search<decltype(n)> search{n};
+#else
   // adjacency list to hold connection graph between astronauts
   adjacency_list<decltype(n)> edges;
   // insert each astronaut pair (edge) as undirected edge
@@ -162,9 +263,33 @@ auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
     edges.insert(a_pair.second, a_pair.first);
   }
   // set of visited nodes (astronauts)
-  std::unordered_set<decltype(n)> visited;
+  PDHKR_PROFILE_PHASE(solve);
+  hash_set<decltype(n)> visited;
+#endif  // !defined(USE_CSR_GRAPH)
   // vector where index is country, value is astronauts from said country
+#if defined(USE_STATIC_CAPACITY)
+  // every astronaut may be their own country. both containers have static
+  // storage duration since they hold their elements inside themselves, so
+  // they are cleared in case of an earlier call
+  constexpr auto max_astronauts =
+    pdhkr::constraints::journey_to_moon::max_astronauts;
+  static pdhkr::static_vector<decltype(n), max_astronauts> countries;
+  countries.clear();
+#else
   std::vector<decltype(n)> countries;
+#endif  // !defined(USE_STATIC_CAPACITY)
+#if defined(USE_CSR_GRAPH)
+  // each connected component is a country, including isolated astronauts
+  for (decltype(n) node = 0; node < n; node++)
+    if (!search.visited(node))
+      countries.push_back(
+        static_cast<decltype(n)>(search.bfs(edges, node, [](auto) {}))
+      );
+#else
+#if defined(USE_STATIC_CAPACITY)
+  // BFS queue reused across components
+  static pdhkr::ring_buffer<decltype(n), max_astronauts> queue;
+#endif  // USE_STATIC_CAPACITY
   // perform BFS for each unvisited node to fill in countries
   for (const auto& [node, neighbors] : edges) {
     // skip if visited
@@ -173,7 +298,12 @@ auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
     // otherwise, allocate new country
     countries.push_back(0);
     // perform BFS
-    std::deque<decltype(n)> queue{node};
+#if defined(USE_STATIC_CAPACITY)
+    queue.clear();
+    queue.push_back(node);
+#else
+    pdhkr::arena_std::deque<decltype(n)> queue{node};
+#endif  // !defined(USE_STATIC_CAPACITY)
     while (queue.size()) {
       // get + pop current
       auto cur = queue.front();
@@ -196,6 +326,7 @@ auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
     for (auto i = n_countries; i < n; i++)
       countries.push_back(1);
   }
+#endif  // !defined(USE_CSR_GRAPH)
   // number of pairs we can select
   unsigned long long n_pairs = 0;
   // do double loop through countries to compute total number of pairs
@@ -247,7 +378,7 @@ auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
 #if defined(NDEBUG)
   for (decltype(countries.size()) i = 0; i < countries.size() - 1; i++)
     for (decltype(i) j = i + 1; j < countries.size(); j++)
-      n_pairs += countries[i] * countries[j];
+      n_pairs += static_cast<decltype(n_pairs)>(countries[i]) * countries[j];
 // unoptimized code uses mentioned optimizations to cut down runtime
 #else
   // key optimization 1: writing size() to a temporary
@@ -259,7 +390,8 @@ auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
   for (decltype(countries_size) i = 0; i < countries_size - 1; i++) {
     // key optimization 2: writing countries[i] to a temporary
     // note: since we already have c_data we also use to index in outer loop
-    auto c_i = c_data[i];
+    // note: widened so the product with *it_j cannot wrap in unsigned int
+    auto c_i = static_cast<decltype(n_pairs)>(c_data[i]);
     // key optimization 4: improve cache locality by using raw pointer iterator
     for (auto it_j = c_data + i + 1; it_j < c_data_end; it_j++)
       n_pairs += c_i * *it_j;
@@ -267,6 +399,7 @@ auto journey_to_moon(unsigned int n, const edge_vector& a_pairs)
 #endif  // !defined(NDEBUG)
   return n_pairs;
 }
+#endif  // !defined(USE_DSU) && !defined(USE_ALGO_LIBRARY)
 
 int main()
 {
@@ -274,9 +407,9 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #elif defined(PDHKR_LOCAL)
   // for local run, this is simply std::cout
   auto& fout = std::cout;
@@ -287,11 +420,30 @@ int main()
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
   // number of astronauts
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_astronauts;
   fin >> n_astronauts;
   // number of astronaut pairs (edges)
   unsigned int n_pairs;
   fin >> n_pairs;
+#if defined(USE_DSU)
+  // union each astronaut pair as it is read (indexed from 0)
+  pdhkr::disjoint_sets<unsigned int> edges{n_astronauts};
+#if defined(USE_ONLINE_EDGES)
+  // pair count with no astronaut pairs, then after each one
+  std::vector<decltype(journey_to_moon(0, {}))> n_pairs_totals;
+  n_pairs_totals.reserve(n_pairs + std::size_t{1});
+  n_pairs_totals.push_back(journey_to_moon(n_astronauts, edges));
+#endif  // USE_ONLINE_EDGES
+  for (decltype(n_pairs) i = 0; i < n_pairs; i++) {
+    unsigned int a, b;
+    fin >> a >> b;
+    edges.unite_ids(a, b);
+#if defined(USE_ONLINE_EDGES)
+    n_pairs_totals.push_back(journey_to_moon(n_astronauts, edges));
+#endif  // USE_ONLINE_EDGES
+  }
+#else
   // edge vector
   edge_vector edges;
   edges.reserve(n_pairs);
@@ -302,10 +454,22 @@ int main()
     fin >> edge.second;
     edges.push_back(std::move(edge));
   }
-  // write result to output stream
-  fout << journey_to_moon(n_astronauts, edges) << std::endl;
+#endif  // !defined(USE_DSU)
+  // compute + write result to output stream
+#if defined(USE_ONLINE_EDGES)
+  PDHKR_PROFILE_PHASE(output);
+  for (auto n_pairs_total : n_pairs_totals)
+    fout << n_pairs_total << "\n";
+  fout << std::flush;
+#else
+  PDHKR_PROFILE_PHASE(solve);
+  auto n_pairs_total = journey_to_moon(n_astronauts, edges);
+  PDHKR_PROFILE_PHASE(output);
+  fout << n_pairs_total << std::endl;
+#endif  // !defined(USE_ONLINE_EDGES)
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(compare);
   return pdhkr::exit_compare<decltype(journey_to_moon(0, {}))>(fans, fout);
 #else
   return EXIT_SUCCESS;
@@ -5,13 +5,17 @@
  * @copyright MIT License
  *
  * URL: https://www.hackerrank.com/challenges/maximum-element/problem
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::max_stack` from
+ * `pdhkr/algo/max_stack.hh`, which must be pasted in with the pdhkr headers it
+ * includes when submitting to HackerRank.
  */
 
-#include <algorithm>
 #include <cstdlib>
-#include <deque>
 #include <fstream>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 // only used when compiling as standalone test program
 #ifdef PDHKR_TEST
@@ -21,15 +25,65 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// parse queries, execute queries, and write results on separate threads
+#ifdef USE_QUERY_PIPELINE
+#include "pdhkr/pipeline.hh"
+#endif  // USE_QUERY_PIPELINE
+
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/max_stack.hh"
+
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
+
+namespace arena_std = std;
+
+}  // namespace pdhkr
+
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// preallocate the stack from the declared constraints
+#ifdef USE_STATIC_CAPACITY
+#include "pdhkr/constraints.hh"
+#include "pdhkr/static_vector.hh"
+#endif  // USE_STATIC_CAPACITY
+
+namespace {
+
+/**
+ * Parsed stack query.
+ *
+ * @param type Query type, 1 to push, 2 to pop, 3 to print the max value
+ * @param arg Value to push, only used if type is 1
+ */
+struct stack_query {
+  unsigned int type;
+  unsigned int arg;
+};
+
+}  // namespace
+
 int main()
 {
 // building as standalone test program
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #elif defined(PDHKR_LOCAL)
   // for local run, this is simply std::cout
   auto& fout = std::cout;
@@ -40,37 +94,83 @@ int main()
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
   // read number of queries
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_queries;
   fin >> n_queries;
-  // stack of values
-  std::deque<unsigned int> stack;
-  // read queries into stack
-  for (decltype(n_queries) i = 0; i < n_queries; i++) {
-    // query and possibly-used argument
-    unsigned int query;
-    decltype(stack)::value_type arg;
-    // read query and switch off value
-    fin >> query;
-    switch (query) {
+  // stack of values, each with the max of the values up to it
+  using value_type = unsigned int;
+  using entry_type = std::pair<value_type, value_type>;
+#if defined(USE_STATIC_CAPACITY)
+  // inline capacity for one push per query, with static storage duration
+  // since the container holds its elements inside itself
+  using stack_type = pdhkr::algo::max_stack<
+    value_type,
+    pdhkr::static_vector<
+      entry_type, pdhkr::constraints::max_stack_element::max_queries
+    >
+  >;
+  static stack_type stack_storage;
+  auto& stack = stack_storage;
+#else
+  using stack_type = pdhkr::algo::max_stack<
+    value_type, pdhkr::arena_std::vector<entry_type>
+  >;
+  stack_type stack;
+#endif  // !defined(USE_STATIC_CAPACITY)
+  // read a single query and its possibly-used argument
+  auto read_query = [&fin]
+  {
+    PDHKR_PROFILE_PHASE(parse);
+    stack_query query{};
+    fin >> query.type;
+    if (query.type == 1)
+      fin >> query.arg;
+    return query;
+  };
+  // execute a query, emitting the max value in the stack if requested
+  auto solve_query = [&stack](const stack_query& query, auto&& emit)
+  {
+    PDHKR_PROFILE_PHASE(solve);
+    switch (query.type) {
       // push value onto stack
       case 1:
-        fin >> arg;
-        stack.push_back(arg);
+        stack.push(query.arg);
         break;
       // pop value from stack
       case 2:
-        stack.pop_back();
+        stack.pop();
         break;
       // print max value in stack
       case 3:
-        fout << *std::max_element(stack.begin(), stack.end()) << "\n";
+        emit(stack.max());
     }
-  }
+  };
+  auto write_max = [&fout](auto value)
+  {
+    PDHKR_PROFILE_PHASE(output);
+    fout << value << "\n";
+  };
+  // handle queries
+#if defined(USE_QUERY_PIPELINE)
+  // reading std::cin must not flush std::cout from another thread
+  fin.tie(nullptr);
+  pdhkr::pipeline_queries<stack_type::value_type>(
+    n_queries,
+    read_query,
+    solve_query,
+    write_max
+  );
+#else
+  for (decltype(n_queries) i = 0; i < n_queries; i++)
+    solve_query(read_query(), write_max);
+#endif  // !defined(USE_QUERY_PIPELINE)
   // flush anything left in buffer
+  PDHKR_PROFILE_PHASE(output);
   fout << std::flush;
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
-  return pdhkr::exit_compare<decltype(stack)::value_type>(fans, fout);
+  PDHKR_PROFILE_PHASE(compare);
+  return pdhkr::exit_compare<stack_type::value_type>(fans, fout);
 #else
   return EXIT_SUCCESS;
 #endif  // !defined(PDHKR_TEST)
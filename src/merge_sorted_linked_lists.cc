@@ -6,15 +6,20 @@
  * @copyright MIT License
  *
  * URL: https://www.hackerrank.com/challenges/merge-two-sorted-linked-lists/problem
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::merge_lists` from
+ * `pdhkr/algo/merge_lists.hh`, which must be pasted in with the pdhkr headers
+ * it includes when submitting to HackerRank.
  */
 
 #include <cstdlib>
 #include <istream>
 #include <iostream>
+#include <iterator>
 #include <ostream>
 #include <memory>
-#include <type_traits>
 #include <utility>
+#include <vector>
 
 // only used when compiling as standalone test program
 #ifdef PDHKR_TEST
@@ -25,6 +30,35 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// solve test cases in parallel on worker threads
+#ifdef USE_PARALLEL_CASES
+#include "pdhkr/case_driver.hh"
+#endif  // USE_PARALLEL_CASES
+
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/merge_lists.hh"
+
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
+
+namespace arena_std = std;
+
+}  // namespace pdhkr
+
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
 namespace {
 
 /**
@@ -35,6 +69,8 @@ namespace {
 template <typename T>
 class list_node {
 public:
+  PDHKR_ARENA_OPERATORS
+
   using value_type = T;
 
   /**
@@ -118,6 +154,9 @@ auto& operator<<(
 /**
  * Merge two sorted linked lists into a new one.
  *
+ * The list values are merged as flat sequences and the merged values are then
+ * linked into a new list.
+ *
  * @param head_a First sorted linked list
  * @param head_b Second sorted linked list
  */
@@ -126,50 +165,29 @@ auto merge_lists(
   const std::unique_ptr<list_node<T>>& head_a,
   const std::unique_ptr<list_node<T>>& head_b)
 {
-  // new list
-  std::unique_ptr<list_node<T>> head;
-  // cursors
-  auto cur_a = head_a.get();
-  auto cur_b = head_b.get();
-  auto cur = head.get();
-  // lambda for inserting list a, list b values into new list
-  auto insert_new_node = [&cur, &head](auto new_value)
+  // copy list values into a vector
+  auto list_values = [](const std::unique_ptr<list_node<T>>& head)
   {
-    auto new_node = std::make_unique<list_node<T>>(new_value);
-    // head unset
-    if (!head) {
-      head = std::move(new_node);
-      cur = head.get();
-    }
-    // append to head
-    else {
-      cur->next() = std::move(new_node);
-      cur = cur->next().get();
-    }
+    std::vector<T> values;
+    for (auto cur = head.get(); cur; cur = cur->next().get())
+      values.push_back(cur->value());
+    return values;
   };
-  // while we aren't done with both lists
-  while (cur_a && cur_b) {
-    // insert cur_a before cur_b while possible
-    while (cur_a && cur_b && cur_a->value() <= cur_b->value()) {
-      insert_new_node(cur_a->value());
-      cur_a = cur_a->next().get();
-    }
-    // insert cur_b before cur_a while possible
-    while (cur_a && cur_b && cur_b->value() <= cur_a->value()) {
-      insert_new_node(cur_b->value());
-      cur_b = cur_b->next().get();
-    }
-  }
-  // finish list a. head may still be empty
-  while (cur_a) {
-    insert_new_node(cur_a->value());
-    cur_a = cur_a->next().get();
-  }
-  // finish list b. head may still be empty
-  while (cur_b) {
-    insert_new_node(cur_b->value());
-    cur_b = cur_b->next().get();
-  }
+  auto values_a = list_values(head_a);
+  auto values_b = list_values(head_b);
+  std::vector<T> merged;
+  merged.reserve(values_a.size() + values_b.size());
+  pdhkr::algo::merge_lists(
+    values_a.begin(),
+    values_a.end(),
+    values_b.begin(),
+    values_b.end(),
+    std::back_inserter(merged)
+  );
+  // link merged values back to front
+  std::unique_ptr<list_node<T>> head;
+  for (auto it = merged.rbegin(); it != merged.rend(); it++)
+    head = std::make_unique<list_node<T>>(*it, std::move(head));
   return head;
 }
 
@@ -216,28 +234,48 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #else
   // for local run, this is simply std::cout
   auto& fout = std::cout;
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST)
   // number of test cases
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_cases;
   fin >> n_cases;
-  // handle test cases
-  for (decltype(n_cases) i = 0; i < n_cases; i++) {
-    // create linked lists
-    auto head_a = create_list(fin);
-    auto head_b = create_list(fin);
-    // create merged list + print
-    auto head = merge_lists(head_a, head_b);
+  // read a single test case's linked lists
+  auto read_case = [&fin]
+  {
+    // lists are built while parsing, which is timed as parsing
+    PDHKR_PROFILE_PHASE(parse);
+    // note: braced init guarantees left-to-right evaluation order
+    return std::pair{create_list(fin), create_list(fin)};
+  };
+  // create merged list
+  auto solve_case = [](const auto& heads)
+  {
+    PDHKR_PROFILE_SCOPE(solve);
+    return merge_lists(heads.first, heads.second);
+  };
+  // print a merged list
+  auto write_list = [&fout](const auto& head)
+  {
+    PDHKR_PROFILE_PHASE(output);
     fout << head << std::endl;
-  }
+  };
+  // handle test cases, printing each merged list
+#if defined(USE_PARALLEL_CASES)
+  pdhkr::solve_cases(n_cases, read_case, solve_case, write_list);
+#else
+  for (decltype(n_cases) i = 0; i < n_cases; i++)
+    write_list(solve_case(read_case()));
+#endif  // !defined(USE_PARALLEL_CASES)
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(compare);
   // value_type type member from the list_node template
   using value_type = decltype(create_list(fin))::element_type::value_type;
   // using std::vector<value_type> triggers the vector compare routine
@@ -8,14 +8,18 @@
  *  specific-position-from-the-tail/problem
  *
  * @note The URL of the problem is more descriptive than the title.
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::position_from_tail` from
+ * `pdhkr/algo/node_from_tail.hh`, which must be pasted in with the pdhkr
+ * headers it includes when submitting to HackerRank.
  */
 
 #include <cstdlib>
 #include <istream>
 #include <iostream>
 #include <memory>
-#include <stdexcept>
 #include <utility>
+#include <vector>
 
 // only used when compiling as standalone test program
 #ifdef PDHKR_TEST
@@ -26,6 +30,35 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// solve test cases in parallel on worker threads
+#ifdef USE_PARALLEL_CASES
+#include "pdhkr/case_driver.hh"
+#endif  // USE_PARALLEL_CASES
+
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/node_from_tail.hh"
+
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
+
+namespace arena_std = std;
+
+}  // namespace pdhkr
+
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
 namespace {
 
 /**
@@ -38,6 +71,8 @@ namespace {
 template <typename T>
 class list_node {
 public:
+  PDHKR_ARENA_OPERATORS
+
   using value_type = T;
 
   /**
@@ -132,33 +167,24 @@ auto create_list(std::istream& in)
 }
 
 /**
- * Return value that if `tail_pos` from the tail of the linked list.
+ * Return value that is `tail_pos` from the tail of the linked list.
+ *
+ * The list values are copied into a flat sequence that is then searched.
  *
  * @tparam T Node value type
  *
+ * @param head Linked list head
  * @param tail_pos Offset from the linked list tail
  */
 template <typename T>
 auto position_from_tail(const list_node<T>& head, unsigned int tail_pos)
 {
-  // cursor to current node address
-  auto cur = &head;
-  // compute list length
-  unsigned int list_len = 0;
-  while (cur) {
-    list_len++;
-    cur = cur->next().get();
-  }
-  // although guaranteed in the problem this could happen in reality
-  if (tail_pos >= list_len)
-    throw std::runtime_error{"tail_pos indexes past linked list head"};
-  // compute position from head. if tail_pos is 0, the pos is list_len - 1
-  auto pos = list_len - tail_pos - 1;
-  // find pos element and return value
-  cur = &head;
-  for (decltype(pos) i = 0; i < pos; i++)
-    cur = cur->next().get();
-  return cur->value();
+  std::vector<T> values;
+  for (auto cur = &head; cur; cur = cur->next().get())
+    values.push_back(cur->value());
+  return pdhkr::algo::position_from_tail(
+    values.begin(), values.end(), tail_pos
+  );
 }
 
 }  // namespace
@@ -169,31 +195,55 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #else
   // for local run, this is simply std::cout
   auto& fout = std::cout;
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST)
   // number of test cases
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_cases;
   fin >> n_cases;
-  // handle test cases
-  for (decltype(n_cases) i = 0; i < n_cases; i++) {
+  // read a single test case's linked list + position from tail
+  auto read_case = [&fin]
+  {
+    // list is built while parsing, which is timed as parsing
+    PDHKR_PROFILE_PHASE(parse);
     // create linked list
     auto head = create_list(fin);
     // read position from tail
     unsigned int tail_pos;
     fin >> tail_pos;
-    // write target value
-    fout << position_from_tail(*head, tail_pos) << "\n";
-  }
+    return std::pair{std::move(head), tail_pos};
+  };
+  // find target value
+  auto solve_case = [](const auto& input)
+  {
+    PDHKR_PROFILE_SCOPE(solve);
+    return position_from_tail(*input.first, input.second);
+  };
+  // write a target value
+  auto write_value = [&fout](auto value)
+  {
+    PDHKR_PROFILE_PHASE(output);
+    fout << value << "\n";
+  };
+  // handle test cases, writing each target value
+#if defined(USE_PARALLEL_CASES)
+  pdhkr::solve_cases(n_cases, read_case, solve_case, write_value);
+#else
+  for (decltype(n_cases) i = 0; i < n_cases; i++)
+    write_value(solve_case(read_case()));
+#endif  // !defined(USE_PARALLEL_CASES)
   // flush fout when done
+  PDHKR_PROFILE_PHASE(output);
   fout << std::flush;
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(compare);
   // value_type type member from the list_node template
   using value_type = decltype(create_list(fin))::element_type::value_type;
   // using std::vector<value_type> triggers the vector compare routine
@@ -0,0 +1,106 @@
+/**
+ * @file rectangle_manipulation.cc
+ * @author Derek Huang
+ * @brief C++ program for a 2D extension of HackerRank "Array Manipulation"
+ * @copyright MIT License
+ *
+ * Each of m operations adds k to every cell of the rectangle [r1, r2] x
+ * [c1, c2] of a zeroed grid and the max grid value is then reported. The input
+ * mirrors array_manipulation's, starting with the number of rows, columns, and
+ * operations, followed by one `r1 r2 c1 c2 k` operation per line with 1-based
+ * inclusive limits.
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::rectangle_manipulation`,
+ * which checks the limits. Dense grids use a 2D difference array whose 2D
+ * prefix sums, taken in tiles of columns, are the grid values. If the grid is
+ * much larger than the number of operations, a line is instead swept down the
+ * rows, keeping the column values in a `pdhkr::algo::range_add_max_tree` over
+ * the column segments between rectangle edges.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+// only used when compiling as standalone test program
+#ifdef PDHKR_TEST
+#include <sstream>
+
+#include "pdhkr/compare.hh"
+#include "pdhkr/testing.hh"
+#endif  // PDHKR_TEST
+
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/rectangle_manipulation.hh"
+
+namespace {
+
+/**
+ * Addition of a value to a rectangle as `(r1, r2, c1, c2, k)`.
+ *
+ * The row limits `[r1, r2]` and column limits `[c1, c2]` are 1-based.
+ */
+using rectangle = std::tuple<
+  unsigned int, unsigned int, unsigned int, unsigned int, unsigned long long
+>;
+
+/**
+ * Return the max grid value after the additions.
+ *
+ * @param rows Number of grid rows
+ * @param cols Number of grid columns
+ * @param rects Rectangle additions
+ */
+auto max_value(
+  unsigned int rows, unsigned int cols, const std::vector<rectangle>& rects)
+{
+  return pdhkr::algo::rectangle_manipulation(
+    rows, cols, rects.begin(), rects.end()
+  );
+}
+
+}  // namespace
+
+int main()
+{
+// building as standalone test program
+#if defined(PDHKR_TEST)
+  // write to stringstream, read from PDHKR_TEST_INPUT
+  std::stringstream fout;
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
+  // fans provides the expected output
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
+#else
+  auto& fout = std::cout;
+  auto& fin = std::cin;
+#endif  // !defined(PDHKR_TEST)
+  // grid size and number of operations
+  PDHKR_PROFILE_PHASE(parse);
+  unsigned int rows, cols, n_ops;
+  fin >> rows >> cols >> n_ops;
+  // row limits, column limits, value
+  std::vector<rectangle> rects(n_ops);
+  for (auto& [r1, r2, c1, c2, k] : rects)
+    fin >> r1 >> r2 >> c1 >> c2 >> k;
+  // compute + write max grid value
+  PDHKR_PROFILE_PHASE(solve);
+  auto max_grid_value = max_value(rows, cols, rects);
+  PDHKR_PROFILE_PHASE(output);
+  fout << max_grid_value << std::endl;
+// if testing, do comparison in the program itself
+#if defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(compare);
+  return pdhkr::exit_compare<decltype(max_grid_value)>(fans, fout);
+#else
+  return EXIT_SUCCESS;
+#endif  // !defined(PDHKR_TEST)
+}
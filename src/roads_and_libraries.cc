@@ -15,6 +15,7 @@
 #include <deque>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -29,6 +30,97 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// report invalid input with pdhkr::throw_error, defined here for HackerRank
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/error.hh"
+#else
+namespace pdhkr {
+
+template <typename E>
+[[noreturn]] void throw_error(const std::string& message)
+{
+  throw E{message};
+}
+
+}  // namespace pdhkr
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// solve queries in parallel on worker threads
+#ifdef USE_PARALLEL_CASES
+#include "pdhkr/case_driver.hh"
+#endif  // USE_PARALLEL_CASES
+
+// parse the entire input up front with multiple threads
+#ifdef USE_PARALLEL_PARSE
+#include "pdhkr/mapped_input.hh"
+#include "pdhkr/parallel_parse.hh"
+#endif  // USE_PARALLEL_PARSE
+
+// use the embeddable pdhkr::algo implementation of the solver core
+#ifdef USE_ALGO_LIBRARY
+#include "pdhkr/algo/roads_and_libraries.hh"
+#endif  // USE_ALGO_LIBRARY
+
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
+
+namespace arena_std = std;
+
+}  // namespace pdhkr
+
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// use flat open-addressing hash containers instead of node-based ones
+#ifdef USE_FLAT_HASH
+#include "pdhkr/flat_hash.hh"
+#endif  // USE_FLAT_HASH
+
+// use a compressed sparse row graph with flat BFS arrays
+#ifdef USE_CSR_GRAPH
+#include "pdhkr/graph.hh"
+#endif  // USE_CSR_GRAPH
+
+// union roads as they are parsed instead of storing and searching them
+#ifdef USE_DSU
+#include "pdhkr/dsu.hh"
+#endif  // USE_DSU
+
+// print the cost after each road is united instead of once per query
+#if defined(USE_ONLINE_EDGES) && !defined(USE_DSU)
+#error "USE_ONLINE_EDGES needs the union-find of USE_DSU"
+#endif  // defined(USE_ONLINE_EDGES) && !defined(USE_DSU)
+
+// find connected components on all cores with the Afforest algorithm
+#ifdef USE_PARALLEL_COMPONENTS
+#include "pdhkr/graph.hh"
+#include "pdhkr/parallel_components.hh"
+#endif  // USE_PARALLEL_COMPONENTS
+
+// hash containers for the graph and visited tracking
+#if defined(USE_FLAT_HASH)
+template <typename T>
+using hash_set = pdhkr::flat_hash_set<T>;
+template <typename K, typename V>
+using hash_map = pdhkr::flat_hash_map<K, V>;
+#else
+template <typename T>
+using hash_set = pdhkr::arena_std::unordered_set<T>;
+template <typename K, typename V>
+using hash_map = pdhkr::arena_std::unordered_map<K, V>;
+#endif  // !defined(USE_FLAT_HASH)
+
 /**
  * Adjacency list class.
  *
@@ -92,7 +184,7 @@ public:
   }
 
 private:
-  std::unordered_map<unsigned int, std::unordered_set<unsigned int>> edges_;
+  hash_map<unsigned int, hash_set<unsigned int>> edges_;
 };
 
 /**
@@ -100,6 +192,111 @@ private:
  */
 using edge_vector = std::vector<std::pair<unsigned int, unsigned int>>;
 
+/**
+ * A single query, i.e. the cities, library and road costs, and roads.
+ */
+struct city_query {
+  unsigned int n_cities;
+  unsigned int lib_cost;
+  unsigned int road_cost;
+#if defined(USE_DSU)
+  pdhkr::disjoint_sets<unsigned int> cities;
+#if defined(USE_ONLINE_EDGES)
+  // cost with no roads, then after each road
+  std::vector<unsigned long long> costs;
+#endif  // USE_ONLINE_EDGES
+#else
+  edge_vector edges;
+#endif  // !defined(USE_DSU)
+};
+
+#if defined(USE_DSU)
+/**
+ * Return the minimum cost of giving every city access to a library.
+ *
+ * Each connected component gets one library and one road less than it has
+ * cities, unless libraries everywhere are cheaper. Since only the component
+ * count is needed, this is O(1) and can be called after any road is united.
+ *
+ * @param n Number of cities
+ * @param c_lib Library cost
+ * @param c_road Road cost
+ * @param cities Components of the cities connected by the roads so far
+ */
+auto roads_and_libraries(
+  unsigned int n,
+  unsigned int c_lib,
+  unsigned int c_road,
+  const pdhkr::disjoint_sets<unsigned int>& cities)
+{
+  unsigned long long n_libs = cities.n_components();
+  unsigned long long n_roads = cities.n_forest_edges();
+  return std::min(
+    static_cast<unsigned long long>(c_lib) * n,
+    c_lib * n_libs + c_road * n_roads
+  );
+}
+#elif defined(USE_ALGO_LIBRARY)
+/**
+ * Return the minimum cost of giving every city access to a library.
+ *
+ * @param n Number of cities
+ * @param c_lib Library cost
+ * @param c_road Road cost
+ * @param cities Pairs of cities connected by a road, with IDs from 1
+ */
+auto roads_and_libraries(
+  unsigned int n,
+  unsigned int c_lib,
+  unsigned int c_road,
+  const edge_vector& cities)
+{
+  return pdhkr::algo::roads_and_libraries(
+    n, c_lib, c_road, cities.begin(), cities.end()
+  );
+}
+#elif defined(USE_CSR_GRAPH) || defined(USE_PARALLEL_COMPONENTS)
+/**
+ * Return the minimum cost of giving every city access to a library.
+ *
+ * Each connected component of cities gets one library and one road less than
+ * it has cities, unless libraries everywhere are cheaper. The components are
+ * found by BFS or, if `USE_PARALLEL_COMPONENTS` is defined, by linking the
+ * roads in parallel on the default thread pool.
+ *
+ * @param n Number of cities
+ * @param c_lib Library cost
+ * @param c_road Road cost
+ * @param cities Pairs of cities connected by a road, with IDs from 1
+ */
+auto roads_and_libraries(
+  unsigned int n,
+  unsigned int c_lib,
+  unsigned int c_road,
+  const edge_vector& cities)
+{
+  PDHKR_PROFILE_PHASE(build);
+  pdhkr::csr_graph<decltype(n)> edges{
+    n, cities.begin(), cities.end(), pdhkr::edge_direction::undirected, 1U
+  };
+  PDHKR_PROFILE_PHASE(solve);
+  unsigned long long total = 0;
+#if defined(USE_PARALLEL_COMPONENTS)
+  for (auto size : pdhkr::parallel_component_sizes(edges))
+    total += c_lib + static_cast<decltype(total)>(c_road) * (size - 1);
+#else
+  pdhkr::graph_search<decltype(n)> search{n};
+  // BFS from the next unvisited city covers its whole component
+  for (auto i = search.visited().next_unset(0); i < n;) {
+    auto root = static_cast<decltype(n)>(i);
+    auto size = search.bfs(edges, root, [](auto) {});
+    total += c_lib + static_cast<decltype(total)>(c_road) * (size - 1);
+    i = search.visited().next_unset(i + 1);
+  }
+#endif  // !defined(USE_PARALLEL_COMPONENTS)
+  return std::min(static_cast<decltype(total)>(c_lib) * n, total);
+}
+#else
 // part of HackerRank template code
 ////////////////////////////////////////////////////////////////////////////////
 /*
@@ -123,7 +320,8 @@ auto roads_and_libraries(
   const edge_vector& cities)
 {
   // set for unvisited nodes
-  std::unordered_set<decltype(n)> unvisited;
+  PDHKR_PROFILE_PHASE(build);
+  hash_set<decltype(n)> unvisited;
   for (decltype(n) i = 0; i < n; i++)
     unvisited.insert(i);
   // adjacency list of edges (indexed from 0). fill cities as undirected edges
@@ -133,12 +331,13 @@ auto roads_and_libraries(
     edges.insert(edge.second - 1, edge.first - 1);
   }
   // total cost
+  PDHKR_PROFILE_PHASE(solve);
   unsigned long long total = 0;
   // current set of connected nodes. this is used to detect whether or not a
   // new node we are searching from is disconnected from the others
-  std::unordered_set<decltype(n)> connected;
+  hash_set<decltype(n)> connected;
   // deque of nodes to search through (start from 0)
-  std::deque<decltype(n)> queue{0};
+  pdhkr::arena_std::deque<decltype(n)> queue{0};
   // until every city has been connected
   while (queue.size() || unvisited.size()) {
     // starting node for BFS. since road costs are the same (c_road), it
@@ -186,6 +385,7 @@ auto roads_and_libraries(
   // before multiplying by n to ensure correct widening
   return std::min(static_cast<decltype(total)>(c_lib) * n, total);
 }
+#endif  // !defined(USE_DSU) && !defined(USE_ALGO_LIBRARY) && ...
 
 int main()
 {
@@ -193,9 +393,9 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 // local run
 #elif defined(PDHKR_LOCAL)
   // for local run, this is simply std::cout
@@ -206,43 +406,128 @@ int main()
   std::ofstream fout(getenv("OUTPUT_PATH"));
   auto &fin = std::cin;
 #endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+  PDHKR_PROFILE_PHASE(parse);
+// read next value from flat array of all the input values
+#if defined(USE_PARALLEL_PARSE)
+#if defined(PDHKR_TEST) && defined(PDHKR_TEST_EMBED)
+  const auto& input = PDHKR_TEST_INPUT;
+#elif defined(PDHKR_TEST)
+  pdhkr::mapped_input input{PDHKR_TEST_INPUT};
+#else
+  pdhkr::mapped_input input;
+#endif  // !defined(PDHKR_TEST)
+  auto values = pdhkr::parse_integers<unsigned int>(input.view());
+  auto read_value = [it = values.cbegin(), end = values.cend()]() mutable
+  {
+    if (it == end)
+      pdhkr::throw_error<std::runtime_error>("Input ended before all values");
+    return *it++;
+  };
+// read next value from the input stream
+#else
+  auto read_value = [&fin]
+  {
+    unsigned int value = 0;
+    if (!(fin >> value))
+      pdhkr::throw_error<std::runtime_error>("Failed to read input value");
+    return value;
+  };
+#endif  // !defined(USE_PARALLEL_PARSE)
   // number of queries
-  unsigned int n_queries;
-  fin >> n_queries;
-  // handle queries
-  for (decltype(n_queries) i = 0; i < n_queries; i++) {
+  auto n_queries = read_value();
+  // read a single query
+  auto read_query = [&read_value]
+  {
+    PDHKR_PROFILE_PHASE(parse);
+    city_query query;
     // number of cities
-    unsigned int n_cities;
-    fin >> n_cities;
+    query.n_cities = read_value();
     // number of edges connecting cities
-    unsigned int n_edges;
-    fin >> n_edges;
+    auto n_edges = read_value();
     // library cost
-    unsigned int lib_cost;
-    fin >> lib_cost;
+    query.lib_cost = read_value();
     // road cost
-    unsigned int road_cost;
-    fin >> road_cost;
+    query.road_cost = read_value();
+#if defined(USE_DSU)
+    // union the cities of each road as it is read (indexed from 1)
+    query.cities = pdhkr::disjoint_sets<unsigned int>{query.n_cities};
+#if defined(USE_ONLINE_EDGES)
+    // the cost only depends on the component count, so it is O(1) per road
+    auto record_cost = [&query]
+    {
+      query.costs.push_back(
+        roads_and_libraries(
+          query.n_cities, query.lib_cost, query.road_cost, query.cities
+        )
+      );
+    };
+    query.costs.reserve(n_edges + std::size_t{1});
+    record_cost();
+#endif  // USE_ONLINE_EDGES
+    for (decltype(n_edges) j = 0; j < n_edges; j++) {
+      auto start = read_value();
+      query.cities.unite_ids(start, read_value(), 1U);
+#if defined(USE_ONLINE_EDGES)
+      record_cost();
+#endif  // USE_ONLINE_EDGES
+    }
+#else
     // edge vector for this query
-    edge_vector edges;
-    edges.reserve(n_edges);
+    query.edges.reserve(n_edges);
     // read edge and insert
     for (decltype(n_edges) j = 0; j < n_edges; j++) {
-      decltype(edges)::value_type edge;
-      fin >> edge.first;
-      fin >> edge.second;
-      // actually, moving is just a copy since pair has fundamental types
-      edges.push_back(std::move(edge));
+      auto start = read_value();
+      query.edges.emplace_back(start, read_value());
     }
-    // write result to output stream with newline (no flush)
-    fout << roads_and_libraries(n_cities, lib_cost, road_cost, edges) << "\n";
-  }
+#endif  // !defined(USE_DSU)
+    return query;
+  };
+  // solve a single query
+  auto solve_query = [](const city_query& query)
+  {
+    PDHKR_PROFILE_SCOPE(solve);
+#if defined(USE_ONLINE_EDGES)
+    return query.costs;
+#elif defined(USE_DSU)
+    return roads_and_libraries(
+      query.n_cities, query.lib_cost, query.road_cost, query.cities
+    );
+#else
+    return roads_and_libraries(
+      query.n_cities, query.lib_cost, query.road_cost, query.edges
+    );
+#endif  // !defined(USE_ONLINE_EDGES) && !defined(USE_DSU)
+  };
+  // write result to output stream with newline (no flush)
+#if defined(USE_ONLINE_EDGES)
+  auto write_cost = [&fout](const auto& costs)
+  {
+    PDHKR_PROFILE_PHASE(output);
+    for (auto cost : costs)
+      fout << cost << "\n";
+  };
+#else
+  auto write_cost = [&fout](auto cost)
+  {
+    PDHKR_PROFILE_PHASE(output);
+    fout << cost << "\n";
+  };
+#endif  // !defined(USE_ONLINE_EDGES)
+  // handle queries
+#if defined(USE_PARALLEL_CASES)
+  pdhkr::solve_cases(n_queries, read_query, solve_query, write_cost);
+#else
+  for (decltype(n_queries) i = 0; i < n_queries; i++)
+    write_cost(solve_query(read_query()));
+#endif  // !defined(USE_PARALLEL_CASES)
 // flush if running locally. std::ofstream closed in its dtor
 #if defined(PDHKR_LOCAL) || defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(output);
   fout << std::flush;
 #endif  // !defined(PDHKR_LOCAL) && !defined(PDHKR_TEST)
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(compare);
   using value_type = decltype(roads_and_libraries(0, 0, 0, {}));
   return pdhkr::exit_compare<value_type>(fans, fout);
 #else
@@ -5,16 +5,17 @@
  * @copyright MIT License
  *
  * URL: https://www.hackerrank.com/challenges/find-the-running-median/problem
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::running_median` from
+ * `pdhkr/algo/running_median.hh`, which must be pasted in with the pdhkr
+ * headers it includes when submitting to HackerRank.
  */
 
-#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <ios>
 #include <iostream>
-#include <type_traits>
-#include <vector>
 
 // only used when compiling as standalone test program
 #ifdef PDHKR_TEST
@@ -24,41 +25,31 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// parse values, compute medians, and write medians on separate threads
+#ifdef USE_QUERY_PIPELINE
+#include "pdhkr/pipeline.hh"
+#endif  // USE_QUERY_PIPELINE
+
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/running_median.hh"
+
 namespace {
 
 /**
- * Return vector of running medians given an input vector of values.
+ * Running median of a stream of values.
  *
  * @tparam T Arithmetic type
- *
- * @param values Values to compute running medians for
  */
-template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
-auto running_medians(const std::vector<T>& values)
-{
-  // vector of running medians
-  std::vector<double> medians;
-  // sorted vector of the values
-  std::vector<T> sorted_values;
-  // for each value in values
-  for (const auto& value : values) {
-    // find place to insert value. since it is sorted, we can use upper_bound
-    // for logarithmic instead of linear complexity as with find_if
-    sorted_values.insert(
-      std::upper_bound(sorted_values.begin(), sorted_values.end(), value),
-      value
-    );
-    // add median to medians (even number of values)
-    if (sorted_values.size() % 2 == 0) {
-      auto mid = sorted_values.size() / 2;
-      medians.push_back(0.5 * (sorted_values[mid - 1] + sorted_values[mid]));
-    }
-    // add median to medians (odd number of values)
-    else
-      medians.push_back(sorted_values[sorted_values.size() / 2]);
-  }
-  return medians;
-}
+template <typename T>
+using running_median = pdhkr::algo::running_median<T>;
 
 }  // namespace
 
@@ -68,9 +59,9 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #elif defined(PDHKR_LOCAL)
   // for local run, this is simply std::cout
   auto& fout = std::cout;
@@ -81,20 +72,50 @@ int main()
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
   // number of inputs
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_values;
   fin >> n_values;
-  // read values
-  std::vector<int> values(n_values);
-  for (decltype(n_values) i = 0; i < n_values; i++)
-    fin >> values[i];
+  // running median of the values read so far
+  running_median<int> median;
+  // read a single value
+  auto read_value = [&fin]
+  {
+    PDHKR_PROFILE_PHASE(parse);
+    int value;
+    fin >> value;
+    return value;
+  };
+  // add value and emit the new median
+  auto solve_value = [&median](int value, auto&& emit)
+  {
+    PDHKR_PROFILE_PHASE(solve);
+    emit(median(value));
+  };
+  auto write_median = [&fout](double value)
+  {
+    PDHKR_PROFILE_PHASE(output);
+    fout << std::fixed << std::setprecision(1) << value << "\n";
+  };
   // compute running medians + print
-  auto medians = running_medians(values);
-  for (auto median : medians)
-    fout << std::fixed << std::setprecision(1) << median << "\n";
+#if defined(USE_QUERY_PIPELINE)
+  // reading std::cin must not flush std::cout from another thread
+  fin.tie(nullptr);
+  pdhkr::pipeline_queries<double>(
+    n_values,
+    read_value,
+    solve_value,
+    write_median
+  );
+#else
+  for (decltype(n_values) i = 0; i < n_values; i++)
+    solve_value(read_value(), write_median);
+#endif  // !defined(USE_QUERY_PIPELINE)
+  PDHKR_PROFILE_PHASE(output);
   fout << std::flush;
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
-  return pdhkr::exit_compare<decltype(values)::value_type>(fans, fout);
+  PDHKR_PROFILE_PHASE(compare);
+  return pdhkr::exit_compare<int>(fans, fout);
 #else
   return EXIT_SUCCESS;
 #endif  // !defined(PDHKR_TEST)
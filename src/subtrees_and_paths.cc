@@ -35,8 +35,79 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// parse queries, execute queries, and write results on separate threads
+#ifdef USE_QUERY_PIPELINE
+#include "pdhkr/pipeline.hh"
+#endif  // USE_QUERY_PIPELINE
+
+// use the embeddable pdhkr::algo implementation of the solver core
+#ifdef USE_ALGO_LIBRARY
+#include "pdhkr/algo/subtrees_and_paths.hh"
+#endif  // USE_ALGO_LIBRARY
+
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
+
+namespace arena_std = std;
+
+}  // namespace pdhkr
+
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
+
+// use flat open-addressing hash containers instead of node-based ones
+#ifdef USE_FLAT_HASH
+#include "pdhkr/flat_hash.hh"
+#endif  // USE_FLAT_HASH
+
+// use a compressed sparse row graph with flat BFS and DFS arrays
+#ifdef USE_CSR_GRAPH
+#include "pdhkr/graph.hh"
+#endif  // USE_CSR_GRAPH
+
+// hash containers for the graph and visited tracking
+#if defined(USE_FLAT_HASH)
+template <typename T>
+using hash_set = pdhkr::flat_hash_set<T>;
+template <typename K, typename V>
+using hash_map = pdhkr::flat_hash_map<K, V>;
+#else
+template <typename T>
+using hash_set = pdhkr::arena_std::unordered_set<T>;
+template <typename K, typename V>
+using hash_map = pdhkr::arena_std::unordered_map<K, V>;
+#endif  // !defined(USE_FLAT_HASH)
+
 namespace {
 
+/**
+ * Parsed tree query.
+ *
+ * Parsing the query type into an enum keeps the record fixed-size so it can
+ * be cheaply handed from a parser thread to the thread executing queries.
+ */
+struct tree_query {
+  // query type, with unknown used for unrecognized query strings
+  enum class op_type : unsigned char { add, max, unknown } op;
+  // node ID to add to or path start node ID
+  std::uint32_t id_a;
+  // path end node ID, only used by max
+  std::uint32_t id_b;
+  // value to add, only used by add
+  int value;
+};
+
 // see note. define this to use the original tree_node implementation and
 // related methods that work only if input results in an actual tree
 #if defined(USE_TREE_NODE)
@@ -45,6 +116,8 @@ namespace {
  */
 class tree_node {
 public:
+  PDHKR_ARENA_OPERATORS
+
   /**
    * Ctor.
    *
@@ -149,7 +222,7 @@ auto& get_node(std::unique_ptr<tree_node>& root, unsigned int id)
  */
 auto& get_node(
   std::unique_ptr<tree_node>& root,
-  std::deque<std::pair<unsigned int, int>>& path,
+  pdhkr::arena_std::deque<std::pair<unsigned int, int>>& path,
   unsigned int id)
 {
   // empty root
@@ -206,7 +279,7 @@ auto max_value(
   if (!root)
     return min_val;
   // find path to id_a
-  std::deque<std::pair<unsigned int, int>> path_a;
+  pdhkr::arena_std::deque<std::pair<unsigned int, int>> path_a;
   auto& node_a = get_node(root, path_a, id_a);
   if (!node_a)
     return min_val;
@@ -249,6 +322,124 @@ auto max_value(
   }
   return res;
 }
+// heavy-light decomposed tree rooted at node 1 from the pdhkr::algo library
+#elif defined(USE_ALGO_LIBRARY)
+/**
+ * Convenience type alias for the vector of pairs representing edges.
+ */
+using edge_vector = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+/**
+ * Tree answering subtree additions and path max queries in logarithmic time.
+ */
+using path_tree = pdhkr::algo::subtree_path_tree<long long, std::uint32_t>;
+
+/**
+ * Increment the value of all nodes in the subtree rooted at a node.
+ */
+void blanket_add(path_tree& tree, std::uint32_t root, int value)
+{
+  tree.add(root, value);
+}
+
+/**
+ * Return the max value of the nodes on the path between two nodes.
+ */
+auto max_value(const path_tree& tree, std::uint32_t id_a, std::uint32_t id_b)
+{
+  return tree.max(id_a, id_b);
+}
+// use a CSR graph rooted at node 1, with flat arrays for values and parents
+#elif defined(USE_CSR_GRAPH)
+/**
+ * Convenience type alias for the vector of pairs representing edges.
+ */
+using edge_vector = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+/**
+ * Tree in CSR form with a value per node.
+ *
+ * Unlike `simple_graph`, which directs edges from the lower to the higher
+ * node ID, the parent of each node is found by a BFS from node 1, so subtrees
+ * are those of the tree actually rooted at node 1. Nodes are indexed from 0.
+ */
+struct csr_tree {
+  /**
+   * Ctor.
+   *
+   * @param n_nodes Number of nodes, with IDs from 1
+   * @param edges Undirected edges
+   */
+  csr_tree(std::uint32_t n_nodes, const edge_vector& edges)
+    : graph{
+        n_nodes,
+        edges.begin(),
+        edges.end(),
+        pdhkr::edge_direction::undirected,
+        1U
+      },
+      values(n_nodes),
+      parents(n_nodes),
+      search{n_nodes}
+  {
+    // nodes unreachable from the root are their own parents
+    for (std::uint32_t i = 0; i < n_nodes; i++)
+      parents[i] = i;
+    if (n_nodes)
+      search.bfs(
+        graph,
+        0U,
+        [](auto) {},
+        [this](auto node, auto next)
+        {
+          parents[next] = node;
+          return true;
+        }
+      );
+    search.clear();
+  }
+
+  pdhkr::csr_graph<std::uint32_t> graph;
+  std::vector<int> values;
+  std::vector<std::uint32_t> parents;
+  pdhkr::graph_search<std::uint32_t> search;
+};
+
+/**
+ * Increment the value of all nodes in the subtree rooted at a node.
+ */
+void blanket_add(csr_tree& tree, std::uint32_t root, int value)
+{
+  // do nothing if root doesn't exist in the tree
+  if (!root || root > tree.values.size())
+    return;
+  // BFS following only the arcs from parents to children
+  tree.search.bfs(
+    tree.graph,
+    root - 1,
+    [&tree, value](auto node) { tree.values[node] += value; },
+    [&tree](auto node, auto next) { return tree.parents[next] == node; }
+  );
+  tree.search.clear();
+}
+
+/**
+ * Return the max value of the nodes on the path between two nodes.
+ */
+auto max_value(csr_tree& tree, std::uint32_t id_a, std::uint32_t id_b)
+{
+  constexpr auto min_value = std::numeric_limits<int>::min();
+  auto n_nodes = tree.values.size();
+  if (!id_a || id_a > n_nodes || !id_b || id_b > n_nodes)
+    return min_value;
+  // unique path in the tree, found by DFS
+  auto path = tree.search.path(tree.graph, id_a - 1, id_b - 1);
+  auto res = min_value;
+  for (auto node : path)
+    res = std::max(res, tree.values[node]);
+  tree.search.clear();
+  return res;
+}
 // use more general implementation that treats problem as a graph problem.
 // TODO: this is slower than tree when run on 13.in but doesn't fail on 2.in
 #else
@@ -258,16 +449,14 @@ auto max_value(
  * This allows constant time lookup for a particular edge while also allowing
  * easy iteration through the neighbors of any particular node.
  */
-using edge_map_type = std::unordered_map<
-  std::uint32_t, std::unordered_set<std::uint32_t>
->;
+using edge_map_type = hash_map<std::uint32_t, hash_set<std::uint32_t>>;
 
 /**
  * Type alias for the node map.
  *
  * This tracks both the node and its value (an integer).
  */
-using node_map_type = std::unordered_map<std::uint32_t, int>;
+using node_map_type = hash_map<std::uint32_t, int>;
 
 /**
  * Simple graph type for this problem.
@@ -389,7 +578,7 @@ void blanket_add(simple_graph& graph, std::uint32_t root, int value)
   if (!graph.has_node(root))
     return;
   // node queue
-  std::deque<std::uint32_t> nodes{root};
+  pdhkr::arena_std::deque<std::uint32_t> nodes{root};
   // perform BFS
   while (nodes.size()) {
     // current node to consider
@@ -408,16 +597,16 @@ void blanket_add(simple_graph& graph, std::uint32_t root, int value)
  *
  * @note This treats the graph as an undirected graph.
  */
-std::vector<std::uint32_t> compute_path(
+pdhkr::arena_std::vector<std::uint32_t> compute_path(
   const simple_graph& graph, std::uint32_t root, std::uint32_t tgt)
 {
   // empty if no root
   if (!graph.has_node(root))
     return {};
   // node stack. we use the last element of the vector as "top" of stack
-  std::vector<std::uint32_t> stack{root};
+  pdhkr::arena_std::vector<std::uint32_t> stack{root};
   // set of unvisited nodes so we don't revisit
-  std::unordered_set<std::uint32_t> unvisited;
+  hash_set<std::uint32_t> unvisited;
   for (auto [node, _] : graph.nodes())
     unvisited.insert(node);
   // perform DFS
@@ -470,7 +659,7 @@ auto max_value(const simple_graph& graph, std::uint32_t id_a, std::uint32_t id_b
     std::numeric_limits<std::decay_t<decltype(graph.value(0))>>::min() :
     graph.value(*res_it);
 }
-#endif  // !defined(USE_TREE_NODE)
+#endif  // !defined(USE_TREE_NODE) && !defined(USE_ALGO_LIBRARY) && ...
 
 }  // namespace
 
@@ -480,26 +669,32 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 // local and HackerRank builds both use std::cin, std::cout
 #else
   auto& fout = std::cout;
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST)
   // number of tree nodes
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_nodes;
   fin >> n_nodes;
   // root node only if using tree_node, otherwise use graph
 #if defined(USE_TREE_NODE)
   auto root = std::make_unique<tree_node>(1);
+#elif defined(USE_ALGO_LIBRARY) || defined(USE_CSR_GRAPH)
+  // edges are collected and the tree built from them once all are read
+  edge_vector edges;
+  edges.reserve(n_nodes ? n_nodes - 1 : 0);
 #else
   simple_graph graph;
-#endif  // !defined(USE_TREE_NODE)
+#endif  // !defined(USE_TREE_NODE) && !defined(USE_ALGO_LIBRARY) && ...
   // handle edges
   for (decltype(n_nodes) i = 0; i < n_nodes - 1; i++) {
     // read node IDs (1-indexed)
+    PDHKR_PROFILE_PHASE(parse);
 #if defined(USE_TREE_NODE)
     decltype(n_nodes) id_a, id_b;
 #else
@@ -510,6 +705,7 @@ int main()
     // if b < a, swap them. we treat a as the parent (lower ID)
     if (id_b < id_a)
       std::swap(id_a, id_b);
+    PDHKR_PROFILE_PHASE(build);
 #if defined(USE_TREE_NODE)
     // find node a
     auto& node_a = get_node(root, id_a);
@@ -528,61 +724,119 @@ int main()
         std::endl;
       return EXIT_FAILURE;
     }
+#elif defined(USE_ALGO_LIBRARY) || defined(USE_CSR_GRAPH)
+    edges.emplace_back(id_a, id_b);
 #else
   // insert nodes. nodes always start with value zero
   graph.insert_node(id_a);
   graph.insert_node(id_b);
   // insert edge. this is a directed edge
   graph.insert_edge(id_a, id_b);
-#endif  // !defined(USE_TREE_NODE)
+#endif  // !defined(USE_TREE_NODE) && !defined(USE_ALGO_LIBRARY) && ...
   }
+#if defined(USE_ALGO_LIBRARY)
+  PDHKR_PROFILE_PHASE(build);
+  path_tree graph{n_nodes, edges.begin(), edges.end()};
+#elif defined(USE_CSR_GRAPH)
+  PDHKR_PROFILE_PHASE(build);
+  csr_tree graph{n_nodes, edges};
+#endif  // !defined(USE_ALGO_LIBRARY) && !defined(USE_CSR_GRAPH)
   // number of queries
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_queries;
   fin >> n_queries;
-  // handle queries
-  for (decltype(n_queries) i = 0; i < n_queries; i++) {
+  // set by the parser on the first unknown query, after which no more input is
+  // read and the remaining queries are all unknown
+  bool parse_error = false;
+  // read a single query
+  auto read_query = [&fin, &parse_error]
+  {
+    PDHKR_PROFILE_PHASE(parse);
+    tree_query query{};
+    if (parse_error) {
+      query.op = tree_query::op_type::unknown;
+      return query;
+    }
     // read query type
-    std::string query;
-    fin >> query;
+    std::string type;
+    fin >> type;
     // add value to all nodes rooted at subtree
-    if (query == "add") {
-      // read node ID and value
+    if (type == "add") {
+      query.op = tree_query::op_type::add;
+      fin >> query.id_a;
+      fin >> query.value;
+    }
+    // report max value on path from a to b
+    else if (type == "max") {
+      query.op = tree_query::op_type::max;
+      fin >> query.id_a;
+      fin >> query.id_b;
+    }
+    // unknown, error
+    else {
+      std::cerr << "Error: unknown query " << type << std::endl;
+      query.op = tree_query::op_type::unknown;
+      parse_error = true;
+    }
+    return query;
+  };
+  // set by the solver on the first unknown query, after which queries are
+  // ignored and the program exits with failure
+  bool query_error = false;
+  // execute a query, emitting the max value if requested
+  auto solve_query = [&](const tree_query& query, auto&& emit)
+  {
+    PDHKR_PROFILE_PHASE(solve);
+    if (query_error)
+      return;
+    switch (query.op) {
+      // find node + add values
+      case tree_query::op_type::add:
 #if defined(USE_TREE_NODE)
-      decltype(n_nodes) id;
+        blanket_add(get_node(root, query.id_a), query.value);
 #else
-      std::uint32_t id;
+        blanket_add(graph, query.id_a, query.value);
 #endif  // !defined(USE_TREE_NODE)
-      int value;
-      fin >> id;
-      fin >> value;
-      // find node + add values
+        break;
+      // emit max value in path
+      case tree_query::op_type::max:
 #if defined(USE_TREE_NODE)
-      auto& node = get_node(root, id);
-      blanket_add(node, value);
+        emit(max_value(root, query.id_a, query.id_b));
 #else
-      blanket_add(graph, id, value);
+        emit(max_value(graph, query.id_a, query.id_b));
 #endif  // !defined(USE_TREE_NODE)
+        break;
+      default:
+        query_error = true;
     }
-    // report max value on path from a to b
-    else if (query == "max") {
-      // read node IDs
-      decltype(n_nodes) id_a, id_b;
-      fin >> id_a;
-      fin >> id_b;
-      // print max value in path
+  };
+  // print max value in path
+  auto write_max = [&fout](auto value)
+  {
+    PDHKR_PROFILE_PHASE(output);
+    fout << value << std::endl;
+  };
+  // handle queries
+#if defined(USE_QUERY_PIPELINE)
+  // reading std::cin must not flush std::cout from another thread
+  fin.tie(nullptr);
 #if defined(USE_TREE_NODE)
-      fout << max_value(root, id_a, id_b) << std::endl;
-      // TODO
+  using max_value_type = decltype(max_value(root, 1, 1));
 #else
-      fout << max_value(graph, id_a, id_b) << std::endl;
+  using max_value_type = decltype(max_value(graph, 1, 1));
 #endif  // !defined(USE_TREE_NODE)
-    }
-    // unknown, error
-    else {
-      std::cerr << "Error: unknown query " << query << std::endl;
-      return EXIT_FAILURE;
-    }
-  }
+  pdhkr::pipeline_queries<max_value_type>(
+    n_queries,
+    read_query,
+    solve_query,
+    write_max
+  );
+#else
+  for (decltype(n_queries) i = 0; i < n_queries; i++)
+    solve_query(read_query(), write_max);
+#endif  // !defined(USE_QUERY_PIPELINE)
+  if (query_error)
+    return EXIT_FAILURE;
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
 // return type differs based on implementation
@@ -591,6 +845,7 @@ int main()
 #else
   using value_type = decltype(max_value(graph, 1, 1));
 #endif  // !defined(USE_TREE_NODE)
+  PDHKR_PROFILE_PHASE(compare);
   return pdhkr::exit_compare<value_type>(fans, fout);
 #else
   return EXIT_SUCCESS;
@@ -7,15 +7,18 @@
  * URL: https://www.hackerrank.com/challenges/swap-nodes-algo/problem
  *
  * @note The "[Algo]" is part of the actual title.
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::swap_tree` from
+ * `pdhkr/algo/swap_tree_nodes.hh`, which must be pasted in with the pdhkr
+ * headers it includes when submitting to HackerRank.
  */
 
+#include <cstddef>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <iterator>
-#include <limits>
 #include <ostream>
-#include <memory>
 #include <utility>
 #include <vector>
 
@@ -27,139 +30,31 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
-namespace {
-
-/**
- * Simple binary tree node with unique child ownership that holds a node ID.
- */
-class binary_tree_node {
-public:
-  /**
-   * Ctor.
-   *
-   * @param id Node ID
-   * @param left Left child to own
-   * @param right Right child to own
-   */
-  binary_tree_node(
-    unsigned int id,
-    std::unique_ptr<binary_tree_node>&& left = nullptr,
-    std::unique_ptr<binary_tree_node>&& right = nullptr)
-    : id_{id}, left_{std::move(left)}, right_{std::move(right)}
-  {}
-
-  /**
-   * Return node ID.
-   */
-  auto id() const noexcept
-  {
-    return id_;
-  }
-
-  /**
-   * Return reference to the node ID.
-   */
-  auto& id() noexcept
-  {
-    return id_;
-  }
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
 
-  /**
-   * Return const reference to left child.
-   */
-  const auto& left() const noexcept
-  {
-    return left_;
-  }
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/swap_tree_nodes.hh"
 
-  /**
-   * Return reference to left child.
-   */
-  auto& left() noexcept
-  {
-    return left_;
-  }
-
-  /**
-   * Return const reference to right child.
-   */
-  const auto& right() const noexcept
-  {
-    return right_;
-  }
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
 
-  /**
-   * Return reference to right child.
-   */
-  auto& right() noexcept
-  {
-    return right_;
-  }
+namespace arena_std = std;
 
-private:
-  unsigned int id_;
-  std::unique_ptr<binary_tree_node> left_;
-  std::unique_ptr<binary_tree_node> right_;
-};
+}  // namespace pdhkr
 
-/**
- * Find the node with the specified ID in the binary tree.
- *
- * If the node cannot be found then a reference to an empty node is returned.
- *
- * @param root Tree root node
- * @param id Target node ID
- */
-auto& find_node(std::unique_ptr<binary_tree_node>& root, unsigned int id)
-{
-  // empty root to use if unable to find the right node
-  static std::unique_ptr<binary_tree_node> empty;
-  // root empty
-  if (!root)
-    return empty;
-  // found target ID
-  if (root->id() == id)
-    return root;
-  // check left subtree, return if success
-  auto& left = find_node(root->left(), id);
-  if (left)
-    return left;
-  // check right subtree, return if success
-  auto& right = find_node(root->right(), id);
-  if (right)
-    return right;
-  // failed, return empty
-  return empty;
-}
-
-/**
- * Retrieve tree value IDs in the inorder depth-first traversal order.
- *
- * @param root Tree root node
- * @param ids Vector to store the retrieved IDs in
- */
-void inorder_tree_ids(
-  const std::unique_ptr<binary_tree_node>& root, std::vector<unsigned int>& ids)
-{
-  if (!root)
-    return;
-  // add left subtree IDs, own ID, and then right subtree IDs
-  inorder_tree_ids(root->left(), ids);
-  ids.push_back(root->id());
-  inorder_tree_ids(root->right(), ids);
-}
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
 
-/**
- * Retrieve tree value IDs in the inorder depth-first traversal order.
- *
- * @param root Tree root node
- */
-inline auto inorder_tree_ids(const std::unique_ptr<binary_tree_node>& root)
-{
-  std::vector<unsigned int> ids;
-  inorder_tree_ids(root, ids);
-  return ids;
-}
+namespace {
 
 /**
  * Object print wrapper class.
@@ -218,29 +113,6 @@ auto& operator<<(std::ostream& out, const printer<std::vector<T>>& values)
   return out;
 }
 
-/**
- * Swap the subtrees for the nodes at the specified depth.
- *
- * @note The depth of the root node is zero as is standard.
- *
- * @param root Tree root node
- * @param depth Depth of nodes whose subtrees should be swapped. If the depth
- *  requested exceeds the maximum depth of the tree, nothing is done.
- */
-void swap_subtrees(std::unique_ptr<binary_tree_node>& root, unsigned int depth)
-{
-  // skip if empty
-  if (!root)
-    return;
-  // swap subtrees of current node
-  if (!depth)
-    std::swap(root->left(), root->right());
-  // call on children
-  depth--;
-  swap_subtrees(root->left(), depth);
-  swap_subtrees(root->right(), depth);
-}
-
 }  // namespace
 
 int main()
@@ -249,9 +121,9 @@ int main()
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #elif defined(PDHKR_LOCAL)
   // for local run, this is simply std::cout
   auto& fout = std::cout;
@@ -262,53 +134,40 @@ int main()
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
   // number of nodes
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_nodes;
   fin >> n_nodes;
-  // root node
-  std::unique_ptr<binary_tree_node> root;
-  // read children for each node's children. IDs start from 1
-  for (decltype(n_nodes) i = 0; i < n_nodes; i++) {
-    // populate root if necessary
-    if (!root)
-      root = std::make_unique<decltype(root)::element_type>(i + 1);
-    // read child node IDs. can be -1 to represent null
-    int left_id;
-    int right_id;
-    fin >> left_id;
-    fin >> right_id;
-    // find parent and fill in children (if not negative)
-    auto& parent = find_node(root, i + 1);
-// silence C4365 on signed/unsigned mismatch
-#ifdef _MSC_VER
-#pragma warning (push)
-#pragma warning (disable: 4365)
-#endif  // _MSC_VER
-    if (left_id > 0)
-      parent->left() = std::make_unique<decltype(root)::element_type>(left_id);
-    if (right_id > 0)
-      parent->right() = std::make_unique<decltype(root)::element_type>(right_id);
-#ifdef _MSC_VER
-#pragma warning (pop)
-#endif  // _MSC_VER
-  }
+  // child node IDs of each node, starting from node 1. can be -1 for null
+  pdhkr::arena_std::vector<std::pair<int, int>> children(n_nodes);
+  for (auto& [left_id, right_id] : children)
+    fin >> left_id >> right_id;
+  // build tree, grouping the nodes by depth
+  PDHKR_PROFILE_PHASE(build);
+  pdhkr::algo::swap_tree tree{children.begin(), children.end()};
   // number of subtree swaps
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_swaps;
   fin >> n_swaps;
   // for each swap depth, swap all node subtrees, print the inorder traversal
+  std::vector<std::size_t> ids;
+  ids.reserve(tree.size());
   for (decltype(n_swaps) i = 0; i < n_swaps; i++) {
     // read swap depth as depth starting from 1
-    decltype(i) swap_depth;
+    PDHKR_PROFILE_PHASE(parse);
+    std::size_t swap_depth;
     fin >> swap_depth;
-    // swap node subtrees for multiples of the swap depth. -1 to standardize
-    // note: probably more efficient if we took the maximum depth of the tree
-    // first but this was still fast enough for all the test cases
-    for (decltype(n_nodes) j = 1; j * swap_depth <= n_nodes; j++)
-      swap_subtrees(root, j * swap_depth - 1);
-    fout << printer{inorder_tree_ids(root)} << std::endl;
+    // swap node subtrees for multiples of the swap depth
+    PDHKR_PROFILE_PHASE(solve);
+    tree.swap_depths(swap_depth);
+    ids.clear();
+    tree.inorder(std::back_inserter(ids));
+    PDHKR_PROFILE_PHASE(output);
+    fout << printer{ids} << std::endl;
   }
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
-  return pdhkr::exit_compare<decltype(inorder_tree_ids(nullptr))>(fans, fout);
+  PDHKR_PROFILE_PHASE(compare);
+  return pdhkr::exit_compare<decltype(ids)>(fans, fout);
 #else
   return EXIT_SUCCESS;
 #endif  // !defined(PDHKR_TEST)
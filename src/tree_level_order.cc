@@ -5,15 +5,17 @@
  * @copyright MIT License
  *
  * URL: https://www.hackerrank.com/challenges/tree-level-order-traversal/problem
+ *
+ * This is a thin I/O wrapper around `pdhkr::algo::binary_search_tree` from
+ * `pdhkr/algo/binary_search_tree.hh`, which must be pasted in with the pdhkr
+ * headers it includes when submitting to HackerRank.
  */
 
-#include <algorithm>
 #include <cstdlib>
-#include <deque>
 #include <iostream>
-#include <memory>
-#include <stdexcept>
-#include <utility>
+#include <iterator>
+#include <ostream>
+#include <vector>
 
 // only used when compiling as standalone test program
 #ifdef PDHKR_TEST
@@ -24,227 +26,93 @@
 #include "pdhkr/testing.hh"
 #endif  // PDHKR_TEST
 
-namespace {
-
-/**
- * Binary tree node class template with unique child ownership.
- *
- * @note This implementation is copied from `tree_top_view.cc`.
- *
- * @tparam T value
- */
-template <typename T>
-class binary_tree_node {
-public:
-  using value_type = T;
-
-  /**
-   * Ctor.
-   *
-   * @param value Node value
-   * @param left Node left child
-   * @param right Node right child
-   */
-  binary_tree_node(
-    T&& value,
-    std::unique_ptr<binary_tree_node<T>>&& left = nullptr,
-    std::unique_ptr<binary_tree_node<T>>&& right = nullptr)
-    : value_{std::move(value)}, left_{std::move(left)}, right_{std::move(right)}
-  {}
-
-  /**
-   * Return const reference to value.
-   */
-  const auto& value() const noexcept
-  {
-    return value_;
-  }
-
-  /**
-   * Return reference to value.
-   */
-  auto& value() noexcept
-  {
-    return value_;
-  }
+// time program phases when the PDHKR_PROFILE environment variable is set
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/profile.hh"
+#else
+#define PDHKR_PROFILE_PHASE(phase)
+#define PDHKR_PROFILE_SCOPE(phase)
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
 
-  /**
-   * Return const reference to left child.
-   */
-  const auto& left() const noexcept
-  {
-    return left_;
-  }
+// solver core from the embeddable pdhkr::algo library
+#include "pdhkr/algo/binary_search_tree.hh"
 
-  /**
-   * Return reference to left child.
-   */
-  auto& left() noexcept
-  {
-    return left_;
-  }
+// allocate from a per-run arena instead of the global heap with PDHKR_USE_ARENA
+#if defined(PDHKR_TEST) || defined(PDHKR_LOCAL)
+#include "pdhkr/arena_std.hh"
+#else
+namespace pdhkr {
 
-  /**
-   * Return const reference to right child.
-   */
-  const auto& right() const noexcept
-  {
-    return right_;
-  }
+namespace arena_std = std;
 
-  /**
-   * Return reference to right child.
-   */
-  auto& right() noexcept
-  {
-    return right_;
-  }
+}  // namespace pdhkr
 
-private:
-  T value_;
-  std::unique_ptr<binary_tree_node<T>> left_;
-  std::unique_ptr<binary_tree_node<T>> right_;
-};
+#define PDHKR_ARENA_OPERATORS
+#endif  // !defined(PDHKR_TEST) && !defined(PDHKR_LOCAL)
 
-/**
- * Perform a binary search tree insertion of a value into a binary tree.
- *
- * @note This implementation is copied from `tree_top_view.cc`.
- *
- * @tparam T value type
- *
- * @param root Tree root
- * @param value Value to insert
- */
-template <typename T>
-void bst_insert(std::unique_ptr<binary_tree_node<T>>& root, T&& value)
-{
-  if (!root)
-    throw std::runtime_error{"tree root is nullptr"};
-  // left insert
-  if (value <= root->value()) {
-    // if no left child, insert, otherwise recurse
-    if (!root->left())
-      root->left() = std::make_unique<binary_tree_node<T>>(std::move(value));
-    else
-      bst_insert(root->left(), std::move(value));
-  }
-  // right insert
-  else {
-    // if no right child, insert, otherwise recurse
-    if (!root->right())
-      root->right() = std::make_unique<binary_tree_node<T>>(std::move(value));
-    else
-      bst_insert(root->right(), std::move(value));
-  }
-}
+namespace {
 
 /**
- * Wrapper class for streaming a BFS ordering of a `binary_tree_node<T>` tree.
+ * Write the values of a container to a stream separated by spaces.
  *
- * The BFS ordering is equivalent to saying the ordering is level first.
+ * This is useful for printing the problem outputs as well as debugging.
  *
- * @tparam T value type
- */
-template <typename T>
-class binary_tree_bfs_view {
-public:
-  /**
-   * Ctor.
-   *
-   * @param root Reference to tree root
-   */
-  binary_tree_bfs_view(const std::unique_ptr<binary_tree_node<T>>& root)
-    : root_{root}
-  {}
-
-  /**
-   * Return const reference to the tree root.
-   */
-  const auto& root() const noexcept
-  {
-    return root_;
-  }
-
-private:
-  const std::unique_ptr<binary_tree_node<T>>& root_;
-};
-
-/**
- * Print the BFS, or level order, view of a binary tree to a stream.
+ * @tparam Container *Container* with streamable values
  *
- * @tparam T value type
- *
- * @param view Level order view wrapper with reference to the tree root
+ * @param out Output stream
+ * @param values Values to write
  */
-template <typename T>
-auto& operator<<(std::ostream& out, const binary_tree_bfs_view<T>& view)
+template <typename Container>
+void write_container(std::ostream& out, const Container& values)
 {
-  // reference to the tree root
-  const auto& root = view.root();
-  // empty tree
-  if (!root)
-    return out;
-  // perform BFS and print nodes
-  std::deque<decltype(root.get())> queue{root.get()};
-  while (queue.size()) {
-    // current node
-    auto cur = queue.front();
-    queue.pop_front();
-    // print extra space if root was printed already
-    if (cur != root.get())
-        out << " ";
-    // print current value + add children
-    out << cur->value();
-    if (cur->left())
-      queue.push_back(cur->left().get());
-    if (cur->right())
-      queue.push_back(cur->right().get());
+  for (auto it = values.begin(); it != values.end(); it++) {
+    if (std::distance(values.begin(), it))
+      out << " ";
+    out << *it;
   }
-  return out;
 }
 
 }  // namespace
 
-// note: main is a near-identical copy of the tree_top_view.cc main
 int main()
 {
 // building as standalone test program
 #if defined(PDHKR_TEST)
   // write to stringstream, read from PDHKR_TEST_INPUT
   std::stringstream fout;
-  std::ifstream fin{PDHKR_TEST_INPUT};
+  pdhkr::test_ifstream fin{PDHKR_TEST_INPUT};
   // fans provides the expected output
-  std::ifstream fans{PDHKR_TEST_OUTPUT};
+  pdhkr::test_ifstream fans{PDHKR_TEST_OUTPUT};
 #else
   // for local run, this is simply std::cout
   auto& fout = std::cout;
   auto& fin = std::cin;
 #endif  // !defined(PDHKR_TEST)
-  // number of nodes to insert
+  // number of nodes to insert and the values in insertion order
+  PDHKR_PROFILE_PHASE(parse);
   unsigned int n_nodes;
   fin >> n_nodes;
-  // tree root
-  std::unique_ptr<binary_tree_node<unsigned int>> root;
-  // insert nodes into tree
-  for (decltype(n_nodes) i = 0; i < n_nodes; i++) {
-    // read from stream
-    decltype(root)::element_type::value_type value;
+  pdhkr::arena_std::vector<unsigned int> values(n_nodes);
+  for (auto& value : values)
     fin >> value;
-    // create root
-    if (!root)
-      root = std::make_unique<decltype(root)::element_type>(std::move(value));
-    // otherwise insert
-    else
-      bst_insert(root, std::move(value));
-  }
-  // write level order view to stream
-  fout << binary_tree_bfs_view{root} << std::endl;
+  // insert values into the tree
+  PDHKR_PROFILE_PHASE(build);
+  pdhkr::algo::binary_search_tree<unsigned int> tree;
+  for (auto value : values)
+    tree.insert(value);
+  // values in level order, i.e. breadth-first from the root
+  PDHKR_PROFILE_PHASE(solve);
+  std::vector<unsigned int> level_values;
+  level_values.reserve(tree.size());
+  tree.level_order(std::back_inserter(level_values));
+  PDHKR_PROFILE_PHASE(output);
+  write_container(fout, level_values);
+  fout << std::endl;
 // if testing, do comparison in the program itself
 #if defined(PDHKR_TEST)
+  PDHKR_PROFILE_PHASE(compare);
   // std::vector used here to trigger vector comparison
-  using value_type = std::vector<decltype(root)::element_type::value_type>;
-  return pdhkr::exit_compare<value_type>(fans, fout);
+  return pdhkr::exit_compare<decltype(level_values)>(fans, fout);
 #else
   return EXIT_SUCCESS;
 #endif  // !defined(PDHKR_TEST)
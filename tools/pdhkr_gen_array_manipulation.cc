@@ -0,0 +1,152 @@
+/**
+ * @file pdhkr_gen_array_manipulation.cc
+ * @author Derek Huang
+ * @brief C++ program generating random inputs for array_manipulation
+ * @copyright MIT License
+ *
+ * Writes either the online format read when `USE_ONLINE_QUERIES` is defined,
+ * with `add l r k` and `max l r` operations, the original HackerRank format
+ * of `l r k` additions, optionally followed by the `l r` range max queries
+ * read when `USE_RANGE_MAX_INDEX` is defined, or the `r1 r2 c1 c2 k` rectangle
+ * additions read by rectangle_manipulation. The output only depends on the
+ * arguments, so test cases can be regenerated exactly on any platform.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+/**
+ * Print the usage message.
+ *
+ * @param out Stream to write to
+ */
+void print_usage(std::ostream& out)
+{
+  out << "Usage: pdhkr_gen_array_manipulation [-o] N N_OPS [SEED [QUERIES]]\n"
+         "       pdhkr_gen_array_manipulation -r ROWS COLS N_OPS [SEED]\n"
+         "\n"
+         "Write N_OPS random operations on an array of N values to stdout in\n"
+         "the online format of array_manipulation. QUERIES is the percentage\n"
+         "of operations that are max queries instead of additions, by\n"
+         "default 50. Added values are in [0, 1e9] and SEED defaults to 0.\n"
+         "\n"
+         "Options:\n"
+         "  -o  Write only additions in the original offline format instead.\n"
+         "      QUERIES is then a number of read-only max queries, each an\n"
+         "      `l r` line, written after the additions and their count\n"
+         "  -r  Write additions to rectangles of a ROWS x COLS grid instead\n";
+}
+
+/**
+ * Parse a nonnegative integer argument.
+ *
+ * @param arg Argument text
+ * @param name Argument name for the error message
+ */
+std::uint64_t parse_arg(const char* arg, std::string_view name)
+{
+  char* end;
+  auto value = std::strtoull(arg, &end, 10);
+  if (end == arg || *end || *arg == '-')
+    throw std::invalid_argument{"Invalid " + std::string{name} + ": " + arg};
+  return value;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  // parse mode then positional arguments
+  enum class mode { online, offline, rectangles };
+  auto run_mode = mode::online;
+  int i = 1;
+  if (i < argc) {
+    std::string_view arg{argv[i]};
+    if (arg == "-h" || arg == "--help") {
+      print_usage(std::cout);
+      return EXIT_SUCCESS;
+    }
+    if (arg == "-o" || arg == "-r") {
+      run_mode = (arg == "-o") ? mode::offline : mode::rectangles;
+      i++;
+    }
+  }
+  // rectangles take the grid size, ROWS COLS, in place of the array size, and
+  // no QUERIES argument
+  auto n_size_args = (run_mode == mode::rectangles) ? 2 : 1;
+  if (argc - i < n_size_args + 1 || argc - i > 4) {
+    print_usage(std::cerr);
+    return EXIT_FAILURE;
+  }
+  try {
+    auto size = parse_arg(argv[i], (n_size_args == 2) ? "ROWS" : "N");
+    auto n_cols = (n_size_args == 2) ? parse_arg(argv[i + 1], "COLS") : 1U;
+    i += n_size_args;
+    auto n_ops = parse_arg(argv[i], "N_OPS");
+    auto seed = (argc - i > 1) ? parse_arg(argv[i + 1], "SEED") : 0U;
+    auto queries = (argc - i > 2) ? parse_arg(argv[i + 2], "QUERIES") : 50U;
+    if (!size || !n_cols || (run_mode == mode::online && queries > 100))
+      throw std::invalid_argument{"Sizes must be positive and QUERIES <= 100"};
+    // std::mt19937_64 output is fully specified, unlike the distributions, so
+    // plain modulo is used. the bias is negligible for these ranges
+    std::mt19937_64 rng{seed};
+    auto uniform = [&rng](std::uint64_t n) { return rng() % n; };
+    // random 1-based inclusive range within [1, n]
+    auto range = [&uniform](std::uint64_t n)
+    {
+      auto left = uniform(n) + 1;
+      auto right = uniform(n) + 1;
+      if (right < left)
+        std::swap(left, right);
+      return std::make_pair(left, right);
+    };
+    std::cout << size << ' ';
+    if (run_mode == mode::rectangles)
+      std::cout << n_cols << ' ';
+    std::cout << n_ops << '\n';
+    for (decltype(n_ops) j = 0; j < n_ops; j++) {
+      auto [left, right] = range(size);
+      if (run_mode == mode::rectangles) {
+        auto [first_col, last_col] = range(n_cols);
+        std::cout << left << ' ' << right << ' ' << first_col << ' ' <<
+          last_col << ' ' << uniform(1000000001U);
+      }
+      else if (run_mode == mode::offline)
+        std::cout << left << ' ' << right << ' ' << uniform(1000000001U);
+      else if (uniform(100) < queries)
+        std::cout << "max " << left << ' ' << right;
+      else
+        std::cout << "add " << left << ' ' << right << ' ' <<
+          uniform(1000000001U);
+      std::cout << '\n';
+    }
+    // trailing read-only queries in offline mode
+    if (run_mode == mode::offline && argc - i > 2) {
+      std::cout << queries << '\n';
+      for (decltype(queries) j = 0; j < queries; j++) {
+        auto [left, right] = range(size);
+        std::cout << left << ' ' << right << '\n';
+      }
+    }
+    std::cout.flush();
+    if (!std::cout) {
+      std::cerr << "Error: Write failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const std::exception& exc) {
+    std::cerr << "Error: " << exc.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file pdhkr_gen_graph.cc
+ * @author Derek Huang
+ * @brief C++ program generating random graph inputs for roads_and_libraries
+ * @copyright MIT License
+ *
+ * Writes one roads_and_libraries query per graph spec, either a power-law
+ * R-MAT graph or a 2D grid graph, with random library and road costs. The
+ * output only depends on the arguments, so test cases can be regenerated
+ * exactly on any platform.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+/**
+ * Print the usage message.
+ *
+ * @param out Stream to write to
+ */
+void print_usage(std::ostream& out)
+{
+  out << "Usage: pdhkr_gen_graph [-s SEED] SPEC...\n"
+         "\n"
+         "Write a roads_and_libraries input to stdout with one query per\n"
+         "graph SPEC. Library and road costs are in [1, 100000] and SEED\n"
+         "defaults to 0.\n"
+         "\n"
+         "Specs:\n"
+         "  rmat:SCALE:EDGE_FACTOR  R-MAT power-law graph with 2^SCALE\n"
+         "                          cities and EDGE_FACTOR * 2^SCALE roads,\n"
+         "                          without self loops\n"
+         "  grid:ROWS:COLS          ROWS x COLS grid with roads between\n"
+         "                          horizontally and vertically adjacent\n"
+         "                          cities\n";
+}
+
+/**
+ * Parse a nonnegative integer argument.
+ *
+ * @param arg Argument text
+ * @param name Argument name for the error message
+ */
+std::uint64_t parse_arg(std::string_view arg, std::string_view name)
+{
+  std::string text{arg};
+  char* end;
+  auto value = std::strtoull(text.c_str(), &end, 10);
+  if (text.empty() || *end || text[0] == '-')
+    throw std::invalid_argument{"Invalid " + std::string{name} + ": " + text};
+  return value;
+}
+
+/**
+ * Split a graph spec into its colon-separated fields.
+ *
+ * @param spec Graph spec
+ */
+std::vector<std::string_view> split_spec(std::string_view spec)
+{
+  std::vector<std::string_view> fields;
+  for (std::size_t pos = 0;;) {
+    auto next = spec.find(':', pos);
+    fields.push_back(spec.substr(pos, next - pos));
+    if (next == spec.npos)
+      return fields;
+    pos = next + 1;
+  }
+}
+
+/**
+ * Parsed graph spec.
+ */
+struct graph_spec {
+  // R-MAT graph or grid graph
+  bool grid;
+  // SCALE and EDGE_FACTOR, or ROWS and COLS
+  std::uint64_t x;
+  std::uint64_t y;
+};
+
+/**
+ * Parse a graph spec.
+ *
+ * @param spec Graph spec text
+ */
+graph_spec parse_spec(std::string_view spec)
+{
+  auto fields = split_spec(spec);
+  if (fields.size() != 3)
+    throw std::invalid_argument{"Invalid spec: " + std::string{spec}};
+  if (fields[0] == "rmat") {
+    graph_spec parsed{
+      false, parse_arg(fields[1], "SCALE"), parse_arg(fields[2], "EDGE_FACTOR")
+    };
+    if (!parsed.x || parsed.x > 31)
+      throw std::invalid_argument{"SCALE must be in [1, 31]"};
+    return parsed;
+  }
+  if (fields[0] == "grid") {
+    graph_spec parsed{
+      true, parse_arg(fields[1], "ROWS"), parse_arg(fields[2], "COLS")
+    };
+    if (!parsed.x || !parsed.y)
+      throw std::invalid_argument{"ROWS and COLS must be positive"};
+    return parsed;
+  }
+  throw std::invalid_argument{"Unknown graph type: " + std::string{spec}};
+}
+
+/**
+ * Write one query for a graph spec.
+ *
+ * @param rng Random number generator
+ * @param spec Graph spec
+ */
+void write_query(std::mt19937_64& rng, const graph_spec& spec)
+{
+  // costs are drawn first so they do not depend on the graph size
+  auto lib_cost = rng() % 100000U + 1;
+  auto road_cost = rng() % 100000U + 1;
+  if (!spec.grid) {
+    auto scale = spec.x;
+    auto edge_factor = spec.y;
+    auto n_cities = std::uint64_t{1} << scale;
+    auto n_roads = edge_factor * n_cities;
+    std::cout << n_cities << ' ' << n_roads << ' ' << lib_cost << ' ' <<
+      road_cost << '\n';
+    // each bit of the end cities picks one of the adjacency matrix quadrants
+    // with probabilities 0.57, 0.19, 0.19, 0.05, skewing the degrees. plain
+    // modulo is used since std::mt19937_64 output is fully specified
+    for (std::uint64_t i = 0; i < n_roads;) {
+      std::uint64_t a = 0;
+      std::uint64_t b = 0;
+      for (std::uint64_t bit = 0; bit < scale; bit++) {
+        auto quadrant = rng() % 100U;
+        a = 2 * a + (quadrant >= 76U);
+        b = 2 * b + (quadrant >= 57U && quadrant < 76U) + (quadrant >= 95U);
+      }
+      if (a == b)
+        continue;
+      std::cout << a + 1 << ' ' << b + 1 << '\n';
+      i++;
+    }
+  }
+  else {
+    auto rows = spec.x;
+    auto cols = spec.y;
+    auto n_roads = rows * (cols - 1) + (rows - 1) * cols;
+    std::cout << rows * cols << ' ' << n_roads << ' ' << lib_cost << ' ' <<
+      road_cost << '\n';
+    for (std::uint64_t i = 0; i < rows; i++) {
+      for (std::uint64_t j = 0; j < cols; j++) {
+        auto city = i * cols + j + 1;
+        if (j + 1 < cols)
+          std::cout << city << ' ' << city + 1 << '\n';
+        if (i + 1 < rows)
+          std::cout << city << ' ' << city + cols << '\n';
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  // parse options then specs
+  int i = 1;
+  std::uint64_t seed = 0;
+  try {
+    if (i < argc) {
+      std::string_view arg{argv[i]};
+      if (arg == "-h" || arg == "--help") {
+        print_usage(std::cout);
+        return EXIT_SUCCESS;
+      }
+      if (arg == "-s") {
+        if (i + 1 == argc)
+          throw std::invalid_argument{"-s requires a SEED"};
+        seed = parse_arg(argv[i + 1], "SEED");
+        i += 2;
+      }
+    }
+    if (i == argc) {
+      print_usage(std::cerr);
+      return EXIT_FAILURE;
+    }
+    std::vector<graph_spec> specs;
+    for (; i < argc; i++)
+      specs.push_back(parse_spec(argv[i]));
+    std::mt19937_64 rng{seed};
+    std::cout << specs.size() << '\n';
+    for (const auto& spec : specs)
+      write_query(rng, spec);
+    std::cout.flush();
+    if (!std::cout) {
+      std::cerr << "Error: Write failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const std::exception& exc) {
+    std::cerr << "Error: " << exc.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file pdhkr_lz.cc
+ * @author Derek Huang
+ * @brief C++ program compressing and decompressing test data files
+ * @copyright MIT License
+ *
+ * Converts between text test case files and the compressed format of
+ * `pdhkr/lz.hh`. Decompression streams one block at a time, so the output can
+ * be piped into a program built for local runs, which reads standard input.
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "pdhkr/lz.hh"
+
+namespace {
+
+/**
+ * Print the usage message.
+ *
+ * @param out Stream to write to
+ */
+void print_usage(std::ostream& out)
+{
+  out << "Usage: pdhkr_lz [-d | -t] [INPUT [OUTPUT]]\n"
+         "\n"
+         "Compress INPUT, or stdin, to OUTPUT, or stdout. Compressed test\n"
+         "case files are named by appending .lz to the original file name,\n"
+         "e.g. 3.in.lz, and can then replace the original file.\n"
+         "\n"
+         "Options:\n"
+         "  -d  Decompress instead. Files that are not compressed are copied\n"
+         "  -t  Decompress and discard the output, only checking integrity\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  // parse mode then positional arguments
+  enum class mode { compress, decompress, check };
+  auto run_mode = mode::compress;
+  int i = 1;
+  if (i < argc) {
+    std::string_view arg{argv[i]};
+    if (arg == "-h" || arg == "--help") {
+      print_usage(std::cout);
+      return EXIT_SUCCESS;
+    }
+    if (arg == "-d" || arg == "-t") {
+      run_mode = (arg == "-d") ? mode::decompress : mode::check;
+      i++;
+    }
+  }
+  if (argc - i > 2 || (run_mode == mode::check && argc - i > 1)) {
+    print_usage(std::cerr);
+    return EXIT_FAILURE;
+  }
+  try {
+    // input and output streams. binary since compressed files are not text
+    std::unique_ptr<std::istream> file_in;
+    std::unique_ptr<std::ostream> file_out;
+    std::istream* in = &std::cin;
+    std::ostream* out = &std::cout;
+    if (argc - i >= 1) {
+      if (run_mode == mode::compress)
+        file_in = std::make_unique<std::ifstream>(
+          argv[i], std::ios_base::in | std::ios_base::binary
+        );
+      else
+        file_in = std::make_unique<pdhkr::lz_ifstream>(argv[i]);
+      if (!*file_in) {
+        std::cerr << "Error: Cannot open " << argv[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+      in = file_in.get();
+    }
+    if (argc - i == 2) {
+      file_out = std::make_unique<std::ofstream>(
+        argv[i + 1],
+        std::ios_base::out | std::ios_base::trunc | std::ios_base::binary
+      );
+      if (!*file_out) {
+        std::cerr << "Error: Cannot open " << argv[i + 1] << std::endl;
+        return EXIT_FAILURE;
+      }
+      out = file_out.get();
+    }
+    // decompressing standard input needs the magic consumed first
+    pdhkr::lz_streambuf stdin_buf{std::cin.rdbuf()};
+    std::istream stdin_lz{&stdin_buf};
+    if (!file_in && run_mode != mode::compress) {
+      char magic[pdhkr::lz_magic.size()];
+      if (
+        !std::cin.read(magic, sizeof magic) ||
+        !pdhkr::lz_compressed({magic, sizeof magic})
+      ) {
+        std::cerr << "Error: Input is not compressed" << std::endl;
+        return EXIT_FAILURE;
+      }
+      in = &stdin_lz;
+    }
+    // corrupt data is reported by a std::runtime_error from the stream buffer,
+    // which the stream would otherwise swallow by setting badbit
+    in->exceptions(std::ios_base::badbit);
+    if (run_mode == mode::compress)
+      pdhkr::lz_compress(*in, *out);
+    else {
+      std::vector<char> chunk(pdhkr::lz_block_size);
+      while (*in) {
+        in->read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        if (run_mode == mode::decompress)
+          out->write(chunk.data(), in->gcount());
+      }
+    }
+    out->flush();
+    if (!*out) {
+      std::cerr << "Error: Write failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const std::exception& exc) {
+    std::cerr << "Error: " << exc.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}